@@ -0,0 +1,200 @@
+#include <xmmintrin.h>
+
+#include "Affine2D.h"
+#include "SinCos.h"
+
+
+
+void Affine2DIdentity(Affine2D *pResult)
+{
+	pResult->m[0][0] = 1.f;
+	pResult->m[0][1] = 0.f;
+	pResult->m[0][2] = 0.f;
+	pResult->m[1][0] = 0.f;
+	pResult->m[1][1] = 1.f;
+	pResult->m[1][2] = 0.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DConcat(Affine2D *pResult, Affine2D *pMtx0, Affine2D *pMtx1)
+{
+	Affine2D t;
+	float (*a)[3] = pMtx0->m, (*b)[3] = pMtx1->m;
+
+	// The implied (0, 0, 1) rows leave out the 15 other products
+	t.m[0][0] = a[0][0] * b[0][0] + a[0][1] * b[1][0];
+	t.m[0][1] = a[0][0] * b[0][1] + a[0][1] * b[1][1];
+	t.m[0][2] = a[0][0] * b[0][2] + a[0][1] * b[1][2] + a[0][2];
+	t.m[1][0] = a[1][0] * b[0][0] + a[1][1] * b[1][0];
+	t.m[1][1] = a[1][0] * b[0][1] + a[1][1] * b[1][1];
+	t.m[1][2] = a[1][0] * b[0][2] + a[1][1] * b[1][2] + a[1][2];
+
+	*pResult = t;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DTranslate(Affine2D *pResult, float x, float y)
+{
+	pResult->m[0][0] = 1.f;
+	pResult->m[0][1] = 0.f;
+	pResult->m[0][2] = x;
+	pResult->m[1][0] = 0.f;
+	pResult->m[1][1] = 1.f;
+	pResult->m[1][2] = y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DScale(Affine2D *pResult, float x, float y)
+{
+	pResult->m[0][0] = x;
+	pResult->m[0][1] = 0.f;
+	pResult->m[0][2] = 0.f;
+	pResult->m[1][0] = 0.f;
+	pResult->m[1][1] = y;
+	pResult->m[1][2] = 0.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DRotDeg(Affine2D *pResult, float Angle)
+{
+	Affine2DRotRad(pResult, Angle * 3.14159265358979323846f / 180.f);
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DRotRad(Affine2D *pResult, float Angle)
+{
+	float c, s;
+
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+
+	pResult->m[0][0] = c;
+	pResult->m[0][1] = -s;
+	pResult->m[0][2] = 0.f;
+	pResult->m[1][0] = s;
+	pResult->m[1][1] = c;
+	pResult->m[1][2] = 0.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DScaleRotTrans(Affine2D *pResult, float ScaleX, float ScaleY, float Angle, float x, float y)
+{
+	float c, s;
+
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+
+	pResult->m[0][0] = c * ScaleX;
+	pResult->m[0][1] = -s * ScaleY;
+	pResult->m[0][2] = x;
+	pResult->m[1][0] = s * ScaleX;
+	pResult->m[1][1] = c * ScaleY;
+	pResult->m[1][2] = y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DScaleRotationTrans(Affine2D *pResult, float ScaleX, float ScaleY, Rotation2D *pRotation, float x, float y)
+{
+	pResult->m[0][0] = pRotation->c * ScaleX;
+	pResult->m[0][1] = -pRotation->s * ScaleY;
+	pResult->m[0][2] = x;
+	pResult->m[1][0] = pRotation->s * ScaleX;
+	pResult->m[1][1] = pRotation->c * ScaleY;
+	pResult->m[1][2] = y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DMultVec(Vector2D *pResult, Affine2D *pMtx, Vector2D *pVec)
+{
+	Vector2D t;
+
+	t.x = pMtx->m[0][0] * pVec->x + pMtx->m[0][1] * pVec->y + pMtx->m[0][2];
+	t.y = pMtx->m[1][0] * pVec->x + pMtx->m[1][1] * pVec->y + pMtx->m[1][2];
+
+	*pResult = t;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DMultVecBatch(Vector2D *pResults, Affine2D *pMtx, Vector2D *pVecs, unsigned int Num)
+{
+	// 2 points per register: (x0, y0, x1, y1)
+	__m128 col0 = _mm_setr_ps(pMtx->m[0][0], pMtx->m[1][0], pMtx->m[0][0], pMtx->m[1][0]);
+	__m128 col1 = _mm_setr_ps(pMtx->m[0][1], pMtx->m[1][1], pMtx->m[0][1], pMtx->m[1][1]);
+	__m128 col2 = _mm_setr_ps(pMtx->m[0][2], pMtx->m[1][2], pMtx->m[0][2], pMtx->m[1][2]);
+	unsigned int i;
+
+	for (i = 0; i + 2 <= Num; i += 2)
+	{
+		__m128 p = _mm_loadu_ps(&pVecs[i].x);
+		__m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+
+		_mm_storeu_ps(&pResults[i].x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, x), _mm_mul_ps(col1, y)), col2));
+	}
+
+	// Odd one out
+	if (i < Num)
+		Affine2DMultVec(pResults + i, pMtx, pVecs + i);
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DMultPointsBatch(float *pResultX, float *pResultY, Affine2D *pMtx, float *pX, float *pY, unsigned int Num)
+{
+	__m128 m00 = _mm_set1_ps(pMtx->m[0][0]), m01 = _mm_set1_ps(pMtx->m[0][1]), m02 = _mm_set1_ps(pMtx->m[0][2]);
+	__m128 m10 = _mm_set1_ps(pMtx->m[1][0]), m11 = _mm_set1_ps(pMtx->m[1][1]), m12 = _mm_set1_ps(pMtx->m[1][2]);
+	unsigned int i;
+
+	for (i = 0; i + 4 <= Num; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pX + i);
+		__m128 y = _mm_loadu_ps(pY + i);
+
+		_mm_storeu_ps(pResultX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), m02));
+		_mm_storeu_ps(pResultY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), m12));
+	}
+
+	for (; i < Num; ++i)
+	{
+		float x = pX[i], y = pY[i];
+
+		pResultX[i] = pMtx->m[0][0] * x + pMtx->m[0][1] * y + pMtx->m[0][2];
+		pResultY[i] = pMtx->m[1][0] * x + pMtx->m[1][1] * y + pMtx->m[1][2];
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DToMatrix2D(Matrix2D *pResult, Affine2D *pMtx)
+{
+	pResult->m[0][0] = pMtx->m[0][0];
+	pResult->m[0][1] = pMtx->m[0][1];
+	pResult->m[0][2] = pMtx->m[0][2];
+	pResult->m[1][0] = pMtx->m[1][0];
+	pResult->m[1][1] = pMtx->m[1][1];
+	pResult->m[1][2] = pMtx->m[1][2];
+	pResult->m[2][0] = 0.f;
+	pResult->m[2][1] = 0.f;
+	pResult->m[2][2] = 1.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DFromMatrix2D(Affine2D *pResult, Matrix2D *pMtx)
+{
+	pResult->m[0][0] = pMtx->m[0][0];
+	pResult->m[0][1] = pMtx->m[0][1];
+	pResult->m[0][2] = pMtx->m[0][2];
+	pResult->m[1][0] = pMtx->m[1][0];
+	pResult->m[1][1] = pMtx->m[1][1];
+	pResult->m[1][2] = pMtx->m[1][2];
+}
+
+// ---------------------------------------------------------------------------
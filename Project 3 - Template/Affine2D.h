@@ -0,0 +1,78 @@
+#ifndef AFFINE2D_H
+#define AFFINE2D_H
+
+
+#include "Vector2D.h"
+#include "Matrix2D.h"
+#include "Rotation2D.h"
+
+/*
+2D affine transformation: the top 2 rows of a Matrix2D, the last one always
+being (0, 0, 1). Every transform of the game is affine, so this is all it needs,
+with a third less memory and arithmetic:
+	- Concat: 12 multiplications instead of 27
+	- MultVec: 4 multiplications and 4 additions
+
+m[i][2] is the translation
+*/
+typedef struct Affine2D
+{
+	float m[2][3];
+}Affine2D;
+
+
+void Affine2DIdentity(Affine2D *pResult);
+
+/*
+Result = Mtx0*Mtx1: Mtx1 is applied first.
+pResult can be one of the operands
+*/
+void Affine2DConcat(Affine2D *pResult, Affine2D *pMtx0, Affine2D *pMtx1);
+
+void Affine2DTranslate(Affine2D *pResult, float x, float y);
+
+void Affine2DScale(Affine2D *pResult, float x, float y);
+
+void Affine2DRotDeg(Affine2D *pResult, float Angle);
+
+void Affine2DRotRad(Affine2D *pResult, float Angle);
+
+/*
+Translate(x, y) * RotRad(Angle) * Scale(ScaleX, ScaleY), the game objects'
+transform, built directly: 4 multiplications, no concatenation
+*/
+void Affine2DScaleRotTrans(Affine2D *pResult, float ScaleX, float ScaleY, float Angle, float x, float y);
+
+/*
+The same from an orientation instead of an angle: no trigonometry
+*/
+void Affine2DScaleRotationTrans(Affine2D *pResult, float ScaleX, float ScaleY, Rotation2D *pRotation, float x, float y);
+
+/*
+Result = Mtx * Vec, Vec being a point (its translation is applied)
+*/
+void Affine2DMultVec(Vector2D *pResult, Affine2D *pMtx, Vector2D *pVec);
+
+/*
+Affine2DMultVec on Num points, 2 per SSE instruction. pResults can be pVecs.
+The arrays don't need any alignment, and the results match Affine2DMultVec's
+*/
+void Affine2DMultVecBatch(Vector2D *pResults, Affine2D *pMtx, Vector2D *pVecs, unsigned int Num);
+
+/*
+The same, on points stored as separate x and y arrays, 4 per SSE instruction.
+pResultX/Y can be pX/Y
+*/
+void Affine2DMultPointsBatch(float *pResultX, float *pResultY, Affine2D *pMtx, float *pX, float *pY, unsigned int Num);
+
+/*
+Conversions to and from the 3x3 layout, which AEGfxSetTransform expects.
+The last row of the Matrix2D is ignored
+*/
+void Affine2DToMatrix2D(Matrix2D *pResult, Affine2D *pMtx);
+
+void Affine2DFromMatrix2D(Affine2D *pResult, Matrix2D *pMtx);
+
+
+
+#endif
@@ -0,0 +1,305 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	Archetype.c
+// Creation Date	:	2026/10/19
+// Purpose			:	archetype based component storage: entities sharing a
+//						component set live in chunked structure of arrays tables
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <xmmintrin.h>
+
+#include "Archetype.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define ALIGN_UP(x)			(((x) + ARCHETYPE_COLUMN_ALIGNMENT - 1) & ~(u32)(ARCHETYPE_COLUMN_ALIGNMENT - 1))
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static u32 LayoutChunk(Archetype *pArchetype, u32 Capacity);
+static int AddChunk(Archetype *pArchetype);
+static ArchetypeChunk* GetChunk(Archetype *pArchetype, u32 Row, u32 *pChunkRow);
+
+// ---------------------------------------------------------------------------
+
+void ArchetypeWorldInit(ArchetypeWorld *pWorld, const u32 *pComponentSizes, u32 ComponentNum)
+{
+	memset(pWorld, 0, sizeof(ArchetypeWorld));
+
+	if (ComponentNum > ARCHETYPE_COMPONENT_NUM_MAX)
+		ComponentNum = ARCHETYPE_COMPONENT_NUM_MAX;
+
+	pWorld->mComponentNum = ComponentNum;
+	memcpy(pWorld->mComponentSizes, pComponentSizes, sizeof(u32) * ComponentNum);
+}
+
+// ---------------------------------------------------------------------------
+
+void ArchetypeWorldFree(ArchetypeWorld *pWorld)
+{
+	u32 a, c;
+
+	for (a = 0; a < pWorld->mArchetypeNum; ++a)
+	{
+		Archetype *pArchetype = pWorld->mArchetypes + a;
+
+		for (c = 0; c < pArchetype->mChunkNum; ++c)
+			_mm_free(pArchetype->mppChunks[c]);
+
+		free(pArchetype->mppChunks);
+	}
+
+	memset(pWorld->mArchetypes, 0, sizeof(pWorld->mArchetypes));
+	pWorld->mArchetypeNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ArchetypeWorldFind(ArchetypeWorld *pWorld, u32 ComponentMask)
+{
+	Archetype *pArchetype;
+	u32 a, c, rowSize = sizeof(u32), capacity;
+
+	for (a = 0; a < pWorld->mArchetypeNum; ++a)
+		if (pWorld->mArchetypes[a].mComponentMask == ComponentMask)
+			return a;
+
+	if (pWorld->mArchetypeNum == ARCHETYPE_NUM_MAX)
+		return ARCHETYPE_NONE;
+
+	pArchetype = pWorld->mArchetypes + pWorld->mArchetypeNum;
+	memset(pArchetype, 0, sizeof(Archetype));
+	pArchetype->mComponentMask = ComponentMask;
+
+	for (c = 0; c < pWorld->mComponentNum; ++c)
+	{
+		if (ComponentMask & (1 << c))
+		{
+			pArchetype->mComponentSizes[c] = pWorld->mComponentSizes[c];
+			rowSize += pWorld->mComponentSizes[c];
+		}
+	}
+
+	// As many rows as fit once the header and the column alignment are paid for
+	capacity = (ARCHETYPE_CHUNK_SIZE - ALIGN_UP(sizeof(ArchetypeChunk))) / rowSize;
+
+	while (capacity > 1 && LayoutChunk(pArchetype, capacity) > ARCHETYPE_CHUNK_SIZE)
+		--capacity;
+
+	if (0 == capacity)
+		capacity = 1;
+
+	pArchetype->mChunkCapacity = capacity;
+	pArchetype->mChunkSize = LayoutChunk(pArchetype, capacity);
+
+	if (pArchetype->mChunkSize < ARCHETYPE_CHUNK_SIZE)
+		pArchetype->mChunkSize = ARCHETYPE_CHUNK_SIZE;
+
+	return pWorld->mArchetypeNum++;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ArchetypeAddRow(Archetype *pArchetype, u32 Entity)
+{
+	ArchetypeChunk *pChunk;
+	u32 row = pArchetype->mRowNum, chunkRow, c;
+
+	// New chunk when the last one is full
+	if (row == pArchetype->mChunkNum * pArchetype->mChunkCapacity && 0 == AddChunk(pArchetype))
+		return ARCHETYPE_NONE;
+
+	pChunk = GetChunk(pArchetype, row, &chunkRow);
+	pChunk->mpEntities[chunkRow] = Entity;
+
+	for (c = 0; c < ARCHETYPE_COMPONENT_NUM_MAX; ++c)
+		if (pChunk->mpColumns[c])
+			memset((u8 *)pChunk->mpColumns[c] + chunkRow * pArchetype->mComponentSizes[c], 0, pArchetype->mComponentSizes[c]);
+
+	++pChunk->mRowNum;
+	++pArchetype->mRowNum;
+
+	return row;
+}
+
+// ---------------------------------------------------------------------------
+
+int ArchetypeSetRowNum(Archetype *pArchetype, u32 RowNum)
+{
+	u32 c;
+
+	while (pArchetype->mChunkNum * pArchetype->mChunkCapacity < RowNum)
+		if (0 == AddChunk(pArchetype))
+			return 0;
+
+	pArchetype->mRowNum = RowNum;
+
+	for (c = 0; c < pArchetype->mChunkNum; ++c)
+	{
+		u32 first = c * pArchetype->mChunkCapacity;
+
+		pArchetype->mppChunks[c]->mRowNum = (RowNum <= first) ? 0 :
+			(RowNum - first < pArchetype->mChunkCapacity) ? RowNum - first : pArchetype->mChunkCapacity;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ArchetypeRemoveRow(Archetype *pArchetype, u32 Row)
+{
+	ArchetypeChunk *pChunk, *pLastChunk;
+	u32 chunkRow, lastChunkRow, last = pArchetype->mRowNum - 1, moved = ARCHETYPE_NONE, c;
+
+	pChunk = GetChunk(pArchetype, Row, &chunkRow);
+	pLastChunk = GetChunk(pArchetype, last, &lastChunkRow);
+
+	if (Row != last)
+	{
+		moved = pLastChunk->mpEntities[lastChunkRow];
+		pChunk->mpEntities[chunkRow] = moved;
+
+		for (c = 0; c < ARCHETYPE_COMPONENT_NUM_MAX; ++c)
+		{
+			u32 size = pArchetype->mComponentSizes[c];
+
+			if (pChunk->mpColumns[c])
+				memcpy((u8 *)pChunk->mpColumns[c] + chunkRow * size, (u8 *)pLastChunk->mpColumns[c] + lastChunkRow * size, size);
+		}
+	}
+
+	--pLastChunk->mRowNum;
+	--pArchetype->mRowNum;
+
+	return moved;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ArchetypeMoveRow(Archetype *pFrom, u32 Row, Archetype *pTo, u32 *pNewRow)
+{
+	ArchetypeChunk *pFromChunk, *pToChunk;
+	u32 fromRow, toRow, c;
+
+	*pNewRow = ArchetypeAddRow(pTo, ArchetypeGetEntity(pFrom, Row));
+
+	if (ARCHETYPE_NONE == *pNewRow)
+		return ARCHETYPE_NONE;
+
+	pFromChunk = GetChunk(pFrom, Row, &fromRow);
+	pToChunk = GetChunk(pTo, *pNewRow, &toRow);
+
+	for (c = 0; c < ARCHETYPE_COMPONENT_NUM_MAX; ++c)
+	{
+		u32 size = pTo->mComponentSizes[c];
+
+		if (pFromChunk->mpColumns[c] && pToChunk->mpColumns[c])
+			memcpy((u8 *)pToChunk->mpColumns[c] + toRow * size, (u8 *)pFromChunk->mpColumns[c] + fromRow * size, size);
+	}
+
+	return ArchetypeRemoveRow(pFrom, Row);
+}
+
+// ---------------------------------------------------------------------------
+
+void* ArchetypeGetComponent(const Archetype *pArchetype, u32 Row, u32 Component)
+{
+	ArchetypeChunk *pChunk;
+	u32 chunkRow;
+
+	if (0 == (pArchetype->mComponentMask & (1 << Component)))
+		return 0;
+
+	pChunk = GetChunk((Archetype *)pArchetype, Row, &chunkRow);
+
+	return (u8 *)pChunk->mpColumns[Component] + chunkRow * pArchetype->mComponentSizes[Component];
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ArchetypeGetEntity(const Archetype *pArchetype, u32 Row)
+{
+	ArchetypeChunk *pChunk;
+	u32 chunkRow;
+
+	pChunk = GetChunk((Archetype *)pArchetype, Row, &chunkRow);
+
+	return pChunk->mpEntities[chunkRow];
+}
+
+// ---------------------------------------------------------------------------
+
+// Sets the column offsets for chunks of "Capacity" rows, and returns the chunk's size
+u32 LayoutChunk(Archetype *pArchetype, u32 Capacity)
+{
+	u32 offset = ALIGN_UP(sizeof(ArchetypeChunk)), c;
+
+	pArchetype->mEntityOffset = offset;
+	offset += ALIGN_UP(sizeof(u32) * Capacity);
+
+	for (c = 0; c < ARCHETYPE_COMPONENT_NUM_MAX; ++c)
+	{
+		if (pArchetype->mComponentMask & (1 << c))
+		{
+			pArchetype->mColumnOffsets[c] = offset;
+			offset += ALIGN_UP(pArchetype->mComponentSizes[c] * Capacity);
+		}
+	}
+
+	return offset;
+}
+
+// ---------------------------------------------------------------------------
+
+// Appends an empty chunk. Returns 0 if an allocation failed
+int AddChunk(Archetype *pArchetype)
+{
+	ArchetypeChunk *pChunk;
+	u32 c;
+
+	if (pArchetype->mChunkNum == pArchetype->mChunkMax)
+	{
+		u32 chunkMax = pArchetype->mChunkMax ? pArchetype->mChunkMax * 2 : 4;
+		ArchetypeChunk **ppChunks = (ArchetypeChunk **)realloc(pArchetype->mppChunks, sizeof(ArchetypeChunk *) * chunkMax);
+
+		if (0 == ppChunks)
+			return 0;
+
+		pArchetype->mppChunks = ppChunks;
+		pArchetype->mChunkMax = chunkMax;
+	}
+
+	pChunk = (ArchetypeChunk *)_mm_malloc(pArchetype->mChunkSize, ARCHETYPE_COLUMN_ALIGNMENT);
+
+	if (0 == pChunk)
+		return 0;
+
+	memset(pChunk, 0, sizeof(ArchetypeChunk));
+	pChunk->mpEntities = (u32 *)((u8 *)pChunk + pArchetype->mEntityOffset);
+
+	for (c = 0; c < ARCHETYPE_COMPONENT_NUM_MAX; ++c)
+		if (pArchetype->mComponentMask & (1 << c))
+			pChunk->mpColumns[c] = (u8 *)pChunk + pArchetype->mColumnOffsets[c];
+
+	pArchetype->mppChunks[pArchetype->mChunkNum++] = pChunk;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+ArchetypeChunk* GetChunk(Archetype *pArchetype, u32 Row, u32 *pChunkRow)
+{
+	*pChunkRow = Row % pArchetype->mChunkCapacity;
+
+	return pArchetype->mppChunks[Row / pArchetype->mChunkCapacity];
+}
+
+// ---------------------------------------------------------------------------
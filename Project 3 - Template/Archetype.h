@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	Archetype.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the archetype based component storage
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define ARCHETYPE_CHUNK_SIZE				(16 * 1024)			// Bytes per chunk, header included
+#define ARCHETYPE_COLUMN_ALIGNMENT			16					// Every column starts on a 16 bytes boundary
+#define ARCHETYPE_COMPONENT_NUM_MAX			8
+#define ARCHETYPE_NUM_MAX					32					// Different component sets
+#define ARCHETYPE_NONE						0xFFFFFFFF			// No archetype, row or entity
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+/*
+A fixed size block holding up to mChunkCapacity rows of an archetype, one column
+per component (structure of arrays). The columns follow the header in the block.
+*/
+typedef struct ArchetypeChunk
+{
+	u32						mRowNum;
+	u32						*mpEntities;								// The entity of each row
+	void					*mpColumns[ARCHETYPE_COMPONENT_NUM_MAX];	// 0 for the components not in the archetype
+}ArchetypeChunk;
+
+// ---------------------------------------------------------------------------
+
+/*
+Every entity with the same set of components. Rows are dense: every chunk is full
+but the last one, and removing a row moves the last row into its place.
+Row r is row (r % mChunkCapacity) of chunk (r / mChunkCapacity).
+*/
+typedef struct Archetype
+{
+	u32						mComponentMask;								// Bit c set if component c is in the archetype
+	u32						mComponentSizes[ARCHETYPE_COMPONENT_NUM_MAX];
+	u32						mRowNum;
+
+	u32						mChunkSize;									// ARCHETYPE_CHUNK_SIZE, unless a single row doesn't fit
+	u32						mChunkCapacity;								// Rows per chunk
+	u32						mEntityOffset;								// Column offsets in the chunks
+	u32						mColumnOffsets[ARCHETYPE_COMPONENT_NUM_MAX];
+
+	ArchetypeChunk			**mppChunks;								// Empty chunks are kept for reuse
+	u32						mChunkNum;
+	u32						mChunkMax;
+}Archetype;
+
+// ---------------------------------------------------------------------------
+
+typedef struct ArchetypeWorld
+{
+	u32						mComponentNum;
+	u32						mComponentSizes[ARCHETYPE_COMPONENT_NUM_MAX];
+
+	Archetype				mArchetypes[ARCHETYPE_NUM_MAX];				// Created on demand, never moved
+	u32						mArchetypeNum;
+}ArchetypeWorld;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Sets up a world whose components have the given sizes. Component c is bit (1 << c)
+of the component masks.
+
+Systems iterate the archetypes holding the components they need, chunk by chunk,
+over contiguous columns:
+
+	for (a = 0; a < pWorld->mArchetypeNum; ++a)
+		if (Required == (pWorld->mArchetypes[a].mComponentMask & Required))
+			for (c = 0; c < pWorld->mArchetypes[a].mChunkNum; ++c)
+			{
+				ArchetypeChunk *pChunk = pWorld->mArchetypes[a].mppChunks[c];
+				Component_X *pX = (Component_X *)pChunk->mpColumns[COMPONENT_X];
+
+				for (i = 0; i < pChunk->mRowNum; ++i)
+					...
+			}
+*/
+void ArchetypeWorldInit(ArchetypeWorld *pWorld, const u32 *pComponentSizes, u32 ComponentNum);
+
+// Frees every chunk. The world needs to be initialized again before being reused
+void ArchetypeWorldFree(ArchetypeWorld *pWorld);
+
+// Index of the archetype with exactly these components, created if needed. ARCHETYPE_NONE if there's no room left
+u32 ArchetypeWorldFind(ArchetypeWorld *pWorld, u32 ComponentMask);
+
+/*
+Adds a row for the entity, with zeroed components.
+
+ - Returns the row, ARCHETYPE_NONE if a chunk allocation failed
+*/
+u32 ArchetypeAddRow(Archetype *pArchetype, u32 Entity);
+
+/*
+Sets the number of rows, allocating the chunks needed. The rows added aren't
+initialized: for restoring whole columns at once, chunk by chunk.
+
+ - Returns 0 if a chunk allocation failed, in which case the rows are left as they were
+*/
+int ArchetypeSetRowNum(Archetype *pArchetype, u32 RowNum);
+
+/*
+Removes a row, moving the last row into its place.
+
+ - Returns the entity whose row is now "Row", ARCHETYPE_NONE if no row was moved
+*/
+u32 ArchetypeRemoveRow(Archetype *pArchetype, u32 Row);
+
+/*
+Moves a row to another archetype, copying the components both archetypes have.
+The other components are zeroed, or dropped.
+
+ - Parameters
+	- pNewRow:		Receives the row in pTo, ARCHETYPE_NONE if the allocation failed
+					(in which case the row isn't removed from pFrom)
+
+ - Returns the entity whose row in pFrom is now "Row", as ArchetypeRemoveRow
+*/
+u32 ArchetypeMoveRow(Archetype *pFrom, u32 Row, Archetype *pTo, u32 *pNewRow);
+
+// Component of a row, 0 if the archetype doesn't have it
+void* ArchetypeGetComponent(const Archetype *pArchetype, u32 Row, u32 Component);
+
+u32 ArchetypeGetEntity(const Archetype *pArchetype, u32 Row);
+
+// ---------------------------------------------------------------------------
+
+#endif // ARCHETYPE_H
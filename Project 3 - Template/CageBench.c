@@ -0,0 +1,363 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageBench.c
+// Creation Date	:	2026/10/19
+// Purpose			:	whole-step cage simulation benchmark: scaling over ball,
+//						obstacle and thread counts, written out as JSON
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <windows.h>
+#include <psapi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "CageBench.h"
+#include "CageSim.h"
+#include "CollisionStats.h"
+#include "JobSystem.h"
+
+#pragma comment (lib, "psapi.lib")
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_DT					(1.0f / 60.0f)
+#define BENCH_BALL_RADIUS			2.0f
+#define BENCH_BALL_SPEED			120.0f
+#define BENCH_SPACING				(20.0f * BENCH_BALL_RADIUS)		// Side of the square every ball and obstacle gets
+#define BENCH_WARMUP_STEP_NUM		2								// Untimed steps at the start of every run
+#define BENCH_OBSTACLE_NUM_MIN		8
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// The balls are stepped by a JobParallelFor, one range per thread: the calling thread and ThreadNum - 1 workers
+typedef struct
+{
+	CageSim				*mpSim;
+	u32					mThreadNum;
+	CageSimWorker		mWorkers[CAGE_BENCH_THREAD_NUM_MAX];	// Indexed by JobGetThreadIndex
+}BenchPool;
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+static const char *sgLayoutNames[CAGE_SCENE_LAYOUT_NUM] =
+{
+	"uniform",
+	"clustered",
+	"corridors",
+	"rings",
+};
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static int BenchScene(const CageBenchDesc *pDesc, FILE *pFile, u32 BallNum, u32 ObstacleNum, u32 *pRunNum);
+static int BenchRun(const CageBenchDesc *pDesc, FILE *pFile, const CageScene *pScene, u32 ThreadNum, f64 *pStepTimes, u32 *pRunNum);
+static int PoolInit(BenchPool *pPool, CageSim *pSim, u32 ThreadNum);
+static void PoolFree(BenchPool *pPool);
+static void PoolStep(BenchPool *pPool);
+static void PoolStepBalls(void *pData, u32 First, u32 Num);
+static u32 NextCount(u32 Count, u32 Factor, u32 Max);
+static int CompareF64(const void *pA, const void *pB);
+static f64 Percentile(const f64 *pSorted, u32 Num, f64 Fraction);
+static f64 GetSeconds(void);
+
+// ---------------------------------------------------------------------------
+
+void CageBenchDescDefault(CageBenchDesc *pDesc)
+{
+	memset(pDesc, 0, sizeof(CageBenchDesc));
+
+	pDesc->mLayout = CAGE_SCENE_LAYOUT_UNIFORM;
+	pDesc->mSeed = 1;
+	pDesc->mBallNumMax = 1000000;
+	pDesc->mObstacleNumMax = 1000000;
+	pDesc->mThreadNumMax = 0;
+	pDesc->mSecondsPerRun = 0.5;
+	pDesc->mStepNumMin = 5;
+	pDesc->mStepNumMax = 1000;
+}
+
+// ---------------------------------------------------------------------------
+
+int CageBenchRun(const CageBenchDesc *pDesc, const char *pFileName)
+{
+	CageBenchDesc desc = *pDesc;
+	SYSTEM_INFO systemInfo;
+	FILE *pFile;
+	u32 ballNum, obstacleNum, runNum = 0;
+	int result = 1, ownJobSystem;
+
+	GetSystemInfo(&systemInfo);
+
+	if (0 == desc.mThreadNumMax)
+		desc.mThreadNumMax = systemInfo.dwNumberOfProcessors;
+	desc.mThreadNumMax = (desc.mThreadNumMax < CAGE_BENCH_THREAD_NUM_MAX) ? desc.mThreadNumMax : CAGE_BENCH_THREAD_NUM_MAX;
+	desc.mThreadNumMax = (desc.mThreadNumMax > 0) ? desc.mThreadNumMax : 1;
+
+	// Run from the command line, before the game state manager starts the job system
+	ownJobSystem = !JobSystemIsRunning();
+	if (ownJobSystem && desc.mThreadNumMax > 1 && 0 == JobSystemInit(desc.mThreadNumMax - 1))
+		return 0;
+
+	// The workers limit the thread counts
+	desc.mThreadNumMax = (desc.mThreadNumMax < JobSystemGetWorkerNum() + 1) ? desc.mThreadNumMax : JobSystemGetWorkerNum() + 1;
+	desc.mBallNumMax = (desc.mBallNumMax > 0) ? desc.mBallNumMax : 1;
+	desc.mObstacleNumMax = (desc.mObstacleNumMax > BENCH_OBSTACLE_NUM_MIN) ? desc.mObstacleNumMax : BENCH_OBSTACLE_NUM_MIN;
+	desc.mStepNumMin = (desc.mStepNumMin > 0) ? desc.mStepNumMin : 1;
+	desc.mStepNumMax = (desc.mStepNumMax > desc.mStepNumMin) ? desc.mStepNumMax : desc.mStepNumMin;
+	desc.mLayout = (desc.mLayout < CAGE_SCENE_LAYOUT_NUM) ? desc.mLayout : CAGE_SCENE_LAYOUT_UNIFORM;
+
+	pFile = fopen(pFileName, "w");
+	if (0 == pFile)
+	{
+		if (ownJobSystem)
+			JobSystemShutdown();
+
+		return 0;
+	}
+
+	fprintf(pFile, "{\n");
+	fprintf(pFile, "\t\"benchmark\": \"cage_sim\",\n");
+	fprintf(pFile, "\t\"layout\": \"%s\",\n", sgLayoutNames[desc.mLayout]);
+	fprintf(pFile, "\t\"seed\": %lu,\n", (unsigned long)desc.mSeed);
+	fprintf(pFile, "\t\"processors\": %lu,\n", (unsigned long)systemInfo.dwNumberOfProcessors);
+	fprintf(pFile, "\t\"dt\": %.6f,\n", BENCH_DT);
+	fprintf(pFile, "\t\"collision_stats\": %d,\n", COLLISION_STATS_ENABLED);
+	fprintf(pFile, "\t\"runs\": [");
+
+	// Obstacles outside, balls inside: the scene is generated once for all the thread counts
+	for (obstacleNum = BENCH_OBSTACLE_NUM_MIN; result && obstacleNum; obstacleNum = NextCount(obstacleNum, 8, desc.mObstacleNumMax))
+		for (ballNum = 1; result && ballNum; ballNum = NextCount(ballNum, 10, desc.mBallNumMax))
+			result = BenchScene(&desc, pFile, ballNum, obstacleNum, &runNum);
+
+	fprintf(pFile, "\n\t]\n}\n");
+	fclose(pFile);
+
+	JobSystemSetWorkerLimit(JobSystemGetWorkerNum());
+
+	if (ownJobSystem)
+		JobSystemShutdown();
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+
+int BenchScene(const CageBenchDesc *pDesc, FILE *pFile, u32 BallNum, u32 ObstacleNum, u32 *pRunNum)
+{
+	CageSceneDesc sceneDesc;
+	CageScene scene;
+	f64 *pStepTimes;
+	u32 threadNum;
+	int result = 1;
+
+	CageSceneDescDefault(&sceneDesc);
+	sceneDesc.mSeed = pDesc->mSeed;
+	sceneDesc.mLayout = pDesc->mLayout;
+	sceneDesc.mSegmentNum = ObstacleNum - ObstacleNum / 4;
+	sceneDesc.mPillarNum = ObstacleNum / 4;
+	sceneDesc.mBallNum = BallNum;
+	sceneDesc.mHalfSize = 0.5f * BENCH_SPACING * sqrtf((f32)(BallNum + ObstacleNum));
+	sceneDesc.mBallRadius = BENCH_BALL_RADIUS;
+	sceneDesc.mBallSpeed = BENCH_BALL_SPEED;
+
+	pStepTimes = (f64 *)malloc(sizeof(f64) * pDesc->mStepNumMax);
+	if (0 == pStepTimes)
+		return 0;
+
+	if (0 == CageSceneGenerate(&scene, &sceneDesc))
+	{
+		free(pStepTimes);
+		return 0;
+	}
+
+	for (threadNum = 1; result && threadNum; threadNum = NextCount(threadNum, 2, pDesc->mThreadNumMax))
+		result = BenchRun(pDesc, pFile, &scene, threadNum, pStepTimes, pRunNum);
+
+	CageSceneFree(&scene);
+	free(pStepTimes);
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+
+int BenchRun(const CageBenchDesc *pDesc, FILE *pFile, const CageScene *pScene, u32 ThreadNum, f64 *pStepTimes, u32 *pRunNum)
+{
+	PROCESS_MEMORY_COUNTERS memoryBefore, memoryAfter;
+	CageSim sim;
+	BenchPool pool;
+	f64 start, end, total;
+	u32 i, stepNum = 0;
+
+	// The peak working set never goes down: trimmed instead, the working set only grows by what this run touches
+	EmptyWorkingSet(GetCurrentProcess());
+	memset(&memoryBefore, 0, sizeof(memoryBefore));
+	GetProcessMemoryInfo(GetCurrentProcess(), &memoryBefore, sizeof(memoryBefore));
+
+	// Every thread count starts from the same state
+	if (0 == CageSimInit(&sim, pScene))
+		return 0;
+
+	if (0 == PoolInit(&pool, &sim, ThreadNum))
+	{
+		CageSimFree(&sim);
+		return 0;
+	}
+
+	for (i = 0; i < BENCH_WARMUP_STEP_NUM; ++i)
+		PoolStep(&pool);
+
+	start = GetSeconds();
+	end = start;
+
+	while (stepNum < pDesc->mStepNumMax && (stepNum < pDesc->mStepNumMin || end - start < pDesc->mSecondsPerRun))
+	{
+		f64 stepStart = end;
+
+		PoolStep(&pool);
+
+		end = GetSeconds();
+		pStepTimes[stepNum++] = end - stepStart;
+	}
+
+	total = end - start;
+
+	memset(&memoryAfter, 0, sizeof(memoryAfter));
+	GetProcessMemoryInfo(GetCurrentProcess(), &memoryAfter, sizeof(memoryAfter));
+
+	qsort(pStepTimes, stepNum, sizeof(f64), CompareF64);
+
+	fprintf(pFile, "%s\n\t\t{", (*pRunNum > 0) ? "," : "");
+	fprintf(pFile, "\"balls\": %lu, \"segments\": %lu, \"pillars\": %lu, \"threads\": %lu, \"steps\": %lu, ",
+		(unsigned long)sim.mBallNum, (unsigned long)sim.mSegmentNum, (unsigned long)sim.mPillarNum, (unsigned long)ThreadNum, (unsigned long)stepNum);
+	fprintf(pFile, "\"steps_per_sec\": %.3f, \"ball_steps_per_sec\": %.1f, ",
+		stepNum / total, (f64)stepNum * sim.mBallNum / total);
+	fprintf(pFile, "\"p50_ms\": %.4f, \"p99_ms\": %.4f, ",
+		Percentile(pStepTimes, stepNum, 0.5) * 1000.0, Percentile(pStepTimes, stepNum, 0.99) * 1000.0);
+	fprintf(pFile, "\"rss_bytes\": %llu, \"run_rss_bytes\": %llu}",
+		(unsigned long long)memoryAfter.WorkingSetSize,
+		(unsigned long long)((memoryAfter.WorkingSetSize > memoryBefore.WorkingSetSize) ? memoryAfter.WorkingSetSize - memoryBefore.WorkingSetSize : 0));
+	fflush(pFile);
+	++*pRunNum;
+
+	PoolFree(&pool);
+	CageSimFree(&sim);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int PoolInit(BenchPool *pPool, CageSim *pSim, u32 ThreadNum)
+{
+	u32 t;
+
+	memset(pPool, 0, sizeof(BenchPool));
+	pPool->mpSim = pSim;
+
+	for (t = 0; t < ThreadNum; ++t)
+	{
+		if (0 == CageSimWorkerInit(&pPool->mWorkers[t], pSim))
+		{
+			PoolFree(pPool);
+			return 0;
+		}
+
+		// Counted once initialized, so PoolFree only frees the initialized ones
+		++pPool->mThreadNum;
+	}
+
+	// The other workers take no range
+	JobSystemSetWorkerLimit(ThreadNum - 1);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void PoolFree(BenchPool *pPool)
+{
+	u32 t;
+
+	for (t = 0; t < pPool->mThreadNum; ++t)
+		CageSimWorkerFree(&pPool->mWorkers[t]);
+
+	pPool->mThreadNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void PoolStep(BenchPool *pPool)
+{
+	u32 ballNum = pPool->mpSim->mBallNum;
+
+	// The kernels count into per thread slots: zeroed every step, before a big run can wrap them
+	CollisionStatsFrameBegin();
+	CageSimBeginStep(pPool->mpSim);
+
+	// One range per thread, like the ranges were split before the job system
+	JobParallelFor(PoolStepBalls, pPool, ballNum, (ballNum + pPool->mThreadNum - 1) / pPool->mThreadNum);
+
+	CageSimEndStep(pPool->mpSim);
+}
+
+// ---------------------------------------------------------------------------
+
+void PoolStepBalls(void *pData, u32 First, u32 Num)
+{
+	BenchPool *pPool = (BenchPool *)pData;
+
+	CageSimStepBalls(pPool->mpSim, &pPool->mWorkers[JobGetThreadIndex()], BENCH_DT, First, Num);
+}
+
+// ---------------------------------------------------------------------------
+
+u32 NextCount(u32 Count, u32 Factor, u32 Max)
+{
+	// Geometric steps, then Max itself, then 0 to stop
+	if (Count >= Max)
+		return 0;
+
+	return (Count * Factor < Max) ? Count * Factor : Max;
+}
+
+// ---------------------------------------------------------------------------
+
+int CompareF64(const void *pA, const void *pB)
+{
+	f64 a = *(const f64 *)pA, b = *(const f64 *)pB;
+
+	return (a > b) - (a < b);
+}
+
+// ---------------------------------------------------------------------------
+
+f64 Percentile(const f64 *pSorted, u32 Num, f64 Fraction)
+{
+	// Nearest rank: the smallest value with at least Fraction of the values at or below it
+	u32 rank = (u32)ceil(Fraction * Num);
+
+	return pSorted[(rank > 0) ? rank - 1 : 0];
+}
+
+// ---------------------------------------------------------------------------
+
+f64 GetSeconds(void)
+{
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (f64)counter.QuadPart / (f64)frequency.QuadPart;
+}
+
+// ---------------------------------------------------------------------------
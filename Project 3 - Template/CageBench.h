@@ -0,0 +1,64 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageBench.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the whole-step cage simulation benchmark
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef CAGE_BENCH_H
+#define CAGE_BENCH_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define CAGE_BENCH_THREAD_NUM_MAX		64
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+/*
+The benchmark steps a CageSim for every combination of:
+	- ball counts 1, 10, 100... up to mBallNumMax (always included)
+	- obstacle counts 8, 64, 512... up to mObstacleNumMax (always included), 3/4 segments and 1/4 pillars
+	- thread counts 1, 2, 4... up to mThreadNumMax (always included)
+The cage grows with the counts, so the density stays the same across the scenes
+*/
+typedef struct CageBenchDesc
+{
+	u32			mLayout;					// From the CAGE_SCENE_LAYOUT enum
+	u32			mSeed;
+	u32			mBallNumMax;
+	u32			mObstacleNumMax;
+	u32			mThreadNumMax;				// 0: one per processor
+	f64			mSecondsPerRun;				// Every run steps for about this long...
+	u32			mStepNumMin;				// ...but at least this many steps
+	u32			mStepNumMax;				// ...and at most this many
+}CageBenchDesc;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// 1 to 1M balls, 8 to 1M obstacles, 1 to one thread per processor, uniform layout, half a second per run
+void CageBenchDescDefault(CageBenchDesc *pDesc);
+
+/*
+Runs the benchmark and writes the results to pFileName as JSON: one object per run
+with the counts, steps per second, ball steps per second, the median and 99th
+percentile step times (nearest rank), the process' working set at the end of
+the run, and how much it grew during the run.
+Every run is flushed as soon as it's done, so an interrupted benchmark still
+leaves its first runs behind (without the closing brackets).
+
+ - Returns 1 on success, 0 if the file couldn't be written or an allocation failed
+*/
+int CageBenchRun(const CageBenchDesc *pDesc, const char *pFileName);
+
+// ---------------------------------------------------------------------------
+
+#endif // CAGE_BENCH_H
@@ -0,0 +1,629 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageScene.c
+// Creation Date	:	2026/10/19
+// Purpose			:	seeded procedural stress scenes: uniform, clustered,
+//						maze and ring layouts of segments, pillars and balls
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "CageScene.h"
+#include "ObstacleGrid.h"
+#include "SinCos.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define SCENE_PI					3.1415926535897932f
+#define SCENE_WALL_NUM				4					// The cage itself
+#define SCENE_PLACEMENT_TRIES		16					// Before a ball is dropped
+#define SCENE_RING_DOOR_PERIOD		8					// One ring segment out of this many is left open
+#define SCENE_CLUSTER_NUM_MAX		64
+
+#define SCENE_MIN(a, b)				((a) < (b) ? (a) : (b))
+#define SCENE_MAX(a, b)				((a) > (b) ? (a) : (b))
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// xorshift64*, so the scenes don't depend on the CRT's rand()
+typedef struct
+{
+	u64			mState;
+}SceneRandom;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void SceneRandomSeed(SceneRandom *pRandom, u32 Seed);
+static u32 SceneRandomNext(SceneRandom *pRandom);
+static float SceneRandomFloat(SceneRandom *pRandom, float Min, float Max);
+static u32 SceneRandomIndex(SceneRandom *pRandom, u32 Num);
+static void SceneRandomDirection(SceneRandom *pRandom, Vector2D *pDirection);
+
+static void AddSegment(CageScene *pScene, float x0, float y0, float x1, float y1);
+static void AddRandomSegment(CageScene *pScene, SceneRandom *pRandom, float x, float y, float Length);
+static float ClampToCage(const CageScene *pScene, float Value, float Inset);
+
+static u32 GetMazeSize(u32 WallNum);
+static void GetRingCounts(u32 WallNum, u32 *pRingNum, u32 *pSlotNum);
+static u32 GetRingSlots(u32 Ring, u32 RingNum, u32 WallNum);
+
+static void GenerateUniform(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float Spacing, float PillarRadius);
+static void GenerateClustered(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float Spacing, float PillarRadius);
+static int GenerateCorridors(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float PillarRadius);
+static void GenerateRings(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float PillarRadius);
+static int PlaceBalls(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom);
+static int BallOverlaps(const ObstacleGrid *pGrid, float x, float y, float Radius);
+
+// ---------------------------------------------------------------------------
+
+void CageSceneDescDefault(CageSceneDesc *pDesc)
+{
+	memset(pDesc, 0, sizeof(CageSceneDesc));
+
+	pDesc->mSeed = 1;
+	pDesc->mLayout = CAGE_SCENE_LAYOUT_UNIFORM;
+	pDesc->mSegmentNum = 64;
+	pDesc->mPillarNum = 16;
+	pDesc->mBallNum = 16;
+	pDesc->mHalfSize = 400.0f;
+	pDesc->mBallRadius = 4.0f;
+	pDesc->mBallSpeed = 200.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+int CageSceneGenerate(CageScene *pScene, const CageSceneDesc *pDesc)
+{
+	SceneRandom random;
+	u32 wallNum = SCENE_MAX(pDesc->mSegmentNum, SCENE_WALL_NUM) - SCENE_WALL_NUM;
+	u32 segmentMax = SCENE_WALL_NUM + wallNum;
+	float h = pDesc->mHalfSize;
+	float spacing, pillarRadius;
+
+	memset(pScene, 0, sizeof(CageScene));
+	pScene->mHalfSize = h;
+
+	SceneRandomSeed(&random, pDesc->mSeed);
+
+	// Typical distance between 2 obstacles
+	spacing = 2.0f * h / sqrtf((float)(wallNum + pDesc->mPillarNum + 1));
+	pillarRadius = (pDesc->mPillarRadius > 0.0f) ? pDesc->mPillarRadius : 0.2f * spacing;
+
+	if (CAGE_SCENE_LAYOUT_CORRIDORS == pDesc->mLayout)
+	{
+		u32 mazeSize = GetMazeSize(wallNum);
+		segmentMax = SCENE_WALL_NUM + (mazeSize - 1) * (mazeSize - 1);
+	}
+	else
+	if (CAGE_SCENE_LAYOUT_RINGS == pDesc->mLayout)
+	{
+		u32 ringNum, slotNum;
+		GetRingCounts(wallNum, &ringNum, &slotNum);
+		segmentMax = SCENE_WALL_NUM + slotNum;
+	}
+
+	pScene->mpSegments = (LineSegment2D *)malloc(sizeof(LineSegment2D) * segmentMax);
+	pScene->mpPillarCenters = (Vector2D *)malloc(sizeof(Vector2D) * SCENE_MAX(pDesc->mPillarNum, 1));
+	pScene->mpPillarRadii = (float *)malloc(sizeof(float) * SCENE_MAX(pDesc->mPillarNum, 1));
+	pScene->mpBallPositions = (Vector2D *)malloc(sizeof(Vector2D) * SCENE_MAX(pDesc->mBallNum, 1));
+	pScene->mpBallVelocities = (Vector2D *)malloc(sizeof(Vector2D) * SCENE_MAX(pDesc->mBallNum, 1));
+	pScene->mpBallRadii = (float *)malloc(sizeof(float) * SCENE_MAX(pDesc->mBallNum, 1));
+
+	if (0 == pScene->mpSegments || 0 == pScene->mpPillarCenters || 0 == pScene->mpPillarRadii ||
+		0 == pScene->mpBallPositions || 0 == pScene->mpBallVelocities || 0 == pScene->mpBallRadii)
+	{
+		CageSceneFree(pScene);
+		return 0;
+	}
+
+	// The cage
+	AddSegment(pScene, -h, -h,  h, -h);
+	AddSegment(pScene,  h, -h,  h,  h);
+	AddSegment(pScene,  h,  h, -h,  h);
+	AddSegment(pScene, -h,  h, -h, -h);
+
+	switch (pDesc->mLayout)
+	{
+	case CAGE_SCENE_LAYOUT_CLUSTERED:
+		GenerateClustered(pScene, pDesc, &random, spacing, pillarRadius);
+		break;
+
+	case CAGE_SCENE_LAYOUT_CORRIDORS:
+		if (0 == GenerateCorridors(pScene, pDesc, &random, pillarRadius))
+		{
+			CageSceneFree(pScene);
+			return 0;
+		}
+		break;
+
+	case CAGE_SCENE_LAYOUT_RINGS:
+		GenerateRings(pScene, pDesc, &random, pillarRadius);
+		break;
+
+	default:
+		GenerateUniform(pScene, pDesc, &random, spacing, pillarRadius);
+		break;
+	}
+
+	if (0 == PlaceBalls(pScene, pDesc, &random))
+	{
+		CageSceneFree(pScene);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSceneFree(CageScene *pScene)
+{
+	free(pScene->mpSegments);
+	free(pScene->mpPillarCenters);
+	free(pScene->mpPillarRadii);
+	free(pScene->mpBallPositions);
+	free(pScene->mpBallVelocities);
+	free(pScene->mpBallRadii);
+
+	memset(pScene, 0, sizeof(CageScene));
+}
+
+// ---------------------------------------------------------------------------
+
+u64 CageSceneHash(const CageScene *pScene)
+{
+	const unsigned char *pBlocks[6];
+	size_t sizes[6];
+	u64 hash = 14695981039346656037ULL;
+	size_t b, i;
+
+	pBlocks[0] = (const unsigned char *)pScene->mpSegments;			sizes[0] = sizeof(LineSegment2D) * pScene->mSegmentNum;
+	pBlocks[1] = (const unsigned char *)pScene->mpPillarCenters;	sizes[1] = sizeof(Vector2D) * pScene->mPillarNum;
+	pBlocks[2] = (const unsigned char *)pScene->mpPillarRadii;		sizes[2] = sizeof(float) * pScene->mPillarNum;
+	pBlocks[3] = (const unsigned char *)pScene->mpBallPositions;	sizes[3] = sizeof(Vector2D) * pScene->mBallNum;
+	pBlocks[4] = (const unsigned char *)pScene->mpBallVelocities;	sizes[4] = sizeof(Vector2D) * pScene->mBallNum;
+	pBlocks[5] = (const unsigned char *)pScene->mpBallRadii;		sizes[5] = sizeof(float) * pScene->mBallNum;
+
+	for (b = 0; b < 6; ++b)
+	{
+		for (i = 0; i < sizes[b]; ++i)
+		{
+			hash ^= pBlocks[b][i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	return hash;
+}
+
+// ---------------------------------------------------------------------------
+
+void SceneRandomSeed(SceneRandom *pRandom, u32 Seed)
+{
+	// Any seed, 0 included, gives a non zero state
+	pRandom->mState = ((u64)(Seed & 0xFFFFFFFF) + 1) * 0x9E3779B97F4A7C15ULL;
+	SceneRandomNext(pRandom);
+}
+
+// ---------------------------------------------------------------------------
+
+u32 SceneRandomNext(SceneRandom *pRandom)
+{
+	u64 x = pRandom->mState;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	pRandom->mState = x;
+
+	return (u32)((x * 0x2545F4914F6CDD1DULL) >> 32) & 0xFFFFFFFF;
+}
+
+// ---------------------------------------------------------------------------
+
+float SceneRandomFloat(SceneRandom *pRandom, float Min, float Max)
+{
+	// 24 bits, exactly representable
+	float unit = (float)(SceneRandomNext(pRandom) >> 8) * (1.0f / 16777216.0f);
+
+	return Min + (Max - Min) * unit;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 SceneRandomIndex(SceneRandom *pRandom, u32 Num)
+{
+	return (u32)(((u64)SceneRandomNext(pRandom) * Num) >> 32);
+}
+
+// ---------------------------------------------------------------------------
+
+void SceneRandomDirection(SceneRandom *pRandom, Vector2D *pDirection)
+{
+	float x, y, lengthSquare;
+
+	// Rejection sampling in the unit disk: uniform angles without sin/cos
+	do
+	{
+		x = SceneRandomFloat(pRandom, -1.0f, 1.0f);
+		y = SceneRandomFloat(pRandom, -1.0f, 1.0f);
+		lengthSquare = x * x + y * y;
+	}while (lengthSquare > 1.0f || lengthSquare < 0.0001f);
+
+	lengthSquare = sqrtf(lengthSquare);
+	pDirection->x = x / lengthSquare;
+	pDirection->y = y / lengthSquare;
+}
+
+// ---------------------------------------------------------------------------
+
+void AddSegment(CageScene *pScene, float x0, float y0, float x1, float y1)
+{
+	Vector2D p0, p1;
+
+	Vector2DSet(&p0, x0, y0);
+	Vector2DSet(&p1, x1, y1);
+
+	if (BuildLineSegment2D(&pScene->mpSegments[pScene->mSegmentNum], &p0, &p1))
+		++pScene->mSegmentNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void AddRandomSegment(CageScene *pScene, SceneRandom *pRandom, float x, float y, float Length)
+{
+	Vector2D direction;
+	float halfLength = 0.5f * Length;
+
+	SceneRandomDirection(pRandom, &direction);
+
+	x = ClampToCage(pScene, x, halfLength);
+	y = ClampToCage(pScene, y, halfLength);
+
+	AddSegment(pScene, x - direction.x * halfLength, y - direction.y * halfLength, x + direction.x * halfLength, y + direction.y * halfLength);
+}
+
+// ---------------------------------------------------------------------------
+
+float ClampToCage(const CageScene *pScene, float Value, float Inset)
+{
+	float limit = SCENE_MAX(pScene->mHalfSize - Inset, 0.0f);
+
+	return SCENE_MAX(-limit, SCENE_MIN(Value, limit));
+}
+
+// ---------------------------------------------------------------------------
+
+u32 GetMazeSize(u32 WallNum)
+{
+	// A perfect maze of n x n cells keeps (n - 1)^2 of its inner walls
+	return 2 + (u32)sqrtf((float)WallNum);
+}
+
+// ---------------------------------------------------------------------------
+
+void GetRingCounts(u32 WallNum, u32 *pRingNum, u32 *pSlotNum)
+{
+	u32 ring;
+
+	// Ring k gets about k + 1 times the slots of the first one, and the doors eat 1/8th
+	*pRingNum = SCENE_MAX((u32)(sqrtf((float)WallNum / SCENE_PI) + 0.5f), 1);
+	*pSlotNum = 0;
+
+	for (ring = 0; ring < *pRingNum; ++ring)
+		*pSlotNum += GetRingSlots(ring, *pRingNum, WallNum);
+}
+
+// ---------------------------------------------------------------------------
+
+u32 GetRingSlots(u32 Ring, u32 RingNum, u32 WallNum)
+{
+	u32 total = (u32)((float)WallNum * SCENE_RING_DOOR_PERIOD / (SCENE_RING_DOOR_PERIOD - 1));
+	u32 slots = (u32)((u64)total * (Ring + 1) * 2 / ((u64)RingNum * (RingNum + 1)));
+
+	return SCENE_MAX(slots, SCENE_RING_DOOR_PERIOD);
+}
+
+// ---------------------------------------------------------------------------
+
+void GenerateUniform(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float Spacing, float PillarRadius)
+{
+	float h = pDesc->mHalfSize;
+	u32 i;
+
+	for (i = SCENE_WALL_NUM; i < pDesc->mSegmentNum; ++i)
+		AddRandomSegment(pScene, pRandom, SceneRandomFloat(pRandom, -h, h), SceneRandomFloat(pRandom, -h, h), 0.8f * Spacing);
+
+	for (i = 0; i < pDesc->mPillarNum; ++i)
+	{
+		pScene->mpPillarCenters[i].x = ClampToCage(pScene, SceneRandomFloat(pRandom, -h, h), PillarRadius);
+		pScene->mpPillarCenters[i].y = ClampToCage(pScene, SceneRandomFloat(pRandom, -h, h), PillarRadius);
+		pScene->mpPillarRadii[i] = PillarRadius;
+	}
+	pScene->mPillarNum = pDesc->mPillarNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void GenerateClustered(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float Spacing, float PillarRadius)
+{
+	float h = pDesc->mHalfSize;
+	u32 obstacleNum = pDesc->mSegmentNum + pDesc->mPillarNum;
+	u32 clusterNum = 1 + (u32)sqrtf((float)obstacleNum) / 8;
+	float spread = h / (1.0f + sqrtf((float)clusterNum));
+	Vector2D pClusters[SCENE_CLUSTER_NUM_MAX];
+	u32 i;
+
+	clusterNum = SCENE_MIN(clusterNum, SCENE_CLUSTER_NUM_MAX);
+
+	for (i = 0; i < clusterNum; ++i)
+		Vector2DSet(&pClusters[i], SceneRandomFloat(pRandom, -0.75f * h, 0.75f * h), SceneRandomFloat(pRandom, -0.75f * h, 0.75f * h));
+
+	// Triangular distribution around the cluster centers, obstacles half as long as the uniform ones
+	for (i = SCENE_WALL_NUM; i < pDesc->mSegmentNum; ++i)
+	{
+		const Vector2D *pCenter = &pClusters[SceneRandomIndex(pRandom, clusterNum)];
+		float x = pCenter->x + spread * (SceneRandomFloat(pRandom, -0.5f, 0.5f) + SceneRandomFloat(pRandom, -0.5f, 0.5f));
+		float y = pCenter->y + spread * (SceneRandomFloat(pRandom, -0.5f, 0.5f) + SceneRandomFloat(pRandom, -0.5f, 0.5f));
+
+		AddRandomSegment(pScene, pRandom, x, y, 0.4f * Spacing);
+	}
+
+	for (i = 0; i < pDesc->mPillarNum; ++i)
+	{
+		const Vector2D *pCenter = &pClusters[SceneRandomIndex(pRandom, clusterNum)];
+		float x = pCenter->x + spread * (SceneRandomFloat(pRandom, -0.5f, 0.5f) + SceneRandomFloat(pRandom, -0.5f, 0.5f));
+		float y = pCenter->y + spread * (SceneRandomFloat(pRandom, -0.5f, 0.5f) + SceneRandomFloat(pRandom, -0.5f, 0.5f));
+
+		pScene->mpPillarCenters[i].x = ClampToCage(pScene, x, PillarRadius * 0.5f);
+		pScene->mpPillarCenters[i].y = ClampToCage(pScene, y, PillarRadius * 0.5f);
+		pScene->mpPillarRadii[i] = PillarRadius * 0.5f;
+	}
+	pScene->mPillarNum = pDesc->mPillarNum;
+}
+
+// ---------------------------------------------------------------------------
+
+int GenerateCorridors(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float PillarRadius)
+{
+	u32 n = GetMazeSize(SCENE_MAX(pDesc->mSegmentNum, SCENE_WALL_NUM) - SCENE_WALL_NUM);
+	float h = pDesc->mHalfSize;
+	float cellSize = 2.0f * h / n;
+	unsigned char *pOpenX, *pOpenY, *pVisited;
+	u32 *pStack;
+	u32 stackNum = 0;
+	u32 x, y, i;
+
+	// pOpenX[y * n + x]: wall between (x, y) and (x + 1, y) removed. pOpenY[y * n + x]: between (x, y) and (x, y + 1)
+	pOpenX = (unsigned char *)calloc(n * n, 1);
+	pOpenY = (unsigned char *)calloc(n * n, 1);
+	pVisited = (unsigned char *)calloc(n * n, 1);
+	pStack = (u32 *)malloc(sizeof(u32) * n * n);
+
+	if (0 == pOpenX || 0 == pOpenY || 0 == pVisited || 0 == pStack)
+	{
+		free(pOpenX);
+		free(pOpenY);
+		free(pVisited);
+		free(pStack);
+		return 0;
+	}
+
+	// Depth first carving from a random cell, with an explicit stack
+	pStack[stackNum++] = SceneRandomIndex(pRandom, n * n);
+	pVisited[pStack[0]] = 1;
+
+	while (stackNum > 0)
+	{
+		u32 cell = pStack[stackNum - 1];
+		u32 neighbors[4], neighborNum = 0, next;
+
+		x = cell % n;
+		y = cell / n;
+
+		if (x > 0 && 0 == pVisited[cell - 1])
+			neighbors[neighborNum++] = cell - 1;
+		if (x + 1 < n && 0 == pVisited[cell + 1])
+			neighbors[neighborNum++] = cell + 1;
+		if (y > 0 && 0 == pVisited[cell - n])
+			neighbors[neighborNum++] = cell - n;
+		if (y + 1 < n && 0 == pVisited[cell + n])
+			neighbors[neighborNum++] = cell + n;
+
+		if (0 == neighborNum)
+		{
+			--stackNum;
+			continue;
+		}
+
+		next = neighbors[SceneRandomIndex(pRandom, neighborNum)];
+
+		if (next == cell + 1)
+			pOpenX[cell] = 1;
+		else
+		if (next == cell - 1)
+			pOpenX[next] = 1;
+		else
+		if (next == cell + n)
+			pOpenY[cell] = 1;
+		else
+			pOpenY[next] = 1;
+
+		pVisited[next] = 1;
+		pStack[stackNum++] = next;
+	}
+
+	// The walls left standing, the border excluded since the cage already covers it
+	for (y = 0; y < n; ++y)
+	{
+		for (x = 0; x < n; ++x)
+		{
+			float x0 = -h + x * cellSize, y0 = -h + y * cellSize;
+
+			if (x + 1 < n && 0 == pOpenX[y * n + x])
+				AddSegment(pScene, x0 + cellSize, y0, x0 + cellSize, y0 + cellSize);
+			if (y + 1 < n && 0 == pOpenY[y * n + x])
+				AddSegment(pScene, x0, y0 + cellSize, x0 + cellSize, y0 + cellSize);
+		}
+	}
+
+	// Pillars in the middle of random cells, thin enough to leave the corridor open
+	PillarRadius = SCENE_MIN(PillarRadius, 0.2f * cellSize);
+
+	for (i = 0; i < pDesc->mPillarNum; ++i)
+	{
+		u32 cell = SceneRandomIndex(pRandom, n * n);
+
+		pScene->mpPillarCenters[i].x = -h + ((cell % n) + 0.5f) * cellSize;
+		pScene->mpPillarCenters[i].y = -h + ((cell / n) + 0.5f) * cellSize;
+		pScene->mpPillarRadii[i] = PillarRadius;
+	}
+	pScene->mPillarNum = pDesc->mPillarNum;
+
+	free(pOpenX);
+	free(pOpenY);
+	free(pVisited);
+	free(pStack);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void GenerateRings(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom, float PillarRadius)
+{
+	u32 wallNum = SCENE_MAX(pDesc->mSegmentNum, SCENE_WALL_NUM) - SCENE_WALL_NUM;
+	float h = pDesc->mHalfSize;
+	u32 ringNum, slotNum, ring, i;
+	float ringSpacing;
+
+	GetRingCounts(wallNum, &ringNum, &slotNum);
+	ringSpacing = h / (ringNum + 1);
+
+	for (ring = 0; ring < ringNum; ++ring)
+	{
+		u32 slots = GetRingSlots(ring, ringNum, wallNum);
+		u32 door = SceneRandomIndex(pRandom, SCENE_RING_DOOR_PERIOD);
+		float radius = ringSpacing * (ring + 1);
+		float phase = SceneRandomFloat(pRandom, 0.0f, 1.0f);
+		float s0, c0, s1, c1;
+
+		SinCos(phase * 2.0f * SCENE_PI, &s0, &c0, SINCOS_ACCURACY_1E7);
+
+		for (i = 0; i < slots; ++i)
+		{
+			SinCos((phase + (float)(i + 1) / slots) * 2.0f * SCENE_PI, &s1, &c1, SINCOS_ACCURACY_1E7);
+
+			if (i % SCENE_RING_DOOR_PERIOD != door)
+				AddSegment(pScene, radius * c0, radius * s0, radius * c1, radius * s1);
+
+			s0 = s1;
+			c0 = c1;
+		}
+	}
+
+	// Pillars halfway between 2 rings (or inside the first one), never touching them
+	PillarRadius = SCENE_MIN(PillarRadius, 0.25f * ringSpacing);
+
+	for (i = 0; i < pDesc->mPillarNum; ++i)
+	{
+		float radius = ringSpacing * (SceneRandomIndex(pRandom, ringNum) + 0.5f);
+		float s, c;
+
+		SinCos(SceneRandomFloat(pRandom, 0.0f, 1.0f) * 2.0f * SCENE_PI, &s, &c, SINCOS_ACCURACY_1E7);
+
+		pScene->mpPillarCenters[i].x = radius * c;
+		pScene->mpPillarCenters[i].y = radius * s;
+		pScene->mpPillarRadii[i] = PillarRadius;
+	}
+	pScene->mPillarNum = pDesc->mPillarNum;
+}
+
+// ---------------------------------------------------------------------------
+
+int PlaceBalls(CageScene *pScene, const CageSceneDesc *pDesc, SceneRandom *pRandom)
+{
+	ObstacleGrid grid;
+	float r = pDesc->mBallRadius;
+	float limit = pDesc->mHalfSize - r;
+	u32 i, tries;
+
+	// Binned with the ball radius as margin, so only the ball's own cell needs checking
+	if (0 == ObstacleGridBuild(&grid, pScene->mpSegments, pScene->mSegmentNum, pScene->mpPillarCenters, pScene->mpPillarRadii, pScene->mPillarNum, 0.0f, r))
+		return 0;
+
+	for (i = 0; i < pDesc->mBallNum; ++i)
+	{
+		Vector2D *pPosition = &pScene->mpBallPositions[pScene->mBallNum];
+		Vector2D direction;
+
+		for (tries = 0; tries < SCENE_PLACEMENT_TRIES; ++tries)
+		{
+			pPosition->x = SceneRandomFloat(pRandom, -limit, limit);
+			pPosition->y = SceneRandomFloat(pRandom, -limit, limit);
+
+			if (0 == BallOverlaps(&grid, pPosition->x, pPosition->y, r))
+				break;
+		}
+
+		// Drawn even when the ball is dropped, so the next balls don't depend on it
+		SceneRandomDirection(pRandom, &direction);
+
+		if (SCENE_PLACEMENT_TRIES == tries)
+			continue;
+
+		Vector2DScale(&pScene->mpBallVelocities[pScene->mBallNum], &direction, pDesc->mBallSpeed);
+		pScene->mpBallRadii[pScene->mBallNum] = r;
+		++pScene->mBallNum;
+	}
+
+	ObstacleGridFree(&grid);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int BallOverlaps(const ObstacleGrid *pGrid, float x, float y, float Radius)
+{
+	s32 cell = ObstacleGridCellY(pGrid, y) * pGrid->mCellsX + ObstacleGridCellX(pGrid, x);
+	float radiusSquare = Radius * Radius;
+	u32 i;
+
+	// Padding slots are far away, so they never overlap
+	for (i = pGrid->mpSegmentStart[cell]; i < pGrid->mpSegmentStart[cell + 1]; ++i)
+	{
+		float ex = pGrid->mpSegmentDX[i], ey = pGrid->mpSegmentDY[i];
+		float wx = x - pGrid->mpSegmentX0[i], wy = y - pGrid->mpSegmentY0[i];
+		float lengthSquare = ex * ex + ey * ey;
+		float t = (lengthSquare > 0.0f) ? (wx * ex + wy * ey) / lengthSquare : 0.0f;
+		float dx, dy;
+
+		t = SCENE_MAX(0.0f, SCENE_MIN(t, 1.0f));
+		dx = wx - t * ex;
+		dy = wy - t * ey;
+
+		if (dx * dx + dy * dy <= radiusSquare)
+			return 1;
+	}
+
+	for (i = pGrid->mpCircleStart[cell]; i < pGrid->mpCircleStart[cell + 1]; ++i)
+	{
+		float dx = x - pGrid->mpCircleX[i], dy = y - pGrid->mpCircleY[i];
+		float reach = Radius + sqrtf(SCENE_MAX(pGrid->mpCircleR2[i], 0.0f));
+
+		if (dx * dx + dy * dy <= reach * reach)
+			return 1;
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageScene.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the seeded procedural stress scenes
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef CAGE_SCENE_H
+#define CAGE_SCENE_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+#include "Vector2D.h"
+#include "LineSegment2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+enum CAGE_SCENE_LAYOUT
+{
+	CAGE_SCENE_LAYOUT_UNIFORM,				// Obstacles scattered over the whole cage
+	CAGE_SCENE_LAYOUT_CLUSTERED,			// Obstacles packed around a few random centers
+	CAGE_SCENE_LAYOUT_CORRIDORS,			// A perfect maze: every cell reachable, one path between any 2 cells
+	CAGE_SCENE_LAYOUT_RINGS,				// Concentric rings with doors, pillars between the rings
+
+	// Keep this one last
+	CAGE_SCENE_LAYOUT_NUM
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct CageSceneDesc
+{
+	u32					mSeed;
+	u32					mLayout;				// From the CAGE_SCENE_LAYOUT enum
+	u32					mSegmentNum;			// Including the 4 walls of the cage
+	u32					mPillarNum;
+	u32					mBallNum;
+	float				mHalfSize;				// The cage is the square [-mHalfSize, mHalfSize]
+	float				mBallRadius;
+	float				mBallSpeed;
+	float				mPillarRadius;			// 0 picks one from the obstacle density
+}CageSceneDesc;
+
+// ---------------------------------------------------------------------------
+
+typedef struct CageScene
+{
+	LineSegment2D		*mpSegments;
+	u32					mSegmentNum;
+
+	Vector2D			*mpPillarCenters;
+	float				*mpPillarRadii;
+	u32					mPillarNum;
+
+	Vector2D			*mpBallPositions;
+	Vector2D			*mpBallVelocities;
+	float				*mpBallRadii;
+	u32					mBallNum;
+
+	float				mHalfSize;
+}CageScene;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Fills pDesc with a small uniform scene: 64 segments, 16 pillars, 16 balls
+void CageSceneDescDefault(CageSceneDesc *pDesc);
+
+/*
+Generates the scene described by pDesc. The same description always gives the
+same scene, bit for bit: the generator has its own random number generator, and
+its own sine and cosine for the rings.
+
+The uniform and clustered layouts hit the requested counts exactly. The corridors
+and rings round the segment count to their structure, so check pScene->mSegmentNum.
+Balls never start overlapping an obstacle: the ones that do are moved, and the
+ones that can't find a free spot after a few tries are dropped.
+
+ - Returns 1 on success, 0 if an allocation failed
+*/
+int CageSceneGenerate(CageScene *pScene, const CageSceneDesc *pDesc);
+void CageSceneFree(CageScene *pScene);
+
+// FNV-1a hash of every generated value, to check that 2 scenes are the same
+u64 CageSceneHash(const CageScene *pScene);
+
+// ---------------------------------------------------------------------------
+
+#endif // CAGE_SCENE_H
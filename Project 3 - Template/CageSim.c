@@ -0,0 +1,382 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageSim.c
+// Creation Date	:	2026/10/19
+// Purpose			:	headless multi-ball cage simulation: obstacle grid broad
+//						phase, Math2D narrow phase, spatial hash ball contacts
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <xmmintrin.h>
+
+#include "CageSim.h"
+#include "Math2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define SIM_MIN(a, b)		((a) < (b) ? (a) : (b))
+#define SIM_MAX(a, b)		((a) > (b) ? (a) : (b))
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// The earliest obstacle hit by a ball's motion
+typedef struct
+{
+	float		mT;							// -1 if nothing was hit
+	Vector2D	mIntersection;				// Center of the ball at the contact
+	Vector2D	mNormal;					// Unit normal at the contact, towards the ball
+}SweepHit;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void CollideBall(const CageSim *pSim, CageSimWorker *pWorker, u32 Ball, Vector2D *pVelocity);
+static void Sweep(const CageSim *pSim, CageSimWorker *pWorker, Vector2D *pStart, Vector2D *pEnd, float Radius, SweepHit *pHit);
+static void SweepCell(const CageSim *pSim, CageSimWorker *pWorker, s32 Cell, Vector2D *pStart, Vector2D *pEnd, float Radius, SweepHit *pHit);
+static void NextStamp(const CageSim *pSim, CageSimWorker *pWorker);
+static void* CopyArray(const void *pSource, size_t Size);
+
+// ---------------------------------------------------------------------------
+
+int CageSimInit(CageSim *pSim, const CageScene *pScene)
+{
+	u32 i, ballNum = SIM_MAX(pScene->mBallNum, 1);
+
+	memset(pSim, 0, sizeof(CageSim));
+
+	pSim->mpSegments = (LineSegment2D *)CopyArray(pScene->mpSegments, sizeof(LineSegment2D) * pScene->mSegmentNum);
+	pSim->mSegmentNum = pScene->mSegmentNum;
+	pSim->mpPillarCenters = (Vector2D *)CopyArray(pScene->mpPillarCenters, sizeof(Vector2D) * pScene->mPillarNum);
+	pSim->mpPillarRadii = (float *)CopyArray(pScene->mpPillarRadii, sizeof(float) * pScene->mPillarNum);
+	pSim->mPillarNum = pScene->mPillarNum;
+
+	pSim->mpBalls = (CageSimBall *)_mm_malloc(sizeof(CageSimBall) * ballNum, CAGE_SIM_ALIGNMENT);
+	pSim->mpNextBalls = (CageSimBall *)_mm_malloc(sizeof(CageSimBall) * ballNum, CAGE_SIM_ALIGNMENT);
+	pSim->mpRadii = (float *)CopyArray(pScene->mpBallRadii, sizeof(float) * pScene->mBallNum);
+	pSim->mBallNum = pScene->mBallNum;
+	pSim->mBallCollisions = 1;
+
+	if (0 == pSim->mpSegments || 0 == pSim->mpPillarCenters || 0 == pSim->mpPillarRadii ||
+		0 == pSim->mpBalls || 0 == pSim->mpNextBalls || 0 == pSim->mpRadii ||
+		0 == LineSegment2DArrayInit(&pSim->mSegments, pSim->mpSegments, pSim->mSegmentNum))
+	{
+		CageSimFree(pSim);
+		return 0;
+	}
+
+	for (i = 0; i < pSim->mBallNum; ++i)
+	{
+		pSim->mpBalls[i].mPosition = pScene->mpBallPositions[i];
+		pSim->mpBalls[i].mVelocity = pScene->mpBallVelocities[i];
+		pSim->mRadiusMax = SIM_MAX(pSim->mRadiusMax, pSim->mpRadii[i]);
+	}
+
+	// Anything a ball can touch is binned in every cell its center can be in
+	if (0 == ObstacleGridBuild(&pSim->mGrid, pSim->mpSegments, pSim->mSegmentNum, pSim->mpPillarCenters, pSim->mpPillarRadii, pSim->mPillarNum, 0.0f, pSim->mRadiusMax))
+	{
+		CageSimFree(pSim);
+		return 0;
+	}
+
+	// Cells as wide as the contact query: it overlaps 2 x 2 cells rather than 3 x 3
+	if (0 == SpatialHashInit(&pSim->mHash, SIM_MAX(4.0f * pSim->mRadiusMax, 1.0f), ballNum))
+	{
+		CageSimFree(pSim);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimFree(CageSim *pSim)
+{
+	ObstacleGridFree(&pSim->mGrid);
+	SpatialHashFree(&pSim->mHash);
+	LineSegment2DArrayFree(&pSim->mSegments);
+
+	free(pSim->mpSegments);
+	free(pSim->mpPillarCenters);
+	free(pSim->mpPillarRadii);
+	free(pSim->mpRadii);
+
+	if (pSim->mpBalls)
+		_mm_free(pSim->mpBalls);
+	if (pSim->mpNextBalls)
+		_mm_free(pSim->mpNextBalls);
+
+	memset(pSim, 0, sizeof(CageSim));
+}
+
+// ---------------------------------------------------------------------------
+
+int CageSimWorkerInit(CageSimWorker *pWorker, const CageSim *pSim)
+{
+	memset(pWorker, 0, sizeof(CageSimWorker));
+
+	pWorker->mpSegmentStamps = (u32 *)calloc(SIM_MAX(pSim->mSegmentNum, 1), sizeof(u32));
+	pWorker->mpPillarStamps = (u32 *)calloc(SIM_MAX(pSim->mPillarNum, 1), sizeof(u32));
+
+	if (0 == pWorker->mpSegmentStamps || 0 == pWorker->mpPillarStamps)
+	{
+		CageSimWorkerFree(pWorker);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimWorkerFree(CageSimWorker *pWorker)
+{
+	free(pWorker->mpSegmentStamps);
+	free(pWorker->mpPillarStamps);
+
+	memset(pWorker, 0, sizeof(CageSimWorker));
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimStep(CageSim *pSim, CageSimWorker *pWorker, float Dt)
+{
+	CageSimBeginStep(pSim);
+	CageSimStepBalls(pSim, pWorker, Dt, 0, pSim->mBallNum);
+	CageSimEndStep(pSim);
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimBeginStep(CageSim *pSim)
+{
+	if (pSim->mBallCollisions)
+		SpatialHashBuildStrided(&pSim->mHash, &pSim->mpBalls[0].mPosition, sizeof(CageSimBall), pSim->mBallNum);
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimStepBalls(const CageSim *pSim, CageSimWorker *pWorker, float Dt, u32 First, u32 Num)
+{
+	u32 i, last = SIM_MIN(First + Num, pSim->mBallNum);
+
+	for (i = First; i < last; ++i)
+	{
+		Vector2D start = pSim->mpBalls[i].mPosition;
+		Vector2D velocity = pSim->mpBalls[i].mVelocity;
+		float radius = pSim->mpRadii[i];
+		float remaining = Dt;
+		Vector2D end;
+		SweepHit hit;
+		u32 bounce;
+
+		if (pSim->mBallCollisions)
+			CollideBall(pSim, pWorker, i, &velocity);
+
+		Vector2DScaleAdd(&end, &velocity, &start, Dt);
+
+		// Like the game's ball, but the reflected motion is swept too, so corners can't be skipped
+		for (bounce = 0; bounce < CAGE_SIM_BOUNCE_MAX; ++bounce)
+		{
+			Sweep(pSim, pWorker, &start, &end, radius, &hit);
+
+			if (hit.mT <= 0.0f)
+				break;
+
+			// v - 2(v.n)n: the direction the Reflect kernels would give, at the same speed, without normalizing anything
+			Vector2DScaleAdd(&velocity, &hit.mNormal, &velocity, -2.0f * Vector2DDotProduct(&velocity, &hit.mNormal));
+			remaining *= 1.0f - hit.mT;
+
+			// Off the contact by a hair: the kernels miss a ball that starts inside the radius, even by a rounding error
+			Vector2DScaleAdd(&start, &hit.mNormal, &hit.mIntersection, CAGE_SIM_SKIN * radius);
+			Vector2DScaleAdd(&end, &velocity, &start, remaining);
+			++pWorker->mObstacleHitNum;
+		}
+
+		// Out of bounces: stop at the last contact rather than risk going through
+		if (CAGE_SIM_BOUNCE_MAX == bounce)
+			end = start;
+
+		pSim->mpNextBalls[i].mPosition = end;
+		pSim->mpNextBalls[i].mVelocity = velocity;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void CageSimEndStep(CageSim *pSim)
+{
+	CageSimBall *pSwap = pSim->mpBalls;
+
+	pSim->mpBalls = pSim->mpNextBalls;
+	pSim->mpNextBalls = pSwap;
+
+	++pSim->mStepNum;
+}
+
+// ---------------------------------------------------------------------------
+
+u64 CageSimHash(const CageSim *pSim)
+{
+	const unsigned char *pBytes = (const unsigned char *)pSim->mpBalls;
+	u64 hash = 14695981039346656037ULL;
+	size_t i, size = sizeof(CageSimBall) * pSim->mBallNum;
+
+	for (i = 0; i < size; ++i)
+		hash = (hash ^ pBytes[i]) * 1099511628211ULL;
+
+	return hash;
+}
+
+// ---------------------------------------------------------------------------
+
+void CollideBall(const CageSim *pSim, CageSimWorker *pWorker, u32 Ball, Vector2D *pVelocity)
+{
+	const Vector2D *pPosition = &pSim->mpBalls[Ball].mPosition;
+	float radius = pSim->mpRadii[Ball];
+	u32 i, num;
+
+	num = SpatialHashQuery(&pSim->mHash, pPosition, radius + pSim->mRadiusMax, pWorker->mNeighbors, CAGE_SIM_NEIGHBOR_MAX);
+	num = SIM_MIN(num, CAGE_SIM_NEIGHBOR_MAX);
+
+	for (i = 0; i < num; ++i)
+	{
+		const CageSimBall *pOther = &pSim->mpBalls[pWorker->mNeighbors[i]];
+		Vector2D d, dv;
+		float reach, distanceSquare, approach;
+
+		if (pWorker->mNeighbors[i] == Ball)
+			continue;
+
+		Vector2DSub(&d, (Vector2D *)&pOther->mPosition, (Vector2D *)pPosition);
+		reach = radius + pSim->mpRadii[pWorker->mNeighbors[i]];
+		distanceSquare = Vector2DSquareLength(&d);
+
+		if (distanceSquare >= reach * reach || distanceSquare <= 0.0f)
+			continue;
+
+		// Only the balls closing in: the ones moving apart are already resolved
+		Vector2DSub(&dv, (Vector2D *)&pOther->mVelocity, pVelocity);
+		approach = Vector2DDotProduct(&dv, &d);
+
+		if (approach >= 0.0f)
+			continue;
+
+		// Equal masses: swap the velocity components along the normal. The other ball does the same on its side
+		Vector2DScaleAdd(pVelocity, &d, pVelocity, approach / distanceSquare);
+		++pWorker->mBallContactNum;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void Sweep(const CageSim *pSim, CageSimWorker *pWorker, Vector2D *pStart, Vector2D *pEnd, float Radius, SweepHit *pHit)
+{
+	const ObstacleGrid *pGrid = &pSim->mGrid;
+	s32 x, y, x0, x1, y0, y1;
+
+	// Every cell the center's motion can cross
+	x0 = ObstacleGridCellX(pGrid, SIM_MIN(pStart->x, pEnd->x));
+	x1 = ObstacleGridCellX(pGrid, SIM_MAX(pStart->x, pEnd->x));
+	y0 = ObstacleGridCellY(pGrid, SIM_MIN(pStart->y, pEnd->y));
+	y1 = ObstacleGridCellY(pGrid, SIM_MAX(pStart->y, pEnd->y));
+
+	pHit->mT = -1.0f;
+	NextStamp(pSim, pWorker);
+
+	for (y = y0; y <= y1; ++y)
+		for (x = x0; x <= x1; ++x)
+			SweepCell(pSim, pWorker, y * pGrid->mCellsX + x, pStart, pEnd, Radius, pHit);
+}
+
+// ---------------------------------------------------------------------------
+
+void SweepCell(const CageSim *pSim, CageSimWorker *pWorker, s32 Cell, Vector2D *pStart, Vector2D *pEnd, float Radius, SweepHit *pHit)
+{
+	const ObstacleGrid *pGrid = &pSim->mGrid;
+	const LineSegment2DArray *pSegments = &pSim->mSegments;
+	Vector2D intersection;
+	u32 i;
+
+	for (i = pGrid->mpSegmentStart[Cell]; i < pGrid->mpSegmentStart[Cell + 1]; ++i)
+	{
+		u32 id = pGrid->mpSegmentIds[i];
+		float t;
+
+		// Padding, or already tested from another cell
+		if (OBSTACLE_GRID_PAD_ID == id || pWorker->mpSegmentStamps[id] == pWorker->mStamp)
+			continue;
+		pWorker->mpSegmentStamps[id] = pWorker->mStamp;
+
+		t = AnimatedCircleToStaticLineSegmentSplit(pStart, pEnd, Radius, &pSegments->mpPlanes[id], &pSegments->mpEnds[id], &intersection);
+
+		if (t > 0.0f && (t < pHit->mT || pHit->mT < 0.0f))
+		{
+			const LineSegment2DPlane *pPlane = &pSegments->mpPlanes[id];
+
+			pHit->mT = t;
+			pHit->mIntersection = intersection;
+			pHit->mNormal = pPlane->mN;
+
+			// Facing the ball
+			if (Vector2DDotProduct((Vector2D *)&pPlane->mN, pStart) - pPlane->mNdotP0 < 0.0f)
+				Vector2DNeg(&pHit->mNormal, &pHit->mNormal);
+		}
+	}
+
+	for (i = pGrid->mpCircleStart[Cell]; i < pGrid->mpCircleStart[Cell + 1]; ++i)
+	{
+		u32 id = pGrid->mpCircleIds[i];
+		float t;
+
+		if (OBSTACLE_GRID_PAD_ID == id || pWorker->mpPillarStamps[id] == pWorker->mStamp)
+			continue;
+		pWorker->mpPillarStamps[id] = pWorker->mStamp;
+
+		t = AnimatedCircleToStaticCircle(pStart, pEnd, Radius, &pSim->mpPillarCenters[id], pSim->mpPillarRadii[id], &intersection);
+
+		if (t > 0.0f && (t < pHit->mT || pHit->mT < 0.0f))
+		{
+			pHit->mT = t;
+			pHit->mIntersection = intersection;
+
+			// At the contact, the centers are exactly the 2 radii apart
+			Vector2DSub(&pHit->mNormal, &intersection, &pSim->mpPillarCenters[id]);
+			Vector2DScale(&pHit->mNormal, &pHit->mNormal, 1.0f / (Radius + pSim->mpPillarRadii[id]));
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void NextStamp(const CageSim *pSim, CageSimWorker *pWorker)
+{
+	// Once every 4 billion balls, the stamps wrap around and the old ones must go
+	if (0 == ++pWorker->mStamp)
+	{
+		memset(pWorker->mpSegmentStamps, 0, sizeof(u32) * SIM_MAX(pSim->mSegmentNum, 1));
+		memset(pWorker->mpPillarStamps, 0, sizeof(u32) * SIM_MAX(pSim->mPillarNum, 1));
+		pWorker->mStamp = 1;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void* CopyArray(const void *pSource, size_t Size)
+{
+	// Never 0 bytes, so an empty array isn't mistaken for a failed allocation
+	void *pCopy = malloc(Size > 0 ? Size : 1);
+
+	if (pCopy && Size > 0)
+		memcpy(pCopy, pSource, Size);
+
+	return pCopy;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CageSim.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the headless multi-ball cage simulation
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef CAGE_SIM_H
+#define CAGE_SIM_H
+
+// ---------------------------------------------------------------------------
+
+#include "CageScene.h"
+#include "ObstacleGrid.h"
+#include "SpatialHash.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define CAGE_SIM_NEIGHBOR_MAX			64					// Balls touching more balls than this ignore the extra ones
+#define CAGE_SIM_BOUNCE_MAX				4					// Obstacle hits per ball per step. The ball stops at the last one
+#define CAGE_SIM_SKIN					0.001f				// Gap left between a ball and what it bounced off, in radii
+#define CAGE_SIM_ALIGNMENT				64					// Of the hot arrays: one cache line
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// Hot ball state: read and written by every step, and read by the neighbors' contact tests. 4 per cache line
+typedef struct CageSimBall
+{
+	Vector2D			mPosition;
+	Vector2D			mVelocity;
+}CageSimBall;
+
+// ---------------------------------------------------------------------------
+
+/*
+The cage game's ball update, for any number of balls and obstacles, without the
+engine. Every step, each ball:
+	- bounces off the balls it overlaps and is moving towards (equal masses)
+	- sweeps against the obstacles binned in the cells its motion covers, with the
+	  Math2D animated circle kernels, bounces off the first one hit like the game's
+	  ball, and sweeps the rest of the motion again, up to CAGE_SIM_BOUNCE_MAX times
+
+The data is split hot and cold. The sweeps read the segments' line equations from
+a LineSegment2DArray, and their endpoints only once a line is crossed. A ball's
+position and velocity share one CageSimBall, so a contact test reads one cache
+line per neighbor; the radii, which never change, are apart.
+
+The hot ball array is double buffered: a step only reads the current array and
+only writes ball i's slot of the next array, so disjoint ball ranges can be
+stepped concurrently, one worker each
+*/
+typedef struct CageSim
+{
+	// Obstacles, copied from the scene
+	LineSegment2D		*mpSegments;			// Only for the grid
+	LineSegment2DArray	mSegments;				// For the sweeps
+	u32					mSegmentNum;
+	Vector2D			*mpPillarCenters;
+	float				*mpPillarRadii;
+	u32					mPillarNum;
+	ObstacleGrid		mGrid;					// Margin: the biggest ball radius
+
+	// Balls
+	CageSimBall			*mpBalls;				// Hot, CAGE_SIM_ALIGNMENT aligned
+	CageSimBall			*mpNextBalls;
+	float				*mpRadii;				// Cold
+	u32					mBallNum;
+	float				mRadiusMax;
+
+	int					mBallCollisions;		// 0: the balls go through each other, and the hash isn't built
+	SpatialHash			mHash;					// Ball centers at the start of the step
+	u64					mStepNum;
+}CageSim;
+
+// ---------------------------------------------------------------------------
+
+// Per thread scratch
+typedef struct CageSimWorker
+{
+	u32					*mpSegmentStamps;		// Obstacles already tested by the current ball
+	u32					*mpPillarStamps;
+	u32					mStamp;
+	u32					mNeighbors[CAGE_SIM_NEIGHBOR_MAX];
+
+	// Since the worker was initialized
+	u64					mObstacleHitNum;
+	u64					mBallContactNum;
+}CageSimWorker;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Copies the scene's obstacles and balls, and builds the obstacle grid.
+The scene can be freed right after.
+
+ - Returns 1 on success, 0 if an allocation failed
+*/
+int CageSimInit(CageSim *pSim, const CageScene *pScene);
+void CageSimFree(CageSim *pSim);
+
+int CageSimWorkerInit(CageSimWorker *pWorker, const CageSim *pSim);
+void CageSimWorkerFree(CageSimWorker *pWorker);
+
+// A whole step on the calling thread
+void CageSimStep(CageSim *pSim, CageSimWorker *pWorker, float Dt);
+
+/*
+The same step, in 3 phases for callers splitting the balls across threads:
+	- CageSimBeginStep, once: rebuilds the ball hash
+	- CageSimStepBalls, for every range: [First, First + Num), with a worker used by no other thread
+	- CageSimEndStep, once all the ranges are done: swaps the ball buffers
+*/
+void CageSimBeginStep(CageSim *pSim);
+void CageSimStepBalls(const CageSim *pSim, CageSimWorker *pWorker, float Dt, u32 First, u32 Num);
+void CageSimEndStep(CageSim *pSim);
+
+// FNV-1a hash of the balls' positions and velocities, to compare 2 runs
+u64 CageSimHash(const CageSim *pSim);
+
+// ---------------------------------------------------------------------------
+
+#endif // CAGE_SIM_H
@@ -0,0 +1,148 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CollisionStats.c
+// Creation Date	:	2026/10/19
+// Purpose			:	per-frame and running collision statistics
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include "CollisionStats.h"
+
+// ---------------------------------------------------------------------------
+// Variables
+
+CollisionStatsThread		gCollisionStatsThreads[JOB_THREAD_NUM_MAX];		// Frame being counted, per thread
+
+static CollisionStats		sgCollisionStatsLast;				// Last completed frame
+static CollisionStats		sgCollisionStatsTotals;
+
+static const char *sgEarlyOutNames[COLLISION_EARLY_OUT_NUM] =
+{
+	"no motion",
+	"same side",
+	"parallel",
+	"time range",
+	"outside segment",
+	"miss distance",
+	"moving away",
+	"no root",
+	"separating axis",
+	"overlapping",
+};
+
+// ---------------------------------------------------------------------------
+
+void CollisionStatsReset(void)
+{
+	memset(gCollisionStatsThreads, 0, sizeof(gCollisionStatsThreads));
+	memset(&sgCollisionStatsLast, 0, sizeof(CollisionStats));
+	memset(&sgCollisionStatsTotals, 0, sizeof(CollisionStats));
+}
+
+// ---------------------------------------------------------------------------
+
+void CollisionStatsFrameBegin(void)
+{
+	// Only the slots of the running workers can have counted
+	memset(gCollisionStatsThreads, 0, sizeof(CollisionStatsThread) * (JobSystemGetWorkerNum() + 1));
+}
+
+// ---------------------------------------------------------------------------
+
+void CollisionStatsFrameEnd(void)
+{
+	CollisionStats frame;
+	u32 *pFrame, *pThread, *pTotals;
+	u32 t, threadNum = JobSystemGetWorkerNum() + 1;
+	unsigned int i;
+
+	// Every field is a u32 counter
+	memset(&frame, 0, sizeof(CollisionStats));
+	pFrame = (u32 *)&frame;
+	pTotals = (u32 *)&sgCollisionStatsTotals;
+
+	for (t = 0; t < threadNum; ++t)
+	{
+		pThread = (u32 *)&gCollisionStatsThreads[t].mStats;
+
+		for (i = 0; i < sizeof(CollisionStats) / sizeof(u32); ++i)
+			pFrame[i] += pThread[i];
+	}
+
+	frame.mFrames = 1;
+	frame.mMultiHitFrames = (frame.mMultiHitBalls > 0) ? 1 : 0;
+
+	for (i = 0; i < sizeof(CollisionStats) / sizeof(u32); ++i)
+		pTotals[i] += pFrame[i];
+
+	sgCollisionStatsLast = frame;
+}
+
+// ---------------------------------------------------------------------------
+
+const CollisionStats* CollisionStatsGetFrame(void)
+{
+	return &sgCollisionStatsLast;
+}
+
+// ---------------------------------------------------------------------------
+
+const CollisionStats* CollisionStatsGetTotals(void)
+{
+	return &sgCollisionStatsTotals;
+}
+
+// ---------------------------------------------------------------------------
+
+float CollisionStatsGetAverageCandidates(const CollisionStats *pStats)
+{
+	return pStats->mBalls ? (float)pStats->mCandidates / pStats->mBalls : 0.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+float CollisionStatsGetBroadPhaseEfficiency(const CollisionStats *pStats)
+{
+	u32 tests = 0, hits = 0;
+	unsigned int i;
+
+	for (i = 0; i < COLLISION_OBSTACLE_NUM; ++i)
+	{
+		tests += pStats->mTests[i];
+		hits += pStats->mHits[i];
+	}
+
+	return tests ? (float)hits / tests : 0.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+float CollisionStatsGetCullRatio(const CollisionStats *pStats)
+{
+	return pStats->mObstacles ? 1.0f - (float)pStats->mCandidates / pStats->mObstacles : 0.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+void CollisionStatsPrint(const char *pLabel, const CollisionStats *pStats)
+{
+	unsigned int i;
+
+	printf("%s: %lu frames (%lu multi-hit), %lu balls (%lu multi-hit)\n", pLabel,
+		(unsigned long)pStats->mFrames, (unsigned long)pStats->mMultiHitFrames,
+		(unsigned long)pStats->mBalls, (unsigned long)pStats->mMultiHitBalls);
+	printf("  tests: %lu segments, %lu circles, %lu polygons - hits: %lu segments, %lu circles, %lu polygons\n",
+		(unsigned long)pStats->mTests[COLLISION_OBSTACLE_LINE_SEGMENT], (unsigned long)pStats->mTests[COLLISION_OBSTACLE_CIRCLE], (unsigned long)pStats->mTests[COLLISION_OBSTACLE_CONVEX_POLYGON],
+		(unsigned long)pStats->mHits[COLLISION_OBSTACLE_LINE_SEGMENT], (unsigned long)pStats->mHits[COLLISION_OBSTACLE_CIRCLE], (unsigned long)pStats->mHits[COLLISION_OBSTACLE_CONVEX_POLYGON]);
+	printf("  candidates/ball: %.2f, broad-phase efficiency: %.4f, cull ratio: %.4f\n",
+		CollisionStatsGetAverageCandidates(pStats), CollisionStatsGetBroadPhaseEfficiency(pStats), CollisionStatsGetCullRatio(pStats));
+
+	for (i = 0; i < COLLISION_EARLY_OUT_NUM; ++i)
+		printf("  early out (%s): %lu\n", sgEarlyOutNames[i], (unsigned long)pStats->mEarlyOuts[i]);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	CollisionStats.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the per-frame collision statistics
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef COLLISION_STATS_H
+#define COLLISION_STATS_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+#include "JobSystem.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define COLLISION_STATS_ENABLED			1					// Set this to 0 to compile the counters out
+#define COLLISION_STATS_CACHE_LINE		64
+
+// ---------------------------------------------------------------------------
+
+enum COLLISION_OBSTACLE
+{
+	COLLISION_OBSTACLE_LINE_SEGMENT,
+	COLLISION_OBSTACLE_CIRCLE,
+	COLLISION_OBSTACLE_CONVEX_POLYGON,
+
+	// Keep this one last
+	COLLISION_OBSTACLE_NUM
+};
+
+// ---------------------------------------------------------------------------
+
+// Why a narrow-phase test rejected the obstacle
+enum COLLISION_EARLY_OUT
+{
+	COLLISION_EARLY_OUT_NO_MOTION,				// Start and end positions are the same
+	COLLISION_EARLY_OUT_SAME_SIDE,				// Line segment: both positions on the same side of the (offset) line
+	COLLISION_EARLY_OUT_PARALLEL,				// Line segment: motion parallel to the line
+	COLLISION_EARLY_OUT_TIME_RANGE,				// Intersection time outside [0, 1]
+	COLLISION_EARLY_OUT_OUTSIDE_SEGMENT,		// Line segment: the line is hit outside the end points. Convex polygon: the corner is missed
+	COLLISION_EARLY_OUT_MISS_DISTANCE,			// Circle, convex polygon: the motion passes too far from the (bounding) circle
+	COLLISION_EARLY_OUT_MOVING_AWAY,			// Circle: moving away from a circle it starts outside of
+	COLLISION_EARLY_OUT_NO_ROOT,				// Circle: negative discriminant
+	COLLISION_EARLY_OUT_SEPARATING_AXIS,		// Convex polygon: an edge normal or the motion's normal separates the swept circle
+	COLLISION_EARLY_OUT_OVERLAPPING,			// Convex polygon: already overlapping at the start
+
+	// Keep this one last
+	COLLISION_EARLY_OUT_NUM
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct CollisionStats
+{
+	u32		mTests[COLLISION_OBSTACLE_NUM];				// Narrow-phase tests per obstacle type
+	u32		mHits[COLLISION_OBSTACLE_NUM];				// Tests that returned an intersection
+	u32		mEarlyOuts[COLLISION_EARLY_OUT_NUM];
+
+	u32		mBalls;										// Balls stepped
+	u32		mObstacles;									// Obstacles in the level, summed over the stepped balls
+	u32		mCandidates;								// Obstacles handed to the narrow phase, summed over the stepped balls
+	u32		mMultiHitBalls;								// Balls that hit more than one obstacle in a step
+
+	u32		mFrames;
+	u32		mMultiHitFrames;							// Frames with at least one multi-hit ball
+}CollisionStats;
+
+// One thread's counters, rounded up to whole cache lines plus one: the counters of 2 threads
+// never share a line, wherever the array starts
+typedef union CollisionStatsThread
+{
+	CollisionStats	mStats;
+	u8				mPad[(sizeof(CollisionStats) / COLLISION_STATS_CACHE_LINE + 2) * COLLISION_STATS_CACHE_LINE];
+}CollisionStatsThread;
+
+// ---------------------------------------------------------------------------
+// Counting macros, used by the Math2D kernels and the game states.
+// Every thread counts in its own slot, indexed by JobGetThreadIndex: the threads
+// outside the job system share slot 0, so only count from one of them at a time
+
+#if(COLLISION_STATS_ENABLED)
+
+extern CollisionStatsThread gCollisionStatsThreads[JOB_THREAD_NUM_MAX];
+
+#define COLLISION_STAT_ADD(field, n)		(gCollisionStatsThreads[JobGetThreadIndex()].mStats.field += (n))
+#define COLLISION_STAT_INC(field)			(++gCollisionStatsThreads[JobGetThreadIndex()].mStats.field)
+
+#else
+
+#define COLLISION_STAT_ADD(field, n)		((void)0)
+#define COLLISION_STAT_INC(field)			((void)0)
+
+#endif
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Zeroes the current frame and the running totals
+void CollisionStatsReset(void);
+
+// Call around every simulation frame, while no job is counting.
+// FrameBegin zeroes every thread's counters, FrameEnd merges them into the frame and adds it to the running totals
+void CollisionStatsFrameBegin(void);
+void CollisionStatsFrameEnd(void);
+
+// Last completed frame, and running totals since the last reset
+const CollisionStats* CollisionStatsGetFrame(void);
+const CollisionStats* CollisionStatsGetTotals(void);
+
+// Narrow-phase tests per stepped ball
+float CollisionStatsGetAverageCandidates(const CollisionStats *pStats);
+
+// Fraction of the narrow-phase tests that found an intersection
+float CollisionStatsGetBroadPhaseEfficiency(const CollisionStats *pStats);
+
+// Fraction of the obstacles the broad phase kept away from the narrow phase
+float CollisionStatsGetCullRatio(const CollisionStats *pStats);
+
+// Prints "pStats" to the console, prefixed by "pLabel"
+void CollisionStatsPrint(const char *pLabel, const CollisionStats *pStats);
+
+// ---------------------------------------------------------------------------
+
+#endif // COLLISION_STATS_H
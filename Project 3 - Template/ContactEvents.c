@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	ContactEvents.c
+// Creation Date	:	2026/10/19
+// Purpose			:	contact event ring buffer
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "ContactEvents.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define CONTACT_EVENT_INDEX(i)			((i) & (CONTACT_EVENT_BUFFER_SIZE - 1))
+
+// ---------------------------------------------------------------------------
+
+void ContactEventsInit(ContactEventBuffer *pBuffer)
+{
+	pBuffer->mRead = 0;
+	pBuffer->mWrite = 0;
+	pBuffer->mDroppedNum = 0;
+	pBuffer->mListenerNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int ContactEventsAddListener(ContactEventBuffer *pBuffer, ContactListener Listener, void *pContext)
+{
+	if (pBuffer->mListenerNum >= CONTACT_LISTENER_NUM_MAX)
+		return 0;
+
+	pBuffer->mListeners[pBuffer->mListenerNum] = Listener;
+	pBuffer->mpContexts[pBuffer->mListenerNum] = pContext;
+	++pBuffer->mListenerNum;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int ContactEventsPush(ContactEventBuffer *pBuffer, const ContactEvent *pEvent)
+{
+	if (pBuffer->mWrite - pBuffer->mRead >= CONTACT_EVENT_BUFFER_SIZE)
+	{
+		++pBuffer->mDroppedNum;
+		return 0;
+	}
+
+	pBuffer->mEvents[CONTACT_EVENT_INDEX(pBuffer->mWrite)] = *pEvent;
+	++pBuffer->mWrite;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 ContactEventsNum(const ContactEventBuffer *pBuffer)
+{
+	return pBuffer->mWrite - pBuffer->mRead;
+}
+
+// ---------------------------------------------------------------------------
+
+const ContactEvent* ContactEventsGet(const ContactEventBuffer *pBuffer, u32 Index)
+{
+	return pBuffer->mEvents + CONTACT_EVENT_INDEX(pBuffer->mRead + Index);
+}
+
+// ---------------------------------------------------------------------------
+
+void ContactEventsDispatch(ContactEventBuffer *pBuffer)
+{
+	u32 num = ContactEventsNum(pBuffer);
+	u32 first = CONTACT_EVENT_INDEX(pBuffer->mRead);
+	u32 firstNum = CONTACT_EVENT_BUFFER_SIZE - first, i;
+
+	if (num > 0)
+	{
+		// Up to the end of the array, then what wrapped around
+		if (firstNum > num)
+			firstNum = num;
+
+		for (i = 0; i < pBuffer->mListenerNum; ++i)
+		{
+			pBuffer->mListeners[i](pBuffer->mEvents + first, firstNum, pBuffer->mpContexts[i]);
+
+			if (num > firstNum)
+				pBuffer->mListeners[i](pBuffer->mEvents, num - firstNum, pBuffer->mpContexts[i]);
+		}
+	}
+
+	ContactEventsClear(pBuffer);
+}
+
+// ---------------------------------------------------------------------------
+
+void ContactEventsClear(ContactEventBuffer *pBuffer)
+{
+	pBuffer->mRead = pBuffer->mWrite;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	ContactEvents.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the contact event ring buffer
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef CONTACT_EVENTS_H
+#define CONTACT_EVENTS_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+#include "Vector2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define CONTACT_EVENT_BUFFER_SIZE		256					// Events held at once. Must be a power of 2
+#define CONTACT_LISTENER_NUM_MAX		8
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// One ball touching one obstacle during the frame's motion. 32 bytes
+typedef struct ContactEvent
+{
+	u32					mBall;					// The ball's handle
+	u32					mObstacleType;			// From the COLLISION_OBSTACLE enum
+	u32					mObstacle;				// Index among the obstacles of that type
+	float				mT;						// Fraction of the frame's motion, in ]0, 1]
+	Vector2D			mPoint;					// The ball's center at the contact
+	Vector2D			mNormal;				// The obstacle's unit normal at the contact, on the ball's side
+}ContactEvent;
+
+/*
+Listeners get the events as they were pushed, in at most 2 calls per dispatch
+(the events wrapping around the end of the buffer come in a second call).
+pContext is what was given to ContactEventsAddListener
+*/
+typedef void (*ContactListener)(const ContactEvent *pEvents, u32 Num, void *pContext);
+
+// ---------------------------------------------------------------------------
+
+/*
+Decouples the collision detection, which only pushes events, from what is done
+about them: the response and the listeners read the events in their own passes,
+after the detection is over.
+
+Everything is preallocated: pushing to a full buffer drops the event, and counts it
+*/
+typedef struct ContactEventBuffer
+{
+	ContactEvent		mEvents[CONTACT_EVENT_BUFFER_SIZE];
+	u32					mRead;					// Free running: the index in mEvents is masked
+	u32					mWrite;
+	u32					mDroppedNum;			// Since the buffer was initialized
+
+	ContactListener		mListeners[CONTACT_LISTENER_NUM_MAX];
+	void				*mpContexts[CONTACT_LISTENER_NUM_MAX];
+	u32					mListenerNum;
+}ContactEventBuffer;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Empty, with no listeners
+void ContactEventsInit(ContactEventBuffer *pBuffer);
+
+// Returns 0 if CONTACT_LISTENER_NUM_MAX listeners are already registered
+int ContactEventsAddListener(ContactEventBuffer *pBuffer, ContactListener Listener, void *pContext);
+
+// Returns 0, and drops the event, if the buffer is full
+int ContactEventsPush(ContactEventBuffer *pBuffer, const ContactEvent *pEvent);
+
+// Events pushed and not dispatched yet. Index 0 is the oldest
+u32 ContactEventsNum(const ContactEventBuffer *pBuffer);
+const ContactEvent* ContactEventsGet(const ContactEventBuffer *pBuffer, u32 Index);
+
+// Hands the pending events to every listener, in registration order, then removes them
+void ContactEventsDispatch(ContactEventBuffer *pBuffer);
+
+// Removes the pending events without dispatching them
+void ContactEventsClear(ContactEventBuffer *pBuffer);
+
+// ---------------------------------------------------------------------------
+
+#endif // CONTACT_EVENTS_H
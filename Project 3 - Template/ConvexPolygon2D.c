@@ -0,0 +1,76 @@
+#include "ConvexPolygon2D.h"
+
+
+// Sum of the corners' turns above which the polygon winds around more than once: 1.5 revolutions
+#define CONVEX_POLYGON_TURN_MAX		(3.0f * 3.1415926535897932f)
+
+
+int BuildConvexPolygon2D(ConvexPolygon2D *Poly, Vector2D *Vertices, unsigned int VertexNum)
+{
+	unsigned int i;
+	float area = 0.0f, turn = 0.0f;
+
+	if (VertexNum < 3 || VertexNum > CONVEX_POLYGON_VERTEX_NUM_MAX)
+		return 0;
+
+	// Twice the signed area: negative for clockwise vertices, which get reversed
+	for (i = 0; i < VertexNum; ++i)
+	{
+		Vector2D *pV0 = Vertices + i;
+		Vector2D *pV1 = Vertices + (i + 1) % VertexNum;
+
+		area += pV0->x * pV1->y - pV1->x * pV0->y;
+	}
+
+	if (0.0f == area)
+		return 0;
+
+	Vector2DZero(&Poly->mCenter);
+
+	for (i = 0; i < VertexNum; ++i)
+	{
+		Poly->mVertices[i] = (area > 0.0f) ? Vertices[i] : Vertices[VertexNum - 1 - i];
+		Vector2DAdd(&Poly->mCenter, &Poly->mCenter, &Poly->mVertices[i]);
+	}
+
+	Vector2DScale(&Poly->mCenter, &Poly->mCenter, 1.0f / VertexNum);
+	Poly->mVertexNum = VertexNum;
+	Poly->mRadius = 0.0f;
+
+	for (i = 0; i < VertexNum; ++i)
+	{
+		Vector2D *pV0 = Poly->mVertices + i;
+		Vector2D *pV1 = Poly->mVertices + (i + 1) % VertexNum;
+		Vector2D *pV2 = Poly->mVertices + (i + 2) % VertexNum;
+		float cross, dot, distance;
+
+		if (pV0->x == pV1->x && pV0->y == pV1->y)
+			return 0;
+
+		cross = (pV1->x - pV0->x) * (pV2->y - pV1->y) - (pV1->y - pV0->y) * (pV2->x - pV1->x);
+		dot = (pV1->x - pV0->x) * (pV2->x - pV1->x) + (pV1->y - pV0->y) * (pV2->y - pV1->y);
+
+		// Every corner must turn left, or go straight on (not back)
+		if (cross < 0.0f || (0.0f == cross && dot < 0.0f))
+			return 0;
+
+		turn += atan2f(cross, dot);
+
+		Poly->mN[i].x = pV1->y - pV0->y;
+		Poly->mN[i].y = pV0->x - pV1->x;
+
+		Vector2DNormalize(&Poly->mN[i], &Poly->mN[i]);
+		Poly->mNdotP[i] = Vector2DDotProduct(&Poly->mN[i], pV0);
+
+		distance = Vector2DDistance(&Poly->mCenter, pV0);
+		if (distance > Poly->mRadius)
+			Poly->mRadius = distance;
+	}
+
+	// Only left turns also pass self-intersecting polygons, like a star: they turn around 2 times or more.
+	// A convex one turns around once, 2 * PI, give or take the rounding
+	if (turn > CONVEX_POLYGON_TURN_MAX)
+		return 0;
+
+	return 1;
+}
@@ -0,0 +1,41 @@
+#ifndef CONVEXPOLYGON2D_H
+#define CONVEXPOLYGON2D_H
+
+#include "Vector2D.h"
+
+
+#define CONVEX_POLYGON_VERTEX_NUM_MAX		32
+
+
+typedef struct ConvexPolygon2D
+{
+	Vector2D mVertices[CONVEX_POLYGON_VERTEX_NUM_MAX];		// Counterclockwise
+	Vector2D mN[CONVEX_POLYGON_VERTEX_NUM_MAX];				// Outward normal of the edge from vertex i to vertex i + 1
+	float mNdotP[CONVEX_POLYGON_VERTEX_NUM_MAX];			// To avoid computing it every time it's needed
+	Vector2D mCenter;										// Average of the vertices
+	float mRadius;											// Bounding circle's radius, around mCenter
+	unsigned int mVertexNum;
+}ConvexPolygon2D;
+
+
+/*
+This function builds a 2D convex polygon's data from its vertices
+ - Orders the vertices counterclockwise
+ - Computes the edges' normals (Unit Vectors), facing out
+ - Computes the dot product of each normal with its edge's first vertex
+ - Computes a bounding circle
+
+ - Parameters
+	- Poly:			The to-be-built polygon
+	- Vertices:		The vertices, in clockwise or counterclockwise order
+	- VertexNum:	The number of vertices, from 3 to CONVEX_POLYGON_VERTEX_NUM_MAX
+
+ - Returns 1 if the polygon was built successfully, 0 if it has too few or too many
+   vertices, repeated vertices, or isn't convex
+*/
+int BuildConvexPolygon2D(ConvexPolygon2D *Poly, Vector2D *Vertices, unsigned int VertexNum);
+
+
+
+
+#endif
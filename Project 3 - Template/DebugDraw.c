@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	DebugDraw.c
+// Creation Date	:	2026/10/19
+// Purpose			:	immediate-mode debug draw: primitives are appended to
+//						a per-frame line batch, drawn with one mesh
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "DebugDraw.h"
+#include "Matrix2D.h"
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+static int				sgEnabled = 1;
+
+static DebugDrawVertex	sgVertices[DEBUG_DRAW_VERTEX_NUM_MAX];
+static unsigned int		sgVertexNum;
+
+// Unit circle, built on the first circle drawn
+static Vector2D			sgCirclePoints[DEBUG_DRAW_CIRCLE_SEGMENTS + 1];
+static int				sgCircleBuilt = 0;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void AddLine(float x0, float y0, float x1, float y1, u32 Color);
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawSetEnabled(int Enabled)
+{
+	sgEnabled = Enabled;
+
+	if (0 == sgEnabled)
+		sgVertexNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int DebugDrawIsEnabled(void)
+{
+	return sgEnabled;
+}
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawLine(Vector2D *pP0, Vector2D *pP1, u32 Color)
+{
+	if (0 == sgEnabled)
+		return;
+
+	AddLine(pP0->x, pP0->y, pP1->x, pP1->y, Color);
+}
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawCircle(Vector2D *pCenter, float Radius, u32 Color)
+{
+	unsigned int i;
+
+	if (0 == sgEnabled)
+		return;
+
+	if (0 == sgCircleBuilt)
+	{
+		for (i = 0; i <= DEBUG_DRAW_CIRCLE_SEGMENTS; ++i)
+			Vector2DFromAngleRad(&sgCirclePoints[i], i * TWO_PI / DEBUG_DRAW_CIRCLE_SEGMENTS);
+
+		sgCircleBuilt = 1;
+	}
+
+	for (i = 0; i < DEBUG_DRAW_CIRCLE_SEGMENTS; ++i)
+		AddLine(pCenter->x + sgCirclePoints[i].x * Radius, pCenter->y + sgCirclePoints[i].y * Radius,
+			pCenter->x + sgCirclePoints[i + 1].x * Radius, pCenter->y + sgCirclePoints[i + 1].y * Radius, Color);
+}
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawArrow(Vector2D *pStart, Vector2D *pEnd, u32 Color)
+{
+	float dx, dy;
+
+	if (0 == sgEnabled)
+		return;
+
+	// Head: 2 lines going back from the end, at +/- 0.1 * the perpendicular
+	dx = (pEnd->x - pStart->x) * 0.2f;
+	dy = (pEnd->y - pStart->y) * 0.2f;
+
+	AddLine(pStart->x, pStart->y, pEnd->x, pEnd->y, Color);
+	AddLine(pEnd->x, pEnd->y, pEnd->x - dx - dy * 0.5f, pEnd->y - dy + dx * 0.5f, Color);
+	AddLine(pEnd->x, pEnd->y, pEnd->x - dx + dy * 0.5f, pEnd->y - dy - dx * 0.5f, Color);
+}
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawFlush(void)
+{
+	if (sgEnabled)
+		DebugDrawSubmit(sgVertices, sgVertexNum);
+
+	sgVertexNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int DebugDrawTakeBatch(DebugDrawVertex *pVertices, unsigned int Max)
+{
+	unsigned int num = (sgVertexNum < Max) ? sgVertexNum : Max & ~1u;
+
+	memcpy(pVertices, sgVertices, sizeof(DebugDrawVertex) * num);
+	sgVertexNum = 0;
+
+	return num;
+}
+
+// ---------------------------------------------------------------------------
+
+void DebugDrawSubmit(const DebugDrawVertex *pVertices, unsigned int Num)
+{
+	AEGfxVertexList *pMesh;
+	Matrix2D identity;
+	unsigned int i;
+
+	if (0 == Num)
+		return;
+
+	AEGfxMeshStart();
+
+	for (i = 0; i < Num; ++i)
+		AEGfxVertexAdd(pVertices[i].mX, pVertices[i].mY, pVertices[i].mColor, 0.0f, 0.0f);
+
+	pMesh = AEGfxMeshEnd();
+
+	Matrix2DIdentity(&identity);
+	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
+	AEGfxSetTransform(identity.m);
+	AEGfxMeshDraw(pMesh, AE_GFX_MDM_LINES);
+
+	AEGfxMeshFree(pMesh);
+}
+
+// ---------------------------------------------------------------------------
+
+void AddLine(float x0, float y0, float x1, float y1, u32 Color)
+{
+	DebugDrawVertex *pVertex;
+
+	if (sgVertexNum + 2 > DEBUG_DRAW_VERTEX_NUM_MAX)
+		return;
+
+	pVertex = sgVertices + sgVertexNum;
+	pVertex[0].mX = x0;
+	pVertex[0].mY = y0;
+	pVertex[0].mColor = Color;
+	pVertex[1].mX = x1;
+	pVertex[1].mY = y1;
+	pVertex[1].mColor = Color;
+
+	sgVertexNum += 2;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	DebugDraw.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the immediate-mode debug draw batch
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+#include "SoftGfxCompat.h"
+#include "Vector2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define DEBUG_DRAW_VERTEX_NUM_MAX		8192				// Line vertices batched per frame, extra primitives are dropped
+#define DEBUG_DRAW_CIRCLE_SEGMENTS		16
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// Lines are pairs of these, in world space
+typedef struct DebugDrawVertex
+{
+	float		mX, mY;
+	u32			mColor;
+}DebugDrawVertex;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Turns the batch on/off at runtime. While off, every call below returns immediately
+void DebugDrawSetEnabled(int Enabled);
+int DebugDrawIsEnabled(void);
+
+// Primitives are in world space and only live until the next flush. Colors are ARGB
+void DebugDrawLine(Vector2D *pP0, Vector2D *pP1, u32 Color);
+void DebugDrawCircle(Vector2D *pCenter, float Radius, u32 Color);
+
+// Line from pStart to pEnd, with a head a fifth of the line's length
+void DebugDrawArrow(Vector2D *pStart, Vector2D *pEnd, u32 Color);
+
+/*
+Draws the whole batch as a single line mesh with an identity transform, then empties it.
+Call once per frame, at the end of the game state's draw
+*/
+void DebugDrawFlush(void);
+
+/*
+The flush, in 2 halves, for when the batch is filled on one thread and drawn on the
+one owning the graphics context (see RenderSnapshot.h):
+	- DebugDrawTakeBatch moves up to Max vertices out of the batch, and empties it
+	- DebugDrawSubmit draws such vertices, like the flush does
+*/
+unsigned int DebugDrawTakeBatch(DebugDrawVertex *pVertices, unsigned int Max);
+void DebugDrawSubmit(const DebugDrawVertex *pVertices, unsigned int Num);
+
+// ---------------------------------------------------------------------------
+
+#endif // DEBUG_DRAW_H
@@ -0,0 +1,212 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	DistanceQuery.c
+// Creation Date	:	2026/10/19
+// Purpose			:	batched nearest obstacle queries: ring search over the
+//						obstacle grid, 4 obstacles per SSE test
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <float.h>
+#include <xmmintrin.h>
+
+#include "DistanceQuery.h"
+#include "Math2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define QUERY_MIN(a, b)		((a) < (b) ? (a) : (b))
+#define QUERY_MAX(a, b)		((a) > (b) ? (a) : (b))
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct
+{
+	float		mX, mY;
+	float		mBest2;					// Squared distance to the closest obstacle so far
+	u32			mType;
+	u32			mId;
+}QueryState;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void QueryPoint(const ObstacleGrid *pGrid, QueryState *pQuery);
+static void VisitCell(const ObstacleGrid *pGrid, s32 x, s32 y, QueryState *pQuery);
+static void TestCell(const ObstacleGrid *pGrid, s32 Cell, QueryState *pQuery);
+
+// ---------------------------------------------------------------------------
+
+void DistanceQueryBatch(const ObstacleGrid *pGrid, const Vector2D *pPoints, u32 PointNum, float MaxDistance, DistanceHit *pHits)
+{
+	u32 i;
+
+	for (i = 0; i < PointNum; ++i)
+	{
+		DistanceHit *pHit = pHits + i;
+		QueryState query;
+
+		query.mX = pPoints[i].x;
+		query.mY = pPoints[i].y;
+		query.mBest2 = MaxDistance * MaxDistance;
+		query.mType = OBSTACLE_TYPE_NONE;
+		query.mId = OBSTACLE_GRID_PAD_ID;
+
+		QueryPoint(pGrid, &query);
+
+		pHit->mType = query.mType;
+		pHit->mIndex = query.mId;
+
+		// Only the winner gets its exact signed distance and closest point
+		if (OBSTACLE_TYPE_LINE_SEGMENT == query.mType)
+			pHit->mDistance = ClosestPointOnStaticLineSegment((Vector2D *)&pPoints[i], (LineSegment2D *)&pGrid->mpSegments[query.mId], &pHit->mClosest);
+		else
+		if (OBSTACLE_TYPE_CIRCLE == query.mType)
+			pHit->mDistance = ClosestPointOnStaticCircle((Vector2D *)&pPoints[i], (Vector2D *)&pGrid->mpCircleCenters[query.mId], pGrid->mpCircleRadii[query.mId], &pHit->mClosest);
+		else
+		{
+			pHit->mDistance = MaxDistance;
+			pHit->mClosest = pPoints[i];
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void QueryPoint(const ObstacleGrid *pGrid, QueryState *pQuery)
+{
+	s32 centerX = ObstacleGridCellX(pGrid, pQuery->mX);
+	s32 centerY = ObstacleGridCellY(pGrid, pQuery->mY);
+	s32 ring, x, y;
+
+	for (ring = 0;; ++ring)
+	{
+		s32 x0 = centerX - ring, x1 = centerX + ring;
+		s32 y0 = centerY - ring, y1 = centerY + ring;
+		float bound = FLT_MAX;
+
+		// Cells at Chebyshev distance "ring" from the center cell
+		for (y = QUERY_MAX(y0, 0); y <= QUERY_MIN(y1, pGrid->mCellsY - 1); ++y)
+		{
+			if (y == y0 || y == y1)
+			{
+				for (x = QUERY_MAX(x0, 0); x <= QUERY_MIN(x1, pGrid->mCellsX - 1); ++x)
+					VisitCell(pGrid, x, y, pQuery);
+			}
+			else
+			{
+				if (x0 >= 0)
+					VisitCell(pGrid, x0, y, pQuery);
+				if (x1 < pGrid->mCellsX)
+					VisitCell(pGrid, x1, y, pQuery);
+			}
+		}
+
+		// Every cell left is beyond one of the block's sides that isn't on the grid's border
+		if (x0 > 0)
+			bound = QUERY_MIN(bound, pQuery->mX - (pGrid->mMin.x + x0 * pGrid->mCellSize));
+		if (x1 < pGrid->mCellsX - 1)
+			bound = QUERY_MIN(bound, pGrid->mMin.x + (x1 + 1) * pGrid->mCellSize - pQuery->mX);
+		if (y0 > 0)
+			bound = QUERY_MIN(bound, pQuery->mY - (pGrid->mMin.y + y0 * pGrid->mCellSize));
+		if (y1 < pGrid->mCellsY - 1)
+			bound = QUERY_MIN(bound, pGrid->mMin.y + (y1 + 1) * pGrid->mCellSize - pQuery->mY);
+
+		// Whole grid visited, or nothing left can be closer
+		if (FLT_MAX == bound || bound * bound >= pQuery->mBest2)
+			break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void VisitCell(const ObstacleGrid *pGrid, s32 x, s32 y, QueryState *pQuery)
+{
+	float cellX = pGrid->mMin.x + x * pGrid->mCellSize;
+	float cellY = pGrid->mMin.y + y * pGrid->mCellSize;
+	float dx = pQuery->mX - QUERY_MAX(cellX, QUERY_MIN(pQuery->mX, cellX + pGrid->mCellSize));
+	float dy = pQuery->mY - QUERY_MAX(cellY, QUERY_MIN(pQuery->mY, cellY + pGrid->mCellSize));
+
+	// Skip the cells further than the best obstacle so far
+	if (dx * dx + dy * dy >= pQuery->mBest2)
+		return;
+
+	TestCell(pGrid, y * pGrid->mCellsX + x, pQuery);
+}
+
+// ---------------------------------------------------------------------------
+
+void TestCell(const ObstacleGrid *pGrid, s32 Cell, QueryState *pQuery)
+{
+	__m128 px = _mm_set1_ps(pQuery->mX);
+	__m128 py = _mm_set1_ps(pQuery->mY);
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	float d2[4];
+	u32 i, k;
+
+	// Line segments, 4 per iteration: squared distance to the projection clamped to [P0, P1]
+	for (i = pGrid->mpSegmentStart[Cell]; i < pGrid->mpSegmentStart[Cell + 1]; i += 4)
+	{
+		__m128 ex = _mm_load_ps(pGrid->mpSegmentDX + i);
+		__m128 ey = _mm_load_ps(pGrid->mpSegmentDY + i);
+		__m128 wx = _mm_sub_ps(px, _mm_load_ps(pGrid->mpSegmentX0 + i));
+		__m128 wy = _mm_sub_ps(py, _mm_load_ps(pGrid->mpSegmentY0 + i));
+		__m128 lengthSquare = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+		__m128 t = _mm_div_ps(_mm_add_ps(_mm_mul_ps(wx, ex), _mm_mul_ps(wy, ey)), lengthSquare);
+		__m128 dx, dy, dd;
+		int bits;
+
+		// A 0 length (padding) gives t = NaN, which _mm_max_ps turns into 0. Padding slots are out of reach anyway
+		t = _mm_min_ps(_mm_max_ps(t, zero), one);
+		dx = _mm_sub_ps(wx, _mm_mul_ps(t, ex));
+		dy = _mm_sub_ps(wy, _mm_mul_ps(t, ey));
+		dd = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+		bits = _mm_movemask_ps(_mm_cmplt_ps(dd, _mm_set1_ps(pQuery->mBest2)));
+		if (0 == bits)
+			continue;
+
+		_mm_storeu_ps(d2, dd);
+		for (k = 0; k < 4; ++k)
+		{
+			if ((bits & (1 << k)) && d2[k] < pQuery->mBest2)
+			{
+				pQuery->mBest2 = d2[k];
+				pQuery->mType = OBSTACLE_TYPE_LINE_SEGMENT;
+				pQuery->mId = pGrid->mpSegmentIds[i + k];
+			}
+		}
+	}
+
+	// Circles, 4 per iteration: squared distance to the outline, from inside or outside
+	for (i = pGrid->mpCircleStart[Cell]; i < pGrid->mpCircleStart[Cell + 1]; i += 4)
+	{
+		__m128 mx = _mm_sub_ps(px, _mm_load_ps(pGrid->mpCircleX + i));
+		__m128 my = _mm_sub_ps(py, _mm_load_ps(pGrid->mpCircleY + i));
+		__m128 radius = _mm_sqrt_ps(_mm_max_ps(_mm_load_ps(pGrid->mpCircleR2 + i), zero));
+		__m128 d = _mm_sub_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my))), radius);
+		__m128 dd = _mm_mul_ps(d, d);
+		int bits;
+
+		bits = _mm_movemask_ps(_mm_cmplt_ps(dd, _mm_set1_ps(pQuery->mBest2)));
+		if (0 == bits)
+			continue;
+
+		_mm_storeu_ps(d2, dd);
+		for (k = 0; k < 4; ++k)
+		{
+			if ((bits & (1 << k)) && d2[k] < pQuery->mBest2)
+			{
+				pQuery->mBest2 = d2[k];
+				pQuery->mType = OBSTACLE_TYPE_CIRCLE;
+				pQuery->mId = pGrid->mpCircleIds[i + k];
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	DistanceQuery.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the batched closest-point queries against the obstacles
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef DISTANCE_QUERY_H
+#define DISTANCE_QUERY_H
+
+// ---------------------------------------------------------------------------
+
+#include "ObstacleGrid.h"
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct DistanceHit
+{
+	u32				mType;				// OBSTACLE_TYPE_NONE if no obstacle is closer than the max distance
+	u32				mIndex;				// Index of the obstacle in its own array
+	float			mDistance;			// Signed, as returned by ClosestPointOnStaticLineSegment/ClosestPointOnStaticCircle. Max distance if nothing was found
+	Vector2D		mClosest;			// Closest point of the obstacle. The query point if nothing was found
+}DistanceHit;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Finds the obstacle closest to each point, among the obstacles binned in pGrid.
+
+ - Parameters
+	- pPoints:		The query points
+	- PointNum:		The number of points
+	- MaxDistance:	Obstacles further than this are ignored. The smaller, the faster:
+					the search grows in rings of cells around the point, skips the cells
+					further than the closest obstacle found so far, and stops once every
+					unvisited cell is further than it
+	- pHits:		PointNum results, in the same order as the points
+*/
+void DistanceQueryBatch(const ObstacleGrid *pGrid, const Vector2D *pPoints, u32 PointNum, float MaxDistance, DistanceHit *pHits);
+
+// ---------------------------------------------------------------------------
+
+#endif // DISTANCE_QUERY_H
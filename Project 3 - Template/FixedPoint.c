@@ -0,0 +1,102 @@
+#include "FixedPoint.h"
+
+// Right shifts of negative numbers are arithmetic on every compiler the game is built with
+
+// ---------------------------------------------------------------------------
+
+Fixed FixedFromFloat(float f)
+{
+	// f * 65536 is exact, the rounding is done by the conversion to int
+	float scaled = f * (float)FIXED_ONE;
+
+	if (scaled >= 2147483520.0f)
+		return FIXED_MAX;
+	if (scaled <= -2147483648.0f)
+		return FIXED_MIN;
+
+	return (Fixed)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+// ---------------------------------------------------------------------------
+
+float FixedToFloat(Fixed a)
+{
+	return (float)a * (1.0f / (float)FIXED_ONE);
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed FixedFromWide(FixedWide a)
+{
+	if (a > FIXED_MAX)
+		return FIXED_MAX;
+	if (a < FIXED_MIN)
+		return FIXED_MIN;
+
+	return (Fixed)a;
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed FixedMul(Fixed a, Fixed b)
+{
+	return FixedFromWide(FixedMulWide(a, b));
+}
+
+// ---------------------------------------------------------------------------
+
+FixedWide FixedMulWide(Fixed a, Fixed b)
+{
+	return ((s64)a * b + (FIXED_ONE >> 1)) >> FIXED_SHIFT;
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed FixedDiv(Fixed a, Fixed b)
+{
+	if (0 == b)
+		return (a < 0) ? FIXED_MIN : FIXED_MAX;
+
+	return FixedFromWide((s64)a * FIXED_ONE / b);
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed FixedSqrt(FixedWide a)
+{
+	u64 op, result = 0, bit = (u64)1 << 62;
+
+	if (a <= 0)
+		return 0;
+
+	// sqrt(a / 2^16) * 2^16 = sqrt(a * 2^16). Past 2^47 the root doesn't fit anyway
+	if (a >= ((s64)1 << 47))
+		return FIXED_MAX;
+
+	op = (u64)a << FIXED_SHIFT;
+
+	// Digit by digit, 2 bits of the operand per bit of the root
+	while (bit > op)
+		bit >>= 2;
+
+	while (bit)
+	{
+		if (op >= result + bit)
+		{
+			op -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+			result >>= 1;
+
+		bit >>= 2;
+	}
+
+	// Round to the nearest: the remainder is above result + 0.5 when op > result
+	if (op > result)
+		++result;
+
+	return FixedFromWide((FixedWide)result);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+
+#include "AETypes.h"
+
+
+/*
+16.16 fixed-point numbers, for the deterministic simulation.
+
+Every operation is done on integers, so the same inputs give bit-identical results
+on every compiler, flag set and CPU. Fixed is an int rather than an s32, since s32
+is 64 bits wide on some platforms.
+
+Squared lengths and dot products don't fit in 16 integer bits (400 * 400 is already
+above 32767), so they are returned as FixedWide: 48.16, same scale, 64 bits.
+*/
+typedef int Fixed;
+typedef s64 FixedWide;
+
+
+#define FIXED_SHIFT			16
+#define FIXED_ONE			(1 << FIXED_SHIFT)
+#define FIXED_MAX			0x7FFFFFFF
+#define FIXED_MIN			(-FIXED_MAX - 1)
+
+#define FIXED_FROM_INT(i)	((Fixed)((i) * FIXED_ONE))
+
+
+/*
+Conversions from and to float, rounding to the nearest fixed-point value.
+Only use them on the simulation's boundaries: constants, loading and rendering
+*/
+Fixed FixedFromFloat(float f);
+
+float FixedToFloat(Fixed a);
+
+/*
+Converts a 48.16 value back to 16.16, saturating to [FIXED_MIN, FIXED_MAX]
+*/
+Fixed FixedFromWide(FixedWide a);
+
+/*
+a * b, rounded to the nearest and saturated
+*/
+Fixed FixedMul(Fixed a, Fixed b);
+
+/*
+a * b, rounded to the nearest, without overflow
+*/
+FixedWide FixedMulWide(Fixed a, Fixed b);
+
+/*
+a / b, rounded towards 0 and saturated. Dividing by 0 saturates to the sign of a
+*/
+Fixed FixedDiv(Fixed a, Fixed b);
+
+/*
+Square root of a 48.16 value, rounded to the nearest. Negative values give 0
+*/
+Fixed FixedSqrt(FixedWide a);
+
+
+
+#endif
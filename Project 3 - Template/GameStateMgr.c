@@ -11,8 +11,31 @@
 // - 2015/12/10		:	- Moved game flow from "main.c" to the "GSM_MainLoop" function 
 // ---------------------------------------------------------------------------
 
+#include <string.h>
+
 #include "GameStateMgr.h"
 #include "GameState_Play.h"
+#include "InputRecorder.h"
+#include "Profiler.h"
+#include "CollisionStats.h"
+#include "JobSystem.h"
+#include "SoftGfxCompat.h"
+
+// ---------------------------------------------------------------------------
+// defines
+
+/*
+1: the update of frame N+1 runs as a job while the main thread draws frame N from a
+snapshot. The latency stays at one frame: the main thread waits for the update
+before starting the next frame
+*/
+#define GSM_UPDATE_JOB			1
+
+#define GSM_SNAPSHOT_NUM		2				// One being drawn, one being filled
+
+// With AE_GFX_SOFTWARE: the framebuffer, like the window main.c creates. It's stretched to the window's client area
+#define GSM_SOFT_GFX_WIDTH		800
+#define GSM_SOFT_GFX_HEIGHT		600
 
 // ---------------------------------------------------------------------------
 // globals
@@ -30,6 +53,22 @@ void(*GameStateUpdate)(void) = 0;
 void(*GameStateDraw)(void) = 0;
 void(*GameStateFree)(void) = 0;
 void(*GameStateUnload)(void) = 0;
+void(*GameStateSnapshot)(RenderSnapshot *pSnapshot, u32 Frame) = 0;
+
+// the update job and the snapshots it publishes
+static JobCounter		sgUpdateCounter;
+static u32				sgUpdateFrame;
+
+static RenderSnapshot	sgSnapshots[GSM_SNAPSHOT_NUM];
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void UpdateJob(void *pData);
+
+#if(AE_GFX_SOFTWARE)
+static void PresentSoftGfx(void);
+#endif
 
 // ---------------------------------------------------------------------------
 // Functions implementations
@@ -44,6 +83,9 @@ void GameStateMgrInit(unsigned int gameStateInit)
 		gGameStatePrev =
 		gGameStateNext = gGameStateInit;
 
+	// the workers live until GS_QUIT. Without them, every job runs on the main thread
+	JobSystemInit(0);
+
 	// call the update to set the function pointers
 	GameStateMgrUpdate();
 }
@@ -62,6 +104,7 @@ void GameStateMgrUpdate()
 		GameStateInit = GameStatePlayInit;
 		GameStateUpdate = GameStatePlayUpdate;
 		GameStateDraw = GameStatePlayDraw;
+		GameStateSnapshot = GameStatePlaySnapshot;
 		GameStateFree = GameStatePlayFree;
 		GameStateUnload = GameStatePlayUnload;
 		break;
@@ -76,8 +119,16 @@ void GameStateMgrUpdate()
 
 void GSM_MainLoop(void)
 {
+#if(AE_GFX_SOFTWARE)
+	// One raster thread per job thread
+	if (0 == SoftGfxInit(GSM_SOFT_GFX_WIDTH, GSM_SOFT_GFX_HEIGHT, JobSystemGetWorkerNum() + 1))
+		AE_FATAL_ERROR("SoftGfxInit failed!!");
+#endif
+
 	while (gGameStateCurr != GS_QUIT)
 	{
+		u32 frame = 0;
+
 		// reset the system modules
 		AESysReset();
 
@@ -95,15 +146,70 @@ void GSM_MainLoop(void)
 
 		while (gGameStateCurr == gGameStateNext)
 		{
+			PROFILE_BEGIN(PROFILE_ZONE_FRAME);
+
+			PROFILE_BEGIN(PROFILE_ZONE_FRAME_START);
 			AESysFrameStart();
+#if(AE_GFX_SOFTWARE)
+			SoftGfxFrameStart();
+#endif
+			PROFILE_END(PROFILE_ZONE_FRAME_START);
 
+			PROFILE_BEGIN(PROFILE_ZONE_INPUT);
 			AEInputUpdate();
 
-			GameStateUpdate();
+			InputRecorderFrameStart();
+			PROFILE_END(PROFILE_ZONE_INPUT);
+
+			if (GSM_UPDATE_JOB && GameStateSnapshot)
+			{
+				JobDecl update = { UpdateJob, NULL };
+
+				// Frame N+1 is simulated...
+				sgUpdateFrame = frame;
+				JobRun(&update, 1, &sgUpdateCounter);
+
+				// ...while frame N is drawn. The very first frame of a state has nothing to draw yet
+				PROFILE_BEGIN(PROFILE_ZONE_DRAW);
+				if (frame > 0)
+					RenderSnapshotDraw(sgSnapshots + (frame - 1) % GSM_SNAPSHOT_NUM);
+				PROFILE_END(PROFILE_ZONE_DRAW);
 
-			GameStateDraw();
+				PROFILE_BEGIN(PROFILE_ZONE_FRAME_END);
+#if(AE_GFX_SOFTWARE)
+				PresentSoftGfx();
+#endif
+				AESysFrameEnd();
+				PROFILE_END(PROFILE_ZONE_FRAME_END);
 
-			AESysFrameEnd();
+				// The input and the state changes of the next frame must see this update whole.
+				// Meanwhile, the main thread runs the update's jobs too
+				PROFILE_BEGIN(PROFILE_ZONE_UPDATE_WAIT);
+				JobWait(&sgUpdateCounter);
+				PROFILE_END(PROFILE_ZONE_UPDATE_WAIT);
+			}
+			else
+			{
+				PROFILE_BEGIN(PROFILE_ZONE_UPDATE);
+				GameStateUpdate();
+				PROFILE_END(PROFILE_ZONE_UPDATE);
+
+				PROFILE_BEGIN(PROFILE_ZONE_DRAW);
+				GameStateDraw();
+				PROFILE_END(PROFILE_ZONE_DRAW);
+
+				PROFILE_BEGIN(PROFILE_ZONE_FRAME_END);
+#if(AE_GFX_SOFTWARE)
+				PresentSoftGfx();
+#endif
+				AESysFrameEnd();
+				PROFILE_END(PROFILE_ZONE_FRAME_END);
+			}
+
+			PROFILE_END(PROFILE_ZONE_FRAME);
+			ProfilerFrameEnd();
+
+			++frame;
 
 			// check if forcing the application to quit
 			if ((0 == AESysDoesWindowExist()) || AEInputCheckTriggered(VK_ESCAPE))
@@ -118,7 +224,159 @@ void GSM_MainLoop(void)
 		gGameStatePrev = gGameStateCurr;
 		gGameStateCurr = gGameStateNext;
 	}
+
+#if(AE_GFX_SOFTWARE)
+	SoftGfxExit();
+#endif
+
+	JobSystemShutdown();
+}
+
+
+// ---------------------------------------------------------------------------
+
+void GSM_ReplayLoop(const char *pImageFileName)
+{
+	f64 startTime, endTime;
+	u32 frameNum = 0;
+#if(AE_GFX_SOFTWARE)
+	f64 renderTime = 0.0;
+	int render = 0;
+#endif
+
+	// Rendering needs the software rasterizer: there is no graphics context to read back from
+#if(AE_GFX_SOFTWARE)
+	if (pImageFileName && 0 == (render = SoftGfxInit(GSM_SOFT_GFX_WIDTH, GSM_SOFT_GFX_HEIGHT, JobSystemGetWorkerNum() + 1)))
+		PRINT("Replay: SoftGfxInit failed, nothing is rendered\n");
+#else
+	if (pImageFileName)
+		PRINT("Replay: rendering needs AE_GFX_SOFTWARE, nothing is rendered\n");
+#endif
+
+	GameStateMgrUpdate();
+	GameStateLoad();
+	GameStateInit();
+
+	AEGetTime(&startTime);
+
+	// Headless: no frame rate controller and no window update.
+	// Every frame of the log is fed to the update as fast as possible
+	while (InputRecorderFrameStart())
+	{
+		PROFILE_BEGIN(PROFILE_ZONE_FRAME);
+		PROFILE_BEGIN(PROFILE_ZONE_UPDATE);
+		GameStateUpdate();
+		PROFILE_END(PROFILE_ZONE_UPDATE);
+
+#if(AE_GFX_SOFTWARE)
+		// Drawn from a snapshot like GSM_MainLoop does, and timed on its own
+		if (render && GameStateSnapshot)
+		{
+			f64 renderStart, renderEnd;
+
+			PROFILE_BEGIN(PROFILE_ZONE_SNAPSHOT);
+			GameStateSnapshot(sgSnapshots, frameNum);
+			PROFILE_END(PROFILE_ZONE_SNAPSHOT);
+
+			PROFILE_BEGIN(PROFILE_ZONE_DRAW);
+			AEGetTime(&renderStart);
+			SoftGfxFrameStart();
+			RenderSnapshotDraw(sgSnapshots);
+			SoftGfxFrameEnd();
+			AEGetTime(&renderEnd);
+			PROFILE_END(PROFILE_ZONE_DRAW);
+
+			renderTime += renderEnd - renderStart;
+		}
+#endif
+
+		PROFILE_END(PROFILE_ZONE_FRAME);
+		ProfilerFrameEnd();
+
+		++frameNum;
+
+		if (gGameStateNext != gGameStateCurr)
+			break;
+	}
+
+	AEGetTime(&endTime);
+
+#if(COLLISION_STATS_ENABLED)
+	CollisionStatsPrint("Replay collisions", CollisionStatsGetTotals());
+#endif
+
+#if(AE_GFX_SOFTWARE)
+	if (render)
+	{
+		PRINT("Render: %lu frames, %.3f ms/frame (%lu threads)\n", (unsigned long)frameNum,
+			frameNum ? renderTime * 1000.0 / frameNum : 0.0, (unsigned long)(JobSystemGetWorkerNum() + 1));
+
+		// The last frame: the final state of the replay
+		if (0 == SoftGfxDumpPPM(pImageFileName))
+			PRINT("Render: %s couldn't be written\n", pImageFileName);
+
+		SoftGfxExit();
+	}
+#endif
+
+	GameStateFree();
+	GameStateUnload();
+
+	gGameStateCurr = gGameStateNext = GS_QUIT;
+
+	JobSystemShutdown();
+
+	PRINT("Replay: %lu frames in %.3f s (%.1f frames/s)\n", (unsigned long)frameNum, endTime - startTime,
+		(endTime > startTime) ? frameNum / (endTime - startTime) : 0.0);
+}
+
+// ---------------------------------------------------------------------------
+
+void UpdateJob(void *pData)
+{
+	(void)pData;
+
+	PROFILE_BEGIN(PROFILE_ZONE_UPDATE);
+	GameStateUpdate();
+	PROFILE_END(PROFILE_ZONE_UPDATE);
+
+	// Published even if the update changed the state: the main thread stops drawing this state's snapshots then
+	PROFILE_BEGIN(PROFILE_ZONE_SNAPSHOT);
+	GameStateSnapshot(sgSnapshots + sgUpdateFrame % GSM_SNAPSHOT_NUM, sgUpdateFrame);
+	PROFILE_END(PROFILE_ZONE_SNAPSHOT);
+}
+
+// ---------------------------------------------------------------------------
+
+#if(AE_GFX_SOFTWARE)
+
+void PresentSoftGfx(void)
+{
+	HWND window = AESysGetWindowHandle();
+	BITMAPINFO bitmapInfo;
+	const u32 *pPixels;
+	u32 width, height;
+	RECT rect;
+	HDC dc;
+
+	SoftGfxFrameEnd();
+	pPixels = SoftGfxGetFramebuffer(&width, &height);
+
+	// 0xAARRGGBB is the byte order of a 32 bit DIB. Negative height: row 0 at the top
+	memset(&bitmapInfo, 0, sizeof(BITMAPINFO));
+	bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bitmapInfo.bmiHeader.biWidth = (LONG)width;
+	bitmapInfo.bmiHeader.biHeight = -(LONG)height;
+	bitmapInfo.bmiHeader.biPlanes = 1;
+	bitmapInfo.bmiHeader.biBitCount = 32;
+	bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+	GetClientRect(window, &rect);
+	dc = GetDC(window);
+	StretchDIBits(dc, 0, 0, rect.right - rect.left, rect.bottom - rect.top, 0, 0, width, height, pPixels, &bitmapInfo, DIB_RGB_COLORS, SRCCOPY);
+	ReleaseDC(window, dc);
 }
 
+#endif
 
 // ---------------------------------------------------------------------------
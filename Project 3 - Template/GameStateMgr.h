@@ -16,6 +16,7 @@
 // ---------------------------------------------------------------------------
 
 #include "AEEngine.h"
+#include "RenderSnapshot.h"
 
 // ---------------------------------------------------------------------------
 // include the list of game states
@@ -39,15 +40,33 @@ extern void(*GameStateDraw)();
 extern void(*GameStateFree)();
 extern void(*GameStateUnload)();
 
+// Optional: fills a render snapshot with what GameStateDraw would draw. Without it, the state always runs serially
+extern void(*GameStateSnapshot)(RenderSnapshot *pSnapshot, u32 Frame);
+
 // ---------------------------------------------------------------------------
 // Function prototypes
 
-// call this at the beginning and AFTER all game states are added to the manager
+// call this at the beginning and AFTER all game states are added to the manager. Starts the job system
 void GameStateMgrInit(unsigned int gameStateInit);
 
 // update is used to set the function pointers
 void GameStateMgrUpdate();
 
+/*
+runs the game states until GS_QUIT.
+With GSM_UPDATE_JOB, and for states with a GameStateSnapshot, the update runs as a job
+(see JobSystem.h) and publishes a render snapshot; the main thread, which owns the
+graphics context, draws the previous frame's snapshot meanwhile
+*/
+void GSM_MainLoop(void);
+
+/*
+runs the initial game state headless, fed by the input log being replayed (see InputRecorder.h).
+With AE_GFX_SOFTWARE and a pImageFileName, every frame is also drawn from a snapshot by
+SoftGfx: the time per frame is printed, and the last frame written to pImageFileName as PPM
+*/
+void GSM_ReplayLoop(const char *pImageFileName);
+
 // ---------------------------------------------------------------------------
 
 #endif // AE_GAME_STATE_MGR_H
\ No newline at end of file
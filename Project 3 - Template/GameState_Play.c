@@ -9,6 +9,7 @@
 // ---------------------------------------------------------------------------
 
 #include "main.h"
+#include "GameState_Play.h"
 
 // ---------------------------------------------------------------------------
 // Defines
@@ -24,13 +25,37 @@
 #define FLAG_ACTIVE		0x00000001
 
 #define TEST_PART_2				1
+#define TEST_CONVEX_POLYGON		0									// Set this to 1 in order to add a convex block to the room
 #define DRAW_DEBUG				1									// Set this to 1 in order to draw debug data
+#define DETERMINISTIC_SIMULATION	0								// Set this to 1 in order to run the ball in fixed point, bit-identical on every machine (lockstep)
+
+#if(DETERMINISTIC_SIMULATION && TEST_CONVEX_POLYGON)
+#error "The convex block has no fixed-point kernel"
+#endif
+
+#define DETERMINISTIC_FRAME_TIME	(FIXED_ONE / 60)				// The fixed-point simulation steps at a fixed rate, since frame times differ between machines
 
 
 #define LINE_SEGMENTS_NUM		5									// Don't change
 #define BALL_RADIUS				15.0f
 #define PILLARS_NUM				6									// Don't change
 
+#define DEBUG_NORMAL_LENGTH		25.0f
+#define DEBUG_VELOCITY_SCALE	0.25f								// The velocity arrow shows the next 0.25s of motion
+#define DEBUG_AIM_RAY_LENGTH	1000.0f
+#define DEBUG_PROXIMITY_RANGE	200.0f								// The closest obstacle is linked to the ball within this distance
+
+#if(TEST_PART_2)
+#define OBSTACLES_NUM			(LINE_SEGMENTS_NUM + PILLARS_NUM + PILLARS_NUM / 2 + TEST_CONVEX_POLYGON)
+#define GRID_LINE_SEGMENTS_NUM	(LINE_SEGMENTS_NUM + PILLARS_NUM / 2)
+#else
+#define OBSTACLES_NUM			(LINE_SEGMENTS_NUM + TEST_CONVEX_POLYGON)
+#define GRID_LINE_SEGMENTS_NUM	LINE_SEGMENTS_NUM
+#endif
+
+#define BLOCK_VERTICES_NUM		8
+#define CIRCLE_MESH_PARTS		24									// Triangles of the ball and pillar meshes
+
 
 // ---------------------------------------------------------------------------
 
@@ -39,12 +64,42 @@ enum OBJECT_TYPE
 	OBJECT_TYPE_BALL,
 	OBJECT_TYPE_LINE,
 	OBJECT_TYPE_PILLAR,
-	OBJECT_TYPE_DEBUG_LINE,
+	OBJECT_TYPE_BLOCK,
 };
 
+// Components, and their bits in the archetypes' component masks
+enum COMPONENT
+{
+	COMPONENT_SPRITE,
+	COMPONENT_TRANSFORM,
+	COMPONENT_PHYSICS,
+
+	// Keep this one last
+	COMPONENT_NUM
+};
+
+#define COMPONENT_BIT(c)		(1 << (c))
+
+// Handles: the instance's index in the low 16 bits, its generation in the high 16 bits.
+// The generation changes every time the slot is reused, so stale handles resolve to 0
+#define HANDLE_INDEX_BITS		16
+#define HANDLE_INDEX_MASK		((1 << HANDLE_INDEX_BITS) - 1)
+#define HANDLE_GENERATION_MASK	0xFFFF
+#define HANDLE_NONE				0									// Generations start at 1, so no live instance has this handle
+
+#define MAKE_HANDLE(index, generation)	((GameObjectHandle)((((generation) & HANDLE_GENERATION_MASK) << HANDLE_INDEX_BITS) | ((index) & HANDLE_INDEX_MASK)))
+#define HANDLE_INDEX(h)					((h) & HANDLE_INDEX_MASK)
+#define HANDLE_GENERATION(h)			(((h) >> HANDLE_INDEX_BITS) & HANDLE_GENERATION_MASK)
+
+#if(GAME_OBJ_INST_NUM_MAX > (1 << HANDLE_INDEX_BITS))
+#error "Instance indices don't fit in the handles"
+#endif
+
 // Struct/Class definitions
 
-typedef struct GameObjectInstance GameObjectInstance;			// Forward declaration needed, since components need to point to their owner "GameObjectInstance"
+typedef struct GameObjectInstance GameObjectInstance;			// Forward declaration needed by the functions below
+
+typedef u32 GameObjectHandle;									// Reference to a "GameObjectInstance", see MAKE_HANDLE
 
 // ---------------------------------------------------------------------------
 
@@ -59,9 +114,9 @@ typedef struct
 
 typedef struct
 {
-	Shape *mpShape;
+	u32						mShape;				// Index in sgShapes: no pointer, so the component can be copied around as raw bytes
 
-	GameObjectInstance *	mpOwner;			// This component's owner
+	GameObjectHandle		mOwner;				// This component's owner
 }Component_Sprite;
 
 // ---------------------------------------------------------------------------
@@ -69,13 +124,13 @@ typedef struct
 typedef struct
 {
 	Vector2D					mPosition;		// Current position
-	float					mAngle;			// Current angle
+	Rotation2D				mRotation;		// Current orientation, as (cos, sin): no trigonometry to build the matrix
 	float					mScaleX;		// Current X scaling value
 	float					mScaleY;		// Current Y scaling value
 
-	Matrix2D					mTransform;		// Object transformation matrix: Each frame, calculate the object instance's transformation matrix and save it here
+	Affine2D					mTransform;		// Object transformation matrix: Each frame, calculate the object instance's transformation matrix and save it here
 
-	GameObjectInstance *	mpOwner;		// This component's owner
+	GameObjectHandle		mOwner;			// This component's owner
 }Component_Transform;
 
 // ---------------------------------------------------------------------------
@@ -84,19 +139,26 @@ typedef struct
 {
 	Vector2D					mVelocity;		// Current velocity
 
-	GameObjectInstance *	mpOwner;		// This component's owner
+#if(DETERMINISTIC_SIMULATION)
+	Vector2DFixed				mPositionFixed;	// The simulated position. The transform's position is only its rendered copy
+	Vector2DFixed				mVelocityFixed;	// The simulated velocity
+#endif
+
+	GameObjectHandle		mOwner;			// This component's owner
 }Component_Physics;
 
 // ---------------------------------------------------------------------------
 
 //Game object instance structure
+//The components live in the archetype matching the instance's component set, and move with it
 struct GameObjectInstance
 {
 	unsigned long				mFlag;						// Bit mFlag, used to indicate if the object instance is active or not
 
-	Component_Sprite			*mpComponent_Sprite;		// Sprite component
-	Component_Transform			*mpComponent_Transform;		// Transform component
-	Component_Physics			*mpComponent_Physics;		// Physics component
+	u32							mGeneration;				// Bumped every time the slot is reused, never 0 once used
+
+	u32							mArchetype;					// Index in sgWorld
+	u32							mRow;						// Row in the archetype
 };
 
 // ---------------------------------------------------------------------------
@@ -110,6 +172,9 @@ static unsigned long		sgShapeNum;													// The number of defined shapes
 static GameObjectInstance		sgGameObjectInstanceList[GAME_OBJ_INST_NUM_MAX];		// Each element in this array represents a unique game object instance
 static unsigned long			sgGameObjectInstanceNum;								// The number of active game object instances
 
+// Component storage: one chunked table per component set. The entities are the instances' indices
+static ArchetypeWorld			sgWorld;
+
 static Vector2D			gRoomPoints[LINE_SEGMENTS_NUM * 2];
 static LineSegment2D	gRoomLineSegments[LINE_SEGMENTS_NUM];
 
@@ -121,43 +186,160 @@ static LineSegment2D	gPillarsWalls[PILLARS_NUM / 2];
 
 #endif
 
+#if(TEST_CONVEX_POLYGON)
+
+static ConvexPolygon2D	gBlock;
+
+#endif
+
+#if(DETERMINISTIC_SIMULATION)
+
+// Fixed-point copies of the obstacles
+static LineSegment2DFixed	sgRoomLineSegmentsFixed[LINE_SEGMENTS_NUM];
+
+#if(TEST_PART_2)
+static Vector2DFixed		sgPillarsCentersFixed[PILLARS_NUM];
+static Fixed				sgPillarsRadiiFixed[PILLARS_NUM];
+static LineSegment2DFixed	sgPillarsWallsFixed[PILLARS_NUM / 2];
+#endif
+
+#endif
+
+// Every line segment of the level, gathered for the obstacle grid used by the ray casts and distance queries
+static LineSegment2D	gGridLineSegments[GRID_LINE_SEGMENTS_NUM];
+static ObstacleGrid		sgObstacleGrid;
+
 
 // functions to create/destroy a game object instance
-static GameObjectInstance*			GameObjectInstanceCreate(unsigned int ObjectType);			// From OBJECT_TYPE enum
-static void							GameObjectInstanceDestroy(GameObjectInstance* pInst);
+static GameObjectHandle				GameObjectInstanceCreate(unsigned int ObjectType);			// From OBJECT_TYPE enum
+static void							GameObjectInstanceDestroy(GameObjectHandle Handle);
+
+// Handle <-> instance. GameObjectInstanceFromHandle returns 0 for stale and null handles.
+// Don't keep the pointers: only the handles survive the instance being destroyed, moved or restored
+static GameObjectHandle				GameObjectInstanceGetHandle(GameObjectInstance *pInst);
+static GameObjectInstance*			GameObjectInstanceFromHandle(GameObjectHandle Handle);
 
 // ---------------------------------------------------------------------------
 
 // Functions to add/remove components
-static void AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY);
-static void AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType);
-static void AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity);
+// They return 0 if the component couldn't be added (out of archetypes or memory), the instance is left as it was then
+static int AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, Rotation2D *pRotation, float ScaleX, float ScaleY);	// 0 position and rotation: origin and identity
+static int AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType);
+static int AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity);
 
 static void RemoveComponent_Transform(GameObjectInstance *pInst);
 static void RemoveComponent_Sprite(GameObjectInstance *pInst);
 static void RemoveComponent_Physics(GameObjectInstance *pInst);
 
-static GameObjectInstance		*spBall;
-static GameObjectInstance		*spBallVelocityDebugLine;
+// Functions to access the components, 0 if the instance doesn't have the component
+static void* GetComponent(GameObjectInstance *pInst, u32 Component);
+static Component_Sprite* GetComponent_Sprite(GameObjectInstance *pInst);
+static Component_Transform* GetComponent_Transform(GameObjectInstance *pInst);
+static Component_Physics* GetComponent_Physics(GameObjectInstance *pInst);
+
+// Moves the instance to the archetype of its component set plus/minus a component.
+// AddComponent returns 0, and MoveToArchetype 0, if the archetype couldn't be found or grown: the instance stays where it was
+static void* AddComponent(GameObjectInstance *pInst, u32 Component);
+static void RemoveComponent(GameObjectInstance *pInst, u32 Component);
+static int MoveToArchetype(GameObjectInstance *pInst, u32 ComponentMask);
+
+static GameObjectHandle			sgBall;
+
+// The collision detection pushes the frame's contacts here. ContactResponse and the listeners read them after
+static ContactEventBuffer		sgContacts;
+
+static void ContactResponse(void);
+static Vector2D SegmentNormalToward(const LineSegment2D *pSegment, Vector2D Point);
+
+// The update's jobs (see GameStatePlayUpdate)
+static void SimulateJob(void *pData);
+static void UpdateTransforms(u32 ComponentMask, u32 Components);
+static void TransformChunks(void *pData, u32 First, u32 Num);
+
+#if(DRAW_DEBUG)
+static ContactEvent				sgDebugLastContact;		// mBall is HANDLE_NONE until the first contact
+static void DebugContactListener(const ContactEvent *pEvents, u32 Num, void *pContext);
+#endif
+
+#if(DETERMINISTIC_SIMULATION)
+static void BallStepFixed(void);
+#endif
 
 // ---------------------------------------------------------------------------
 
 static int			sgStopped = 0;
 
+// ---------------------------------------------------------------------------
+// Snapshots
+
+#define PLAY_SNAPSHOT_MAGIC			0x50534743					// "CGSP"
+#define PLAY_SNAPSHOT_VERSION		6
+
+/*
+The state as it's stored, so it's saved and restored with a memcpy per array:
+	- the header
+	- the instance slots, with their archetype, row and generation
+	- the archetypes' component masks and row numbers
+	- the rows, archetype by archetype and chunk by chunk: the entity column,
+	  then every component column of the archetype, in component order
+
+Components hold no pointer (shapes are indices, owners are handles), so the
+column bytes are valid as they are
+*/
+typedef struct
+{
+	u32			mMagic;
+	u32			mVersion;
+	u32			mSize;					// Whole snapshot, in bytes
+	u32			mInstanceNum;
+	u32			mBall;					// Handle
+	int			mStopped;
+	u32			mArchetypeNum;
+}PlaySnapshotHeader;
+
+typedef struct
+{
+	u32			mComponentMask;
+	u32			mRowNum;
+}PlaySnapshotArchetype;
+
+// Every instance has a single row, so the rows take at most this much
+#define PLAY_SNAPSHOT_ROW_SIZE_MAX	(sizeof(u32) + sizeof(Component_Sprite) + sizeof(Component_Transform) + sizeof(Component_Physics))
+
+#define PLAY_SNAPSHOT_SIZE		(sizeof(PlaySnapshotHeader) + sizeof(GameObjectInstance) * GAME_OBJ_INST_NUM_MAX + \
+								 sizeof(PlaySnapshotArchetype) * ARCHETYPE_NUM_MAX + PLAY_SNAPSHOT_ROW_SIZE_MAX * GAME_OBJ_INST_NUM_MAX)
+
+static int PlaySnapshotCopyRows(Archetype *pArchetype, u8 *pRows, int Save);
+
 // ---------------------------------------------------------------------------
 
 void GameStatePlayLoad(void)
 {
 	unsigned int i;
-	float CircleAngleStep;
-	int Parts;
+	float circleAngles[CIRCLE_MESH_PARTS + 1], circleSin[CIRCLE_MESH_PARTS + 1], circleCos[CIRCLE_MESH_PARTS + 1];
 	Shape* pShape;
 
+	// Component storage
+	{
+		u32 componentSizes[COMPONENT_NUM];
+
+		componentSizes[COMPONENT_SPRITE] = sizeof(Component_Sprite);
+		componentSizes[COMPONENT_TRANSFORM] = sizeof(Component_Transform);
+		componentSizes[COMPONENT_PHYSICS] = sizeof(Component_Physics);
+
+		ArchetypeWorldInit(&sgWorld, componentSizes, COMPONENT_NUM);
+	}
+
 	// Zero the shapes array
 	memset(sgShapes, 0, sizeof(Shape)* SHAPE_NUM_MAX);
 	// No shapes at this point
 	sgShapeNum = 0;
 
+	// The ball and the pillar share the circle's vertices, all computed at once
+	for (i = 0; i <= CIRCLE_MESH_PARTS; ++i)
+		circleAngles[i] = i * 2 * PI / CIRCLE_MESH_PARTS;
+	SinCosBatch(circleAngles, circleSin, circleCos, CIRCLE_MESH_PARTS + 1, SINCOS_ACCURACY_1E4);
+
 
 	// ===============
 	// create the ball
@@ -166,14 +348,12 @@ void GameStatePlayLoad(void)
 	pShape->mType = OBJECT_TYPE_BALL;
 
 	AEGfxMeshStart();
-	CircleAngleStep = PI / 12.0f, i;
-	Parts = 24;
-	for (i = 0; i < Parts; ++i)
+	for (i = 0; i < CIRCLE_MESH_PARTS; ++i)
 	{
 		AEGfxTriAdd(
 			0.0f, 0.0f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf(i * 2 * PI / Parts)*0.5f, sinf(i * 2 * PI / Parts)*0.5f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf((i + 1) * 2 * PI / Parts)*0.5f, sinf((i + 1) * 2 * PI / Parts)*0.5f, 0xFFFFFF00, 0.0f, 0.0f);
+			circleCos[i]*0.5f, circleSin[i]*0.5f, 0xFFFFFF00, 0.0f, 0.0f,
+			circleCos[i + 1]*0.5f, circleSin[i + 1]*0.5f, 0xFFFFFF00, 0.0f, 0.0f);
 	}
 
 	pShape->mpMesh = AEGfxMeshEnd();
@@ -199,31 +379,52 @@ void GameStatePlayLoad(void)
 	pShape->mType = OBJECT_TYPE_PILLAR;
 
 	AEGfxMeshStart();
-	CircleAngleStep = PI / 12.0f, i;
-	Parts = 24;
-	for (i = 0; i < Parts; ++i)
+	for (i = 0; i < CIRCLE_MESH_PARTS; ++i)
 	{
 		AEGfxTriAdd(
 			0.0f, 0.0f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf(i * 2 * PI / Parts)*0.5f, sinf(i * 2 * PI / Parts)*0.5f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf((i + 1) * 2 * PI / Parts)*0.5f, sinf((i + 1) * 2 * PI / Parts)*0.5f, 0xFFFFFF00, 0.0f, 0.0f);
+			circleCos[i]*0.5f, circleSin[i]*0.5f, 0xFFFFFF00, 0.0f, 0.0f,
+			circleCos[i + 1]*0.5f, circleSin[i + 1]*0.5f, 0xFFFFFF00, 0.0f, 0.0f);
 	}
 
 	pShape->mpMesh = AEGfxMeshEnd();
 
 
-	// =====================
-	// create the debug line
-	// =====================
+#if(TEST_CONVEX_POLYGON)
+	// ================================
+	// create the block, in world space
+	// ================================
+	{
+		Vector2D blockVertices[BLOCK_VERTICES_NUM];
+
+		for (i = 0; i < BLOCK_VERTICES_NUM; ++i)
+		{
+			float sine, cosine;
+
+			SinCos(i * 2 * PI / BLOCK_VERTICES_NUM, &sine, &cosine, SINCOS_ACCURACY_1E7);
+			Vector2DSet(&blockVertices[i], 60.0f + 40.0f * cosine, -90.0f + 25.0f * sine);
+		}
+
+		BuildConvexPolygon2D(&gBlock, blockVertices, BLOCK_VERTICES_NUM);
+	}
+
 	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_DEBUG_LINE;
+	pShape->mType = OBJECT_TYPE_BLOCK;
 
 	AEGfxMeshStart();
+	for (i = 0; i < gBlock.mVertexNum; ++i)
+	{
+		Vector2D *pV0 = &gBlock.mVertices[i];
+		Vector2D *pV1 = &gBlock.mVertices[(i + 1) % gBlock.mVertexNum];
 
-	AEGfxVertexAdd(0.0f, 0.0f, 0xFFFFFFFF, 0.0f, 0.0f);
-	AEGfxVertexAdd(1.0f, 0.0f, 0xFFFFFFFF, 0.0f, 0.0f);
+		AEGfxTriAdd(
+			gBlock.mCenter.x, gBlock.mCenter.y, 0xFF00FF00, 0.0f, 0.0f,
+			pV0->x, pV0->y, 0xFF00FF00, 0.0f, 0.0f,
+			pV1->x, pV1->y, 0xFF00FF00, 0.0f, 0.0f);
+	}
 
 	pShape->mpMesh = AEGfxMeshEnd();
+#endif
 
 
 	// Building map boundaries
@@ -263,6 +464,40 @@ BuildLineSegment2D(&gRoomLineSegments[i], &gRoomPoints[i*2], &gRoomPoints[i*2 +
 		BuildLineSegment2D(&gPillarsWalls[i], &gPillarsCenters[i*2], &gPillarsCenters[i*2 + 1]);
 
 #endif
+
+#if(DETERMINISTIC_SIMULATION)
+	// The float obstacles are exact constants, so their fixed-point copies are the same everywhere
+	for (i = 0; i < LINE_SEGMENTS_NUM; ++i)
+	{
+		Vector2DFixed p0, p1;
+
+		Vector2DFixedFromVector2D(&p0, &gRoomPoints[i * 2]);
+		Vector2DFixedFromVector2D(&p1, &gRoomPoints[i * 2 + 1]);
+		BuildLineSegment2DFixed(&sgRoomLineSegmentsFixed[i], &p0, &p1);
+	}
+
+#if(TEST_PART_2)
+	for (i = 0; i < PILLARS_NUM; ++i)
+	{
+		Vector2DFixedFromVector2D(&sgPillarsCentersFixed[i], &gPillarsCenters[i]);
+		sgPillarsRadiiFixed[i] = FixedFromFloat(gPillarsRadii[i]);
+	}
+
+	for (i = 0; i < PILLARS_NUM / 2; ++i)
+		BuildLineSegment2DFixed(&sgPillarsWallsFixed[i], &sgPillarsCentersFixed[i * 2], &sgPillarsCentersFixed[i * 2 + 1]);
+#endif
+
+#endif
+
+	// Obstacle grid, for the ray casts and the distance queries
+	memcpy(gGridLineSegments, gRoomLineSegments, sizeof(gRoomLineSegments));
+
+#if(TEST_PART_2)
+	memcpy(gGridLineSegments + LINE_SEGMENTS_NUM, gPillarsWalls, sizeof(gPillarsWalls));
+	ObstacleGridBuild(&sgObstacleGrid, gGridLineSegments, GRID_LINE_SEGMENTS_NUM, gPillarsCenters, gPillarsRadii, PILLARS_NUM, 0.0f, 0.0f);
+#else
+	ObstacleGridBuild(&sgObstacleGrid, gGridLineSegments, GRID_LINE_SEGMENTS_NUM, 0, 0, 0, 0.0f, 0.0f);
+#endif
 }
 
 // ---------------------------------------------------------------------------
@@ -271,165 +506,161 @@ void GameStatePlayInit(void)
 {
 	unsigned int i;
 
-	// zero the game object instance array
-	memset(sgGameObjectInstanceList, 0, sizeof(GameObjectInstance)* GAME_OBJ_INST_NUM_MAX);
+	// clear the game object instance array, keeping the generations so the handles from before stay stale
+	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
+		sgGameObjectInstanceList[i].mFlag = 0;
 	// No game object instances (sprites) at this point
 	sgGameObjectInstanceNum = 0;
 
-	spBall = GameObjectInstanceCreate(OBJECT_TYPE_BALL);
- 
-	Vector2DSet(&spBall->mpComponent_Transform->mPosition, 0.0f, 0.0f);
-	spBall->mpComponent_Transform->mScaleX = BALL_RADIUS * 2;
-	spBall->mpComponent_Transform->mScaleY = BALL_RADIUS * 2;
-	Vector2DSet(&spBall->mpComponent_Physics->mVelocity, 130.0f, 110.0f);
+	CollisionStatsReset();
+
+	ContactEventsInit(&sgContacts);
+#if(DRAW_DEBUG)
+	sgDebugLastContact.mBall = HANDLE_NONE;
+	ContactEventsAddListener(&sgContacts, DebugContactListener, 0);
+#endif
+
+	sgBall = GameObjectInstanceCreate(OBJECT_TYPE_BALL);
+	{
+		Component_Transform *pTransform = GetComponent_Transform(GameObjectInstanceFromHandle(sgBall));
+		Component_Physics *pPhysics = GetComponent_Physics(GameObjectInstanceFromHandle(sgBall));
+
+		Vector2DSet(&pTransform->mPosition, 0.0f, 0.0f);
+		pTransform->mScaleX = BALL_RADIUS * 2;
+		pTransform->mScaleY = BALL_RADIUS * 2;
+		Vector2DSet(&pPhysics->mVelocity, 130.0f, 110.0f);
+
+#if(DETERMINISTIC_SIMULATION)
+		Vector2DFixedFromVector2D(&pPhysics->mPositionFixed, &pTransform->mPosition);
+		Vector2DFixedFromVector2D(&pPhysics->mVelocityFixed, &pPhysics->mVelocity);
+#endif
+	}
 
 
 	// Wall instances
 	for(i = 0; i < LINE_SEGMENTS_NUM; ++i)
 	{	
-		float length, angle;
+		float length;
 		Vector2D v;
+		Rotation2D rotation;
 		GameObjectInstance *pWall;
 
-		length = Vector2DDistance(&gRoomPoints[2*i], &gRoomPoints[2*i + 1]);
-		
 		Vector2DSub(&v, &gRoomPoints[2*i + 1], &gRoomPoints[2*i]);
-		Vector2DNormalize(&v, &v);
-		
-		angle = atan2(v.y, v.x);
-		pWall = GameObjectInstanceCreate(OBJECT_TYPE_LINE);
-		pWall->mpComponent_Transform->mPosition = gRoomPoints[2 * i];
-		pWall->mpComponent_Transform->mScaleX = length;
-		pWall->mpComponent_Transform->mScaleY = 5.0f;
-		pWall->mpComponent_Transform->mAngle = angle;
+		length = Vector2DLength(&v);
+		rotation = Rotation2DFromDirection(v);
+
+		pWall = GameObjectInstanceFromHandle(GameObjectInstanceCreate(OBJECT_TYPE_LINE));
+		AddComponent_Transform(pWall, &gRoomPoints[2 * i], &rotation, length, 5.0f);
 	}
 
 #if(TEST_PART_2)
 	// Segments between pillars instances, and pillars instances
 	for(i = 0; i < (PILLARS_NUM >> 1); ++i)
 	{	
-		float length, angle;
+		float length;
 		Vector2D v;
+		Rotation2D rotation;
 		GameObjectInstance *pInst;
 
 		// segments
-		length = Vector2DDistance(&gPillarsCenters[2*i], &gPillarsCenters[2*i + 1]);
-	
 		Vector2DSub(&v, &gPillarsCenters[2*i + 1], &gPillarsCenters[2*i]);
-		Vector2DNormalize(&v, &v);
-		
-		angle = atan2(v.y, v.x);
+		length = Vector2DLength(&v);
+		rotation = Rotation2DFromDirection(v);
 
-		pInst = GameObjectInstanceCreate(OBJECT_TYPE_LINE);
-		pInst->mpComponent_Transform->mPosition = gPillarsCenters[2 * i];
-		pInst->mpComponent_Transform->mScaleX = length;
-		pInst->mpComponent_Transform->mScaleY = 5.0f;
-		pInst->mpComponent_Transform->mAngle = angle;
+		pInst = GameObjectInstanceFromHandle(GameObjectInstanceCreate(OBJECT_TYPE_LINE));
+		AddComponent_Transform(pInst, &gPillarsCenters[2 * i], &rotation, length, 5.0f);
 
 		// Pillars
-		pInst = GameObjectInstanceCreate(OBJECT_TYPE_PILLAR);
-		pInst->mpComponent_Transform->mPosition = gPillarsCenters[2 * i];
-		pInst->mpComponent_Transform->mScaleX = gPillarsRadii[2 * i] * 2;
-		pInst->mpComponent_Transform->mScaleY = gPillarsRadii[2 * i] * 2;
-
-		pInst = GameObjectInstanceCreate(OBJECT_TYPE_PILLAR);
-		pInst->mpComponent_Transform->mPosition = gPillarsCenters[2 * i + 1];
-		pInst->mpComponent_Transform->mScaleX = gPillarsRadii[2 * i + 1] * 2;
-		pInst->mpComponent_Transform->mScaleY = gPillarsRadii[2 * i + 1] * 2;
+		pInst = GameObjectInstanceFromHandle(GameObjectInstanceCreate(OBJECT_TYPE_PILLAR));
+		AddComponent_Transform(pInst, &gPillarsCenters[2 * i], 0, gPillarsRadii[2 * i] * 2, gPillarsRadii[2 * i] * 2);
+
+		pInst = GameObjectInstanceFromHandle(GameObjectInstanceCreate(OBJECT_TYPE_PILLAR));
+		AddComponent_Transform(pInst, &gPillarsCenters[2 * i + 1], 0, gPillarsRadii[2 * i + 1] * 2, gPillarsRadii[2 * i + 1] * 2);
 	}
 #endif
 
-#if(DRAW_DEBUG)
-
-	// Normals of the outer lines
-	for(i = 0; i < LINE_SEGMENTS_NUM; ++i)
-	{	
-		Vector2D pos;
-		float angle;
-		GameObjectInstance *pInst;
-
-		pos.x = (gRoomPoints[2*i].x + gRoomPoints[2*i + 1].x) / 2.0f;
-		pos.y = (gRoomPoints[2*i].y + gRoomPoints[2*i + 1].y) / 2.0f;
-		
-		angle = AEVec2AngleFromVec2(&gRoomLineSegments[i].mN);  //CHECK THIS AAAA
+#if(TEST_CONVEX_POLYGON)
+	// Block instance: its mesh is already in world space, so it keeps the default identity transform
+	GameObjectInstanceCreate(OBJECT_TYPE_BLOCK);
+#endif
 
-		pInst = GameObjectInstanceCreate(OBJECT_TYPE_DEBUG_LINE);
-		pInst->mpComponent_Transform->mPosition = pos;
-		pInst->mpComponent_Transform->mScaleX = 25.0f;
-		pInst->mpComponent_Transform->mScaleY = 5.0f;
-		pInst->mpComponent_Transform->mAngle = angle;
-	}
+	
+	AEGfxSetBackgroundColor(0.0f, 0.0f, 0.0f);
+}
 
-	spBallVelocityDebugLine = GameObjectInstanceCreate(OBJECT_TYPE_DEBUG_LINE);
-	spBallVelocityDebugLine->mpComponent_Transform->mScaleX = 50.0f;
-	spBallVelocityDebugLine->mpComponent_Transform->mScaleY = 1.0f;
+// ---------------------------------------------------------------------------
 
-#if(TEST_PART_2)
-	// Normals of the inner lines
-	for(i = 0; i < (PILLARS_NUM >> 1); ++i)
-	{	
-		Vector2D pos;
-		float angle;
-		GameObjectInstance *pInst;
+void GameStatePlayUpdate(void)
+{
+	JobDecl simulate = { SimulateJob, NULL };
+	JobCounter simulated;
 
-		pos.x = (gPillarsCenters[2*i].x + gPillarsCenters[2*i + 1].x) / 2.0f;
-		pos.y = (gPillarsCenters[2*i].y + gPillarsCenters[2*i + 1].y) / 2.0f;
+	simulated.mValue = 0;
 
-		angle = AEVec2AngleFromVec2(&gPillarsWalls[i].mN);
+	// The update as a job graph: the ball simulation runs beside the transforms of
+	// everything it doesn't move, the transforms of what it moves wait for it
+	JobRun(&simulate, 1, &simulated);
 
-		pInst = GameObjectInstanceCreate(OBJECT_TYPE_DEBUG_LINE);
-		pInst->mpComponent_Transform->mPosition = pos;
-		pInst->mpComponent_Transform->mScaleX = 25.0f;
-		pInst->mpComponent_Transform->mScaleY = 5.0f;
-		pInst->mpComponent_Transform->mAngle = angle;
-	}
-#endif
+	PROFILE_BEGIN(PROFILE_ZONE_TRANSFORM);
+	UpdateTransforms(COMPONENT_BIT(COMPONENT_PHYSICS), 0);
+	PROFILE_END(PROFILE_ZONE_TRANSFORM);
 
-#endif
+	JobWait(&simulated);
 
-	
-	AEGfxSetBackgroundColor(0.0f, 0.0f, 0.0f);
+	PROFILE_BEGIN(PROFILE_ZONE_TRANSFORM);
+	UpdateTransforms(COMPONENT_BIT(COMPONENT_PHYSICS), COMPONENT_BIT(COMPONENT_PHYSICS));
+	PROFILE_END(PROFILE_ZONE_TRANSFORM);
 }
 
 // ---------------------------------------------------------------------------
 
-void GameStatePlayUpdate(void)
+void SimulateJob(void *pData)
 {
-	float smallestT;
-	Vector2D closestIntersectionPoint, r;
-	unsigned int i;
-	Vector2D newBallPos;
-	Vector2D intersectionPoint;
+	int stopStep = 0;
 
+	(void)pData;
 
-	float frameTime = AEFrameRateControllerGetFrameTime();
-	int stopStep = 0;
+	CollisionStatsFrameBegin();
+
+#if(DRAW_DEBUG)
+	if (InputCheckTriggered('D'))		// 'D' to toggle the debug drawing
+		DebugDrawSetEnabled(!DebugDrawIsEnabled());
+#endif
 
 	if (0 == sgStopped)
 	{
-		if (AEInputCheckTriggered('S')) // 'S' to stop the simulation
+		if (InputCheckTriggered('S')) // 'S' to stop the simulation
 			sgStopped = 1;
 	}
 	else
 	{
-		if (AEInputCheckTriggered('R'))	// 'R' to let the simulation run
+		if (InputCheckTriggered('R'))	// 'R' to let the simulation run
 			sgStopped = 0;
 		else
-		if (AEInputCheckTriggered('S'))	// 1 step per 'S' trigger
-		{
-			frameTime = 0.016f;
+		if (InputCheckTriggered('S'))	// 1 step per 'S' trigger
 			stopStep = 1;
-		}
 		else
-		if (AEInputCheckCurr('G'))		// Simulation runs as long as 'G' is pressed
-		{
-			frameTime = 0.016f;
+		if (InputCheckCurr('G'))		// Simulation runs as long as 'G' is pressed
 			stopStep = 1;
-		}
 	}
 
 	if (0 == sgStopped || 1 == stopStep)
 	{
+#if(DETERMINISTIC_SIMULATION)
+
+		// One fixed step per frame, whatever the frame time
+		BallStepFixed();
+
+#else
+
+		unsigned int i;
+		Vector2D newBallPos;
+		ContactEvent contact;
+		Component_Transform *pBallTransform = GetComponent_Transform(GameObjectInstanceFromHandle(sgBall));
+		Component_Physics *pBallPhysics = GetComponent_Physics(GameObjectInstanceFromHandle(sgBall));
+
+		// The steps taken while stopped are 16 ms long
+		float frameTime = stopStep ? 0.016f : InputGetFrameTime();
 
 		// =================
 		// update the input
@@ -437,98 +668,135 @@ void GameStatePlayUpdate(void)
 
 		// Update the positions of objects
 
-		Vector2DScaleAdd(&newBallPos, &spBall->mpComponent_Physics->mVelocity, &spBall->mpComponent_Transform->mPosition, frameTime);
+		Vector2DScaleAdd(&newBallPos, &pBallPhysics->mVelocity, &pBallTransform->mPosition, frameTime);
+
 
+		PROFILE_BEGIN(PROFILE_ZONE_COLLISION);
 
-		smallestT = -1.0f;
+		// No broad phase: every obstacle is a narrow-phase candidate
+		COLLISION_STAT_INC(mBalls);
+		COLLISION_STAT_ADD(mObstacles, OBSTACLES_NUM);
+		COLLISION_STAT_ADD(mCandidates, OBSTACLES_NUM);
+
+		// Detection only: every contact is pushed, the response comes after
+		contact.mBall = sgBall;
 
 		// Collision with line segments
+		contact.mObstacleType = COLLISION_OBSTACLE_LINE_SEGMENT;
 		for(i = 0; i < LINE_SEGMENTS_NUM; ++i)
 		{
-			float t = ReflectAnimatedCircleOnStaticLineSegment(&spBall->mpComponent_Transform->mPosition, &newBallPos, BALL_RADIUS, &gRoomLineSegments[i], &intersectionPoint, &r);
+			contact.mT = AnimatedCircleToStaticLineSegment(&pBallTransform->mPosition, &newBallPos, BALL_RADIUS, &gRoomLineSegments[i], &contact.mPoint);
 
-			if(t > 0.0f && (t < smallestT || smallestT < 0.0f))
+			if (contact.mT > 0.0f)
 			{
-				closestIntersectionPoint = intersectionPoint;
-				smallestT = t;
+				contact.mObstacle = i;
+				contact.mNormal = SegmentNormalToward(&gRoomLineSegments[i], contact.mPoint);
+				ContactEventsPush(&sgContacts, &contact);
 			}
 		}
 
 #if(TEST_PART_2)
 
 		// Collision with pillars (Static circles)
+		contact.mObstacleType = COLLISION_OBSTACLE_CIRCLE;
 		for(i = 0; i < PILLARS_NUM; ++i)
 		{
-			float t = ReflectAnimatedCircleOnStaticCircle(&spBall->mpComponent_Transform->mPosition, &newBallPos, BALL_RADIUS, &gPillarsCenters[i], gPillarsRadii[i], &intersectionPoint, &r);
+			contact.mT = AnimatedCircleToStaticCircle(&pBallTransform->mPosition, &newBallPos, BALL_RADIUS, &gPillarsCenters[i], gPillarsRadii[i], &contact.mPoint);
 
-			if(t > 0.0f && (t < smallestT || smallestT < 0.0f))
+			if (contact.mT > 0.0f)
 			{
-				closestIntersectionPoint = intersectionPoint;
-				smallestT = t;
+				contact.mObstacle = i;
+				contact.mNormal = Vec2Normalize(Vec2Sub(contact.mPoint, gPillarsCenters[i]));
+				ContactEventsPush(&sgContacts, &contact);
 			}
 		}
 
-		// Collision with pillars' walls (Line segments between the static circles)
+		// Collision with pillars' walls (Line segments between the static circles), numbered after the outer lines
+		contact.mObstacleType = COLLISION_OBSTACLE_LINE_SEGMENT;
 		for (i = 0; i < PILLARS_NUM / 2; ++i)
 		{
-			float t = ReflectAnimatedCircleOnStaticLineSegment(&spBall->mpComponent_Transform->mPosition, &newBallPos, BALL_RADIUS, &gPillarsWalls[i], &intersectionPoint, &r);
+			contact.mT = AnimatedCircleToStaticLineSegment(&pBallTransform->mPosition, &newBallPos, BALL_RADIUS, &gPillarsWalls[i], &contact.mPoint);
 
-			if (t > 0.0f && (t < smallestT || smallestT < 0.0f))
+			if (contact.mT > 0.0f)
 			{
-				closestIntersectionPoint = intersectionPoint;
-				smallestT = t;
+				contact.mObstacle = LINE_SEGMENTS_NUM + i;
+				contact.mNormal = SegmentNormalToward(&gPillarsWalls[i], contact.mPoint);
+				ContactEventsPush(&sgContacts, &contact);
 			}
 		}
 
 #endif
 
-		if (smallestT > 0.0)
+#if(TEST_CONVEX_POLYGON)
+
+		// Collision with the block
+		contact.mObstacleType = COLLISION_OBSTACLE_CONVEX_POLYGON;
+		contact.mT = AnimatedCircleToStaticConvexPolygon(&pBallTransform->mPosition, &newBallPos, BALL_RADIUS, &gBlock, &contact.mPoint, &contact.mNormal);
+
+		if (contact.mT > 0.0f)
 		{
-			Vector2DAdd(&spBall->mpComponent_Transform->mPosition, &closestIntersectionPoint, &r);
-			Vector2DNormalize(&r, &r);
-			Vector2DScale(&spBall->mpComponent_Physics->mVelocity, &r, Vector2DLength(&spBall->mpComponent_Physics->mVelocity));
+			contact.mObstacle = 0;
+			ContactEventsPush(&sgContacts, &contact);
 		}
 
-		Vector2DScaleAdd(&spBall->mpComponent_Transform->mPosition, &spBall->mpComponent_Physics->mVelocity, &spBall->mpComponent_Transform->mPosition, frameTime);
+#endif
 
+		PROFILE_END(PROFILE_ZONE_COLLISION);
 
-#if(DRAW_DEBUG)
-		{
-			float cosine, sine, velLength, angle;
+		// Bounces the balls off their earliest contact
+		ContactResponse();
 
-			velLength = Vector2DLength(&spBall->mpComponent_Physics->mVelocity);
-			cosine = spBall->mpComponent_Physics->mVelocity.x / velLength;
-			sine = spBall->mpComponent_Physics->mVelocity.y / velLength;
+		Vector2DScaleAdd(&pBallTransform->mPosition, &pBallPhysics->mVelocity, &pBallTransform->mPosition, frameTime);
 
-			angle = acosf(cosine);
+#endif
+	}
 
-			if (sine < 0)
-				angle = -angle;
+	// Sounds, scores, debug drawing... then the buffer is empty for the next frame
+	ContactEventsDispatch(&sgContacts);
 
-			spBallVelocityDebugLine->mpComponent_Transform->mPosition = spBall->mpComponent_Transform->mPosition;
-			spBallVelocityDebugLine->mpComponent_Transform->mAngle = angle;
-		}
+	CollisionStatsFrameEnd();
+}
 
-#endif
+// ---------------------------------------------------------------------------
 
-	}
+// Archetypes with a transform and, of the components in ComponentMask, exactly Components
+void UpdateTransforms(u32 ComponentMask, u32 Components)
+{
+	unsigned int a;
 
-	//Computing the transformation matrices of the game object instances
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
+	for (a = 0; a < sgWorld.mArchetypeNum; ++a)
 	{
-		Matrix2D scale, rot, trans;
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
+		Archetype *pArchetype = sgWorld.mArchetypes + a;
 
-		// skip non-active object
-		if (0 == (pInst->mFlag & FLAG_ACTIVE))
+		if (0 == (pArchetype->mComponentMask & COMPONENT_BIT(COMPONENT_TRANSFORM)) || Components != (pArchetype->mComponentMask & ComponentMask))
 			continue;
 
-		Matrix2DScale(&scale, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-		Matrix2DRotRad(&rot, pInst->mpComponent_Transform->mAngle);  //CHECK THIS AAAA
-		Matrix2DTranslate(&trans, pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y);
+		// A chunk per batch, only the archetypes with several chunks are spread over the workers
+		JobParallelFor(TransformChunks, pArchetype, pArchetype->mChunkNum, 1);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void TransformChunks(void *pData, u32 First, u32 Num)
+{
+	Archetype *pArchetype = (Archetype *)pData;
+	unsigned int i, c;
+
+	//Computing the transformation matrices of the game object instances, column by column
+	for (c = First; c < First + Num; ++c)
+	{
+		ArchetypeChunk *pChunk = pArchetype->mppChunks[c];
+		Component_Transform *pTransforms = (Component_Transform *)pChunk->mpColumns[COMPONENT_TRANSFORM];
 
-		Matrix2DConcat(&pInst->mpComponent_Transform->mTransform, &trans, &rot);
-		Matrix2DConcat(&pInst->mpComponent_Transform->mTransform, &pInst->mpComponent_Transform->mTransform, &scale);
+		for (i = 0; i < pChunk->mRowNum; ++i)
+		{
+			Component_Transform *pTransform = pTransforms + i;
+
+			// Translation * rotation * scaling, without the concatenations
+			Affine2DScaleRotationTrans(&pTransform->mTransform, pTransform->mScaleX, pTransform->mScaleY, &pTransform->mRotation,
+				pTransform->mPosition.x, pTransform->mPosition.y);
+		}
 	}
 }
 
@@ -536,37 +804,119 @@ void GameStatePlayUpdate(void)
 
 void GameStatePlayDraw(void)
 {
-	unsigned int i;
+	// Built and drawn right away when the update runs on the main thread
+	static RenderSnapshot snapshot;
 
-	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
+	GameStatePlaySnapshot(&snapshot, 0);
+	RenderSnapshotDraw(&snapshot);
+}
 
-	// draw all object in the list
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; i++)
+// ---------------------------------------------------------------------------
+
+void GameStatePlaySnapshot(RenderSnapshot *pSnapshot, u32 Frame)
+{
+	unsigned int i, a, c;
+	const u32 drawMask = COMPONENT_BIT(COMPONENT_SPRITE) | COMPONENT_BIT(COMPONENT_TRANSFORM);
+	Component_Transform *pBallTransform = GetComponent_Transform(GameObjectInstanceFromHandle(sgBall));
+	Component_Physics *pBallPhysics = GetComponent_Physics(GameObjectInstanceFromHandle(sgBall));
+
+	RenderSnapshotClear(pSnapshot, Frame);
+
+	// every instance with a sprite and a transform, column by column
+	for (a = 0; a < sgWorld.mArchetypeNum; ++a)
 	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
+		Archetype *pArchetype = sgWorld.mArchetypes + a;
 
-		// skip non-active object
-		if (0 == (pInst->mFlag & FLAG_ACTIVE))
+		if (drawMask != (pArchetype->mComponentMask & drawMask))
 			continue;
 
-		AEGfxSetTransform(pInst->mpComponent_Transform->mTransform.m);
+		for (c = 0; c < pArchetype->mChunkNum; ++c)
+		{
+			ArchetypeChunk *pChunk = pArchetype->mppChunks[c];
+			Component_Sprite *pSprites = (Component_Sprite *)pChunk->mpColumns[COMPONENT_SPRITE];
+			Component_Transform *pTransforms = (Component_Transform *)pChunk->mpColumns[COMPONENT_TRANSFORM];
+
+			for (i = 0; i < pChunk->mRowNum; ++i)
+			{
+				Shape *pShape = sgShapes + pSprites[i].mShape;
+				u32 drawMode = (OBJECT_TYPE_LINE == pShape->mType) ? AE_GFX_MDM_LINES : AE_GFX_MDM_TRIANGLES;
+
+				RenderSnapshotAddItem(pSnapshot, &pTransforms[i].mTransform, pShape->mpMesh, drawMode);
+			}
+		}
+	}
+
+#if(DRAW_DEBUG)
+	if (DebugDrawIsEnabled())
+	{
+		Vector2D start, end;
 
-		switch (pInst->mpComponent_Sprite->mpShape->mType)
+		// Normals of the outer lines
+		for (i = 0; i < LINE_SEGMENTS_NUM; ++i)
 		{
-		case OBJECT_TYPE_BALL:
-		case OBJECT_TYPE_PILLAR:
-			AEGfxMeshDraw(pInst->mpComponent_Sprite->mpShape->mpMesh, AE_GFX_MDM_TRIANGLES);
+			Vector2DAdd(&start, &gRoomLineSegments[i].mP0, &gRoomLineSegments[i].mP1);
+			Vector2DScale(&start, &start, 0.5f);
+			Vector2DScaleAdd(&end, &gRoomLineSegments[i].mN, &start, DEBUG_NORMAL_LENGTH);
+			DebugDrawArrow(&start, &end, 0xFFFFFFFF);
+		}
 
-			break;
+#if(TEST_PART_2)
+		// Normals of the inner lines
+		for (i = 0; i < PILLARS_NUM / 2; ++i)
+		{
+			Vector2DAdd(&start, &gPillarsWalls[i].mP0, &gPillarsWalls[i].mP1);
+			Vector2DScale(&start, &start, 0.5f);
+			Vector2DScaleAdd(&end, &gPillarsWalls[i].mN, &start, DEBUG_NORMAL_LENGTH);
+			DebugDrawArrow(&start, &end, 0xFFFFFFFF);
+		}
+#endif
 
-		case OBJECT_TYPE_LINE:
-		case OBJECT_TYPE_DEBUG_LINE:
-			AEGfxMeshDraw(pInst->mpComponent_Sprite->mpShape->mpMesh, AE_GFX_MDM_LINES);
+		// Ball velocity
+		Vector2DScaleAdd(&end, &pBallPhysics->mVelocity, &pBallTransform->mPosition, DEBUG_VELOCITY_SCALE);
+		DebugDrawArrow(&pBallTransform->mPosition, &end, 0xFFFF0000);
 
-			break;
+		// Aim ray along the velocity, up to the first obstacle, and the normal there
+		{
+			Ray2D ray;
+			RayHit hit;
+
+			ray.mOrigin = pBallTransform->mPosition;
+			ray.mDirection = pBallPhysics->mVelocity;
+			ray.mMaxDistance = DEBUG_AIM_RAY_LENGTH;
+
+			RayCastBatch(&sgObstacleGrid, &ray, 1, &hit, RAY_CAST_MODE_SINGLE);
+
+			DebugDrawLine(&ray.mOrigin, &hit.mPoint, 0xFF00FFFF);
+
+			if (OBSTACLE_TYPE_NONE != hit.mType)
+			{
+				Vector2DScaleAdd(&end, &hit.mNormal, &hit.mPoint, DEBUG_NORMAL_LENGTH);
+				DebugDrawArrow(&hit.mPoint, &end, 0xFF00FFFF);
+			}
+		}
+
+		// Last contact, and the normal it bounced off
+		if (HANDLE_NONE != sgDebugLastContact.mBall)
+		{
+			Vector2DScaleAdd(&end, &sgDebugLastContact.mNormal, &sgDebugLastContact.mPoint, DEBUG_NORMAL_LENGTH);
+			DebugDrawArrow(&sgDebugLastContact.mPoint, &end, 0xFFFFFF00);
+		}
+
+		// Closest obstacle to the ball
+		{
+			DistanceHit nearest;
+
+			DistanceQueryBatch(&sgObstacleGrid, &pBallTransform->mPosition, 1, DEBUG_PROXIMITY_RANGE, &nearest);
+
+			if (OBSTACLE_TYPE_NONE != nearest.mType)
+				DebugDrawLine(&pBallTransform->mPosition, &nearest.mClosest, 0xFF00FF00);
 		}
 
 	}
+#endif
+
+	// Empty when the debug draw is off
+	RenderSnapshotTakeDebugDraw(pSnapshot);
 }
 
 // ---------------------------------------------------------------------------
@@ -576,7 +926,7 @@ void GameStatePlayFree(void)
 	unsigned int i;
 	// kill all object in the list
 	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; i++)
-		GameObjectInstanceDestroy(sgGameObjectInstanceList + i);
+		GameObjectInstanceDestroy(GameObjectInstanceGetHandle(sgGameObjectInstanceList + i));
 
 	sgGameObjectInstanceNum = 0;
 }
@@ -590,11 +940,335 @@ void GameStatePlayUnload(void)
 	// free all mesh
 	for (i = 0; i < sgShapeNum; i++)
 		AEGfxMeshFree(sgShapes[i].mpMesh);
+
+	ObstacleGridFree(&sgObstacleGrid);
+	ArchetypeWorldFree(&sgWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+// The segment's normal, flipped if needed to point to the side Point is on
+Vector2D SegmentNormalToward(const LineSegment2D *pSegment, Vector2D Point)
+{
+	if (Vec2Dot(pSegment->mN, Vec2Sub(Point, pSegment->mP0)) < 0.0f)
+		return Vec2Neg(pSegment->mN);
+
+	return pSegment->mN;
 }
 
 // ---------------------------------------------------------------------------
 
-GameObjectInstance* GameObjectInstanceCreate(unsigned int ObjectType)			// From OBJECT_TYPE enum)
+/*
+Response pass over the frame's contacts. Each ball bounces off its earliest contact
+only: it's put one unit away from the contact point, along its mirrored direction
+*/
+void ContactResponse(void)
+{
+	u32 i, j, num = ContactEventsNum(&sgContacts);
+
+	for (i = 0; i < num; ++i)
+	{
+		const ContactEvent *pEvent = ContactEventsGet(&sgContacts, i);
+		const ContactEvent *pEarliest = pEvent;
+		GameObjectInstance *pBall;
+		Component_Transform *pTransform;
+		Component_Physics *pPhysics;
+		u32 ballContactNum = 0;
+		Vec2 r;
+
+		// Gather the ball's contacts, unless an earlier event already did
+		for (j = 0; j < num; ++j)
+		{
+			const ContactEvent *pOther = ContactEventsGet(&sgContacts, j);
+
+			if (pOther->mBall != pEvent->mBall)
+				continue;
+
+			if (j < i)
+				break;
+
+			++ballContactNum;
+
+			if (pOther->mT < pEarliest->mT)
+				pEarliest = pOther;
+		}
+
+		if (0 == ballContactNum)
+			continue;
+
+		if (ballContactNum > 1)
+			COLLISION_STAT_INC(mMultiHitBalls);
+
+		pBall = GameObjectInstanceFromHandle(pEarliest->mBall);
+		pTransform = GetComponent_Transform(pBall);
+		pPhysics = GetComponent_Physics(pBall);
+
+		if (0 == pTransform || 0 == pPhysics)
+			continue;
+
+		// The velocity's direction mirrored by the normal: v - 2(v.n)n
+		r = Vec2Normalize(Vec2Sub(pPhysics->mVelocity, Vec2Scale(pEarliest->mNormal, 2 * Vec2Dot(pPhysics->mVelocity, pEarliest->mNormal))));
+
+		pTransform->mPosition = Vec2Add(pEarliest->mPoint, r);
+		pPhysics->mVelocity = Vec2Scale(r, Vec2Length(pPhysics->mVelocity));
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+#if(DRAW_DEBUG)
+
+// Keeps the last contact, for its normal to be drawn
+void DebugContactListener(const ContactEvent *pEvents, u32 Num, void *pContext)
+{
+	(void)pContext;
+
+	if (Num > 0)
+		sgDebugLastContact = pEvents[Num - 1];
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+
+#if(DETERMINISTIC_SIMULATION)
+
+// Fixed-point version of the ball's update: same collisions and response, on integers only
+void BallStepFixed(void)
+{
+	Component_Physics *pPhysics = GetComponent_Physics(GameObjectInstanceFromHandle(sgBall));
+	Vector2DFixed newBallPos, intersectionPoint, closestIntersectionPoint, r, closestR;
+	Fixed radius = FixedFromFloat(BALL_RADIUS);
+	Fixed smallestT = -FIXED_ONE;
+	unsigned int i, hitNum = 0;
+
+	Vector2DFixedScaleAdd(&newBallPos, &pPhysics->mVelocityFixed, &pPhysics->mPositionFixed, DETERMINISTIC_FRAME_TIME);
+
+	PROFILE_BEGIN(PROFILE_ZONE_COLLISION);
+
+	COLLISION_STAT_INC(mBalls);
+	COLLISION_STAT_ADD(mObstacles, OBSTACLES_NUM);
+	COLLISION_STAT_ADD(mCandidates, OBSTACLES_NUM);
+
+	// Collision with line segments
+	for (i = 0; i < LINE_SEGMENTS_NUM; ++i)
+	{
+		Fixed t = ReflectAnimatedCircleOnStaticLineSegmentFixed(&pPhysics->mPositionFixed, &newBallPos, radius, &sgRoomLineSegmentsFixed[i], &intersectionPoint, &r);
+
+		if (t > 0)
+			++hitNum;
+
+		if (t > 0 && (t < smallestT || smallestT < 0))
+		{
+			closestIntersectionPoint = intersectionPoint;
+			closestR = r;
+			smallestT = t;
+		}
+	}
+
+#if(TEST_PART_2)
+
+	// Collision with pillars (Static circles)
+	for (i = 0; i < PILLARS_NUM; ++i)
+	{
+		Fixed t = ReflectAnimatedCircleOnStaticCircleFixed(&pPhysics->mPositionFixed, &newBallPos, radius, &sgPillarsCentersFixed[i], sgPillarsRadiiFixed[i], &intersectionPoint, &r);
+
+		if (t > 0)
+			++hitNum;
+
+		if (t > 0 && (t < smallestT || smallestT < 0))
+		{
+			closestIntersectionPoint = intersectionPoint;
+			closestR = r;
+			smallestT = t;
+		}
+	}
+
+	// Collision with pillars' walls
+	for (i = 0; i < PILLARS_NUM / 2; ++i)
+	{
+		Fixed t = ReflectAnimatedCircleOnStaticLineSegmentFixed(&pPhysics->mPositionFixed, &newBallPos, radius, &sgPillarsWallsFixed[i], &intersectionPoint, &r);
+
+		if (t > 0)
+			++hitNum;
+
+		if (t > 0 && (t < smallestT || smallestT < 0))
+		{
+			closestIntersectionPoint = intersectionPoint;
+			closestR = r;
+			smallestT = t;
+		}
+	}
+
+#endif
+
+	PROFILE_END(PROFILE_ZONE_COLLISION);
+
+	if (hitNum > 1)
+		COLLISION_STAT_INC(mMultiHitBalls);
+
+	// Same response as the float version: restart 1 unit off the contact point, along the reflection, at the same speed
+	if (smallestT > 0)
+	{
+		Vector2DFixedAdd(&pPhysics->mPositionFixed, &closestIntersectionPoint, &closestR);
+		Vector2DFixedScale(&pPhysics->mVelocityFixed, &closestR, Vector2DFixedLength(&pPhysics->mVelocityFixed));
+	}
+
+	Vector2DFixedScaleAdd(&pPhysics->mPositionFixed, &pPhysics->mVelocityFixed, &pPhysics->mPositionFixed, DETERMINISTIC_FRAME_TIME);
+
+	// Rendered copies
+	Vector2DFixedToVector2D(&GetComponent_Transform(GameObjectInstanceFromHandle(sgBall))->mPosition, &pPhysics->mPositionFixed);
+	Vector2DFixedToVector2D(&pPhysics->mVelocity, &pPhysics->mVelocityFixed);
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+
+unsigned int GameStatePlaySnapshotSize(void)
+{
+	return PLAY_SNAPSHOT_SIZE;
+}
+
+// ---------------------------------------------------------------------------
+
+int GameStatePlaySnapshotSave(void *pBuffer, unsigned int Size)
+{
+	PlaySnapshotHeader *pHeader = (PlaySnapshotHeader *)pBuffer;
+	PlaySnapshotArchetype *pArchetypes;
+	u8 *pRows;
+	u32 a;
+
+	if (0 == pBuffer || Size < PLAY_SNAPSHOT_SIZE)
+		return 0;
+
+	pHeader->mMagic = PLAY_SNAPSHOT_MAGIC;
+	pHeader->mVersion = PLAY_SNAPSHOT_VERSION;
+	pHeader->mSize = PLAY_SNAPSHOT_SIZE;
+	pHeader->mInstanceNum = sgGameObjectInstanceNum;
+	pHeader->mBall = sgBall;
+	pHeader->mStopped = sgStopped;
+	pHeader->mArchetypeNum = sgWorld.mArchetypeNum;
+
+	memcpy(pHeader + 1, sgGameObjectInstanceList, sizeof(sgGameObjectInstanceList));
+
+	pArchetypes = (PlaySnapshotArchetype *)((u8 *)(pHeader + 1) + sizeof(sgGameObjectInstanceList));
+	pRows = (u8 *)(pArchetypes + ARCHETYPE_NUM_MAX);
+	memset(pArchetypes, 0, sizeof(PlaySnapshotArchetype) * ARCHETYPE_NUM_MAX);
+
+	for (a = 0; a < sgWorld.mArchetypeNum; ++a)
+	{
+		pArchetypes[a].mComponentMask = sgWorld.mArchetypes[a].mComponentMask;
+		pArchetypes[a].mRowNum = sgWorld.mArchetypes[a].mRowNum;
+
+		pRows += PlaySnapshotCopyRows(sgWorld.mArchetypes + a, pRows, 1);
+	}
+
+	// Same state, same bytes
+	memset(pRows, 0, (u8 *)pBuffer + PLAY_SNAPSHOT_SIZE - pRows);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int GameStatePlaySnapshotRestore(const void *pBuffer, unsigned int Size)
+{
+	const PlaySnapshotHeader *pHeader = (const PlaySnapshotHeader *)pBuffer;
+	const PlaySnapshotArchetype *pArchetypes;
+	const u8 *pRows;
+	u32 a, rowNum = 0;
+
+	if (0 == pBuffer || Size < sizeof(PlaySnapshotHeader) ||
+		PLAY_SNAPSHOT_MAGIC != pHeader->mMagic ||
+		PLAY_SNAPSHOT_VERSION != pHeader->mVersion ||
+		PLAY_SNAPSHOT_SIZE != pHeader->mSize ||
+		Size < PLAY_SNAPSHOT_SIZE ||
+		pHeader->mArchetypeNum > ARCHETYPE_NUM_MAX)
+		return 0;
+
+	pArchetypes = (const PlaySnapshotArchetype *)((const u8 *)(pHeader + 1) + sizeof(sgGameObjectInstanceList));
+	pRows = (const u8 *)(pArchetypes + ARCHETYPE_NUM_MAX);
+
+	// Archetypes never move, so the saved ones are still at the same indices, or were freed with the world.
+	// Checked before anything changes, the state is left as it was if the snapshot doesn't fit
+	for (a = 0; a < pHeader->mArchetypeNum; ++a)
+	{
+		if (a < sgWorld.mArchetypeNum && sgWorld.mArchetypes[a].mComponentMask != pArchetypes[a].mComponentMask)
+			return 0;
+
+		rowNum += pArchetypes[a].mRowNum;
+	}
+
+	if (rowNum > GAME_OBJ_INST_NUM_MAX)
+		return 0;
+
+	for (a = 0; a < pHeader->mArchetypeNum; ++a)
+		if (a >= sgWorld.mArchetypeNum && a != ArchetypeWorldFind(&sgWorld, pArchetypes[a].mComponentMask))
+			return 0;
+
+	// Grown first, so an allocation failure leaves the rows untouched
+	for (a = 0; a < pHeader->mArchetypeNum; ++a)
+		if (pArchetypes[a].mRowNum > sgWorld.mArchetypes[a].mRowNum && 0 == ArchetypeSetRowNum(sgWorld.mArchetypes + a, pArchetypes[a].mRowNum))
+			return 0;
+
+	// The archetypes created since the save are emptied
+	for (a = 0; a < sgWorld.mArchetypeNum; ++a)
+	{
+		ArchetypeSetRowNum(sgWorld.mArchetypes + a, (a < pHeader->mArchetypeNum) ? pArchetypes[a].mRowNum : 0);
+
+		if (a < pHeader->mArchetypeNum)
+			pRows += PlaySnapshotCopyRows(sgWorld.mArchetypes + a, (u8 *)pRows, 0);
+	}
+
+	memcpy(sgGameObjectInstanceList, pHeader + 1, sizeof(sgGameObjectInstanceList));
+
+	sgGameObjectInstanceNum = pHeader->mInstanceNum;
+	sgBall = pHeader->mBall;
+	sgStopped = pHeader->mStopped;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+Copies an archetype's rows to (Save) or from the snapshot's rows, a column of a chunk at a time.
+Returns the number of bytes copied
+*/
+int PlaySnapshotCopyRows(Archetype *pArchetype, u8 *pRows, int Save)
+{
+	u8 *pStart = pRows;
+	u32 c, component;
+
+	for (c = 0; c < pArchetype->mChunkNum; ++c)
+	{
+		ArchetypeChunk *pChunk = pArchetype->mppChunks[c];
+		u32 size = sizeof(u32) * pChunk->mRowNum;
+
+		if (0 == pChunk->mRowNum)
+			break;
+
+		memcpy(Save ? pRows : (u8 *)pChunk->mpEntities, Save ? (u8 *)pChunk->mpEntities : pRows, size);
+		pRows += size;
+
+		for (component = 0; component < COMPONENT_NUM; ++component)
+		{
+			if (0 == pChunk->mpColumns[component])
+				continue;
+
+			size = pArchetype->mComponentSizes[component] * pChunk->mRowNum;
+			memcpy(Save ? pRows : (u8 *)pChunk->mpColumns[component], Save ? (u8 *)pChunk->mpColumns[component] : pRows, size);
+			pRows += size;
+		}
+	}
+
+	return (int)(pRows - pStart);
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectHandle GameObjectInstanceCreate(unsigned int ObjectType)			// From OBJECT_TYPE enum)
 {
 	unsigned long i;
 
@@ -608,122 +1282,181 @@ GameObjectInstance* GameObjectInstanceCreate(unsigned int ObjectType)			// From
 		{
 			// It is not used => use it to create the new instance
 
-			// Active the game object instance
-			pInst->mFlag = FLAG_ACTIVE;
+			int added = 1;
+
+			// Active the game object instance, with no components yet
+			pInst->mArchetype = ArchetypeWorldFind(&sgWorld, 0);
+
+			if (ARCHETYPE_NONE == pInst->mArchetype)
+				return HANDLE_NONE;
+
+			pInst->mRow = ArchetypeAddRow(&sgWorld.mArchetypes[pInst->mArchetype], i);
 
-			pInst->mpComponent_Transform = 0;
-			pInst->mpComponent_Sprite = 0;
-			pInst->mpComponent_Physics = 0;
+			if (ARCHETYPE_NONE == pInst->mRow)
+				return HANDLE_NONE;
+
+			pInst->mFlag = FLAG_ACTIVE;
+			pInst->mGeneration = (pInst->mGeneration % HANDLE_GENERATION_MASK) + 1;
+			++sgGameObjectInstanceNum;
 
 			// Add the components, based on the object type
 			switch (ObjectType)
 			{
 			case OBJECT_TYPE_BALL:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_BALL);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				AddComponent_Physics(pInst, 0);
+				added = AddComponent_Sprite(pInst, OBJECT_TYPE_BALL) && AddComponent_Transform(pInst, 0, 0, 1.0f, 1.0f) && AddComponent_Physics(pInst, 0);
 				break;
 
 			case OBJECT_TYPE_LINE:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_LINE);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
+				added = AddComponent_Sprite(pInst, OBJECT_TYPE_LINE) && AddComponent_Transform(pInst, 0, 0, 1.0f, 1.0f);
 				break;
 
 			case OBJECT_TYPE_PILLAR:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_PILLAR);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
+				added = AddComponent_Sprite(pInst, OBJECT_TYPE_PILLAR) && AddComponent_Transform(pInst, 0, 0, 1.0f, 1.0f);
 				break;
 
-			case OBJECT_TYPE_DEBUG_LINE:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_DEBUG_LINE);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
+			case OBJECT_TYPE_BLOCK:
+				added = AddComponent_Sprite(pInst, OBJECT_TYPE_BLOCK) && AddComponent_Transform(pInst, 0, 0, 1.0f, 1.0f);
 				break;
 			}
 
-			++sgGameObjectInstanceNum;
+			// No half built instances
+			if (0 == added)
+			{
+				GameObjectInstanceDestroy(GameObjectInstanceGetHandle(pInst));
+				return HANDLE_NONE;
+			}
 
 			// return the newly created instance
-			return pInst;
+			return GameObjectInstanceGetHandle(pInst);
 		}
 	}
 
-	// Cannot find empty slot => return 0
-	return 0;
+	// Cannot find empty slot => return the null handle
+	return HANDLE_NONE;
 }
 
 // ---------------------------------------------------------------------------
 
-void GameObjectInstanceDestroy(GameObjectInstance* pInst)
+void GameObjectInstanceDestroy(GameObjectHandle Handle)
 {
+	GameObjectInstance *pInst = GameObjectInstanceFromHandle(Handle);
+
 	// if instance is destroyed before, just return
-	if (pInst->mFlag == 0)
+	if (0 == pInst)
 		return;
 
 	// Zero out the mFlag
 	pInst->mFlag = 0;
 
-	RemoveComponent_Transform(pInst);
-	RemoveComponent_Sprite(pInst);
-	RemoveComponent_Physics(pInst);
+	// Free its row, whatever its components: removing them one by one would move it through every smaller archetype
+	{
+		u32 moved = ArchetypeRemoveRow(&sgWorld.mArchetypes[pInst->mArchetype], pInst->mRow);
+
+		if (ARCHETYPE_NONE != moved)
+			sgGameObjectInstanceList[moved].mRow = pInst->mRow;
+	}
 
 	--sgGameObjectInstanceNum;
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY)
+GameObjectHandle GameObjectInstanceGetHandle(GameObjectInstance *pInst)
+{
+	if (0 == pInst || 0 == (pInst->mFlag & FLAG_ACTIVE))
+		return HANDLE_NONE;
+
+	return MAKE_HANDLE(pInst - sgGameObjectInstanceList, pInst->mGeneration);
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectInstance* GameObjectInstanceFromHandle(GameObjectHandle Handle)
+{
+	GameObjectInstance *pInst;
+
+	if (HANDLE_INDEX(Handle) >= GAME_OBJ_INST_NUM_MAX)
+		return 0;
+
+	pInst = sgGameObjectInstanceList + HANDLE_INDEX(Handle);
+
+	// Destroyed, or reused since
+	if (0 == (pInst->mFlag & FLAG_ACTIVE) || pInst->mGeneration != HANDLE_GENERATION(Handle))
+		return 0;
+
+	return pInst;
+}
+
+// ---------------------------------------------------------------------------
+
+int AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, Rotation2D *pRotation, float ScaleX, float ScaleY)
 {
 	if (0 != pInst)
 	{
-		if (0 == pInst->mpComponent_Transform)
-		{
-			pInst->mpComponent_Transform = (Component_Transform *)calloc(1, sizeof(Component_Transform));
-		}
+		Component_Transform *pTransform = GetComponent_Transform(pInst);
+
+		if (0 == pTransform)
+			pTransform = (Component_Transform *)AddComponent(pInst, COMPONENT_TRANSFORM);
+
+		if (0 == pTransform)
+			return 0;
 
 		Vector2D zeroVec2;
 		Vector2DZero(&zeroVec2);
 
-		pInst->mpComponent_Transform->mScaleX = ScaleX;
-		pInst->mpComponent_Transform->mScaleY = ScaleY;
-		pInst->mpComponent_Transform->mPosition = pPosition ? *pPosition : zeroVec2;;
-		pInst->mpComponent_Transform->mAngle = Angle;
-		pInst->mpComponent_Transform->mpOwner = pInst;
+		pTransform->mScaleX = ScaleX;
+		pTransform->mScaleY = ScaleY;
+		pTransform->mPosition = pPosition ? *pPosition : zeroVec2;
+		pTransform->mRotation = pRotation ? *pRotation : Rotation2DIdentity();
+		pTransform->mOwner = GameObjectInstanceGetHandle(pInst);
 	}
+
+	return 1;
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType)
+int AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType)
 {
 	if (0 != pInst)
 	{
-		if (0 == pInst->mpComponent_Sprite)
-		{
-			pInst->mpComponent_Sprite = (Component_Sprite *)calloc(1, sizeof(Component_Sprite));
-		}
+		Component_Sprite *pSprite = GetComponent_Sprite(pInst);
 
-		pInst->mpComponent_Sprite->mpShape = sgShapes + ShapeType;
-		pInst->mpComponent_Sprite->mpOwner = pInst;
+		if (0 == pSprite)
+			pSprite = (Component_Sprite *)AddComponent(pInst, COMPONENT_SPRITE);
+
+		if (0 == pSprite)
+			return 0;
+
+		pSprite->mShape = ShapeType;
+		pSprite->mOwner = GameObjectInstanceGetHandle(pInst);
 	}
+
+	return 1;
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity)
+int AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity)
 {
 	if (0 != pInst)
 	{
-		if (0 == pInst->mpComponent_Physics)
-		{
-			pInst->mpComponent_Physics = (Component_Physics *)calloc(1, sizeof(Component_Physics));
-		}
+		Component_Physics *pPhysics = GetComponent_Physics(pInst);
+
+		if (0 == pPhysics)
+			pPhysics = (Component_Physics *)AddComponent(pInst, COMPONENT_PHYSICS);
+
+		if (0 == pPhysics)
+			return 0;
 
 		Vector2D zeroVec2;
 		Vector2DZero(&zeroVec2);
 
-		pInst->mpComponent_Physics->mVelocity = pVelocity ? *pVelocity : zeroVec2;
-		pInst->mpComponent_Physics->mpOwner = pInst;
+		pPhysics->mVelocity = pVelocity ? *pVelocity : zeroVec2;
+		pPhysics->mOwner = GameObjectInstanceGetHandle(pInst);
 	}
+
+	return 1;
 }
 
 // ---------------------------------------------------------------------------
@@ -731,13 +1464,7 @@ void AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity)
 void RemoveComponent_Transform(GameObjectInstance *pInst)
 {
 	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Transform)
-		{
-			free(pInst->mpComponent_Transform);
-			pInst->mpComponent_Transform = 0;
-		}
-	}
+		RemoveComponent(pInst, COMPONENT_TRANSFORM);
 }
 
 // ---------------------------------------------------------------------------
@@ -745,13 +1472,7 @@ void RemoveComponent_Transform(GameObjectInstance *pInst)
 void RemoveComponent_Sprite(GameObjectInstance *pInst)
 {
 	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Sprite)
-		{
-			free(pInst->mpComponent_Sprite);
-			pInst->mpComponent_Sprite = 0;
-		}
-	}
+		RemoveComponent(pInst, COMPONENT_SPRITE);
 }
 
 // ---------------------------------------------------------------------------
@@ -759,13 +1480,84 @@ void RemoveComponent_Sprite(GameObjectInstance *pInst)
 void RemoveComponent_Physics(GameObjectInstance *pInst)
 {
 	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Physics)
-		{
-			free(pInst->mpComponent_Physics);
-			pInst->mpComponent_Physics = 0;
-		}
-	}
+		RemoveComponent(pInst, COMPONENT_PHYSICS);
+}
+
+// ---------------------------------------------------------------------------
+
+void* GetComponent(GameObjectInstance *pInst, u32 Component)
+{
+	if (0 == pInst || 0 == (pInst->mFlag & FLAG_ACTIVE))
+		return 0;
+
+	return ArchetypeGetComponent(&sgWorld.mArchetypes[pInst->mArchetype], pInst->mRow, Component);
+}
+
+// ---------------------------------------------------------------------------
+
+Component_Sprite* GetComponent_Sprite(GameObjectInstance *pInst)
+{
+	return (Component_Sprite *)GetComponent(pInst, COMPONENT_SPRITE);
+}
+
+// ---------------------------------------------------------------------------
+
+Component_Transform* GetComponent_Transform(GameObjectInstance *pInst)
+{
+	return (Component_Transform *)GetComponent(pInst, COMPONENT_TRANSFORM);
+}
+
+// ---------------------------------------------------------------------------
+
+Component_Physics* GetComponent_Physics(GameObjectInstance *pInst)
+{
+	return (Component_Physics *)GetComponent(pInst, COMPONENT_PHYSICS);
+}
+
+// ---------------------------------------------------------------------------
+
+void* AddComponent(GameObjectInstance *pInst, u32 Component)
+{
+	if (0 == MoveToArchetype(pInst, sgWorld.mArchetypes[pInst->mArchetype].mComponentMask | COMPONENT_BIT(Component)))
+		return 0;
+
+	return ArchetypeGetComponent(&sgWorld.mArchetypes[pInst->mArchetype], pInst->mRow, Component);
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent(GameObjectInstance *pInst, u32 Component)
+{
+	MoveToArchetype(pInst, sgWorld.mArchetypes[pInst->mArchetype].mComponentMask & ~COMPONENT_BIT(Component));
 }
 
-// ---------------------------------------------------------------------------
\ No newline at end of file
+// ---------------------------------------------------------------------------
+
+int MoveToArchetype(GameObjectInstance *pInst, u32 ComponentMask)
+{
+	u32 archetype, row, moved;
+
+	if (sgWorld.mArchetypes[pInst->mArchetype].mComponentMask == ComponentMask)
+		return 1;
+
+	archetype = ArchetypeWorldFind(&sgWorld, ComponentMask);
+
+	if (ARCHETYPE_NONE == archetype)
+		return 0;
+
+	moved = ArchetypeMoveRow(&sgWorld.mArchetypes[pInst->mArchetype], pInst->mRow, &sgWorld.mArchetypes[archetype], &row);
+
+	// The new chunk couldn't be allocated: the row wasn't removed from the current archetype
+	if (ARCHETYPE_NONE == row)
+		return 0;
+
+	if (ARCHETYPE_NONE != moved)
+		sgGameObjectInstanceList[moved].mRow = pInst->mRow;
+
+	pInst->mArchetype = archetype;
+	pInst->mRow = row;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
@@ -13,6 +13,10 @@
 
 // ---------------------------------------------------------------------------
 
+#include "RenderSnapshot.h"
+
+// ---------------------------------------------------------------------------
+
 void GameStatePlayLoad(void);
 void GameStatePlayInit(void);
 void GameStatePlayUpdate(void);
@@ -20,6 +24,22 @@ void GameStatePlayDraw(void);
 void GameStatePlayFree(void);
 void GameStatePlayUnload(void);
 
+/*
+Fills pSnapshot with what GameStatePlayDraw would draw: the sprites and, when on,
+the debug draw. Call on the thread running the update, right after it
+*/
+void GameStatePlaySnapshot(RenderSnapshot *pSnapshot, u32 Frame);
+
+/*
+Snapshots of the whole simulation state (instances, components and ball) as a flat blob.
+Pointers are stored as pool indices, so a snapshot can be restored any number of times,
+into the same loaded state, without any allocation.
+Save/Restore return 0 if the buffer is too small (or not a valid snapshot), 1 otherwise
+*/
+unsigned int GameStatePlaySnapshotSize(void);
+int GameStatePlaySnapshotSave(void *pBuffer, unsigned int Size);
+int GameStatePlaySnapshotRestore(const void *pBuffer, unsigned int Size);
+
 // ---------------------------------------------------------------------------
 
 #endif // GAME_STATE_PLAY_H
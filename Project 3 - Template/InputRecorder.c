@@ -0,0 +1,283 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	InputRecorder.c
+// Creation Date	:	2026/10/19
+// Purpose			:	records the polled input and frame time of every frame
+//						into a compact binary log, and feeds it back
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "InputRecorder.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define INPUT_LOG_VERSION			1
+#define INPUT_LOG_KEY_NUM_MAX		8					// One bit per key in each mask
+#define INPUT_LOG_HEADER_SIZE		6					// Magic + version + key count
+#define INPUT_LOG_FRAME_SIZE		6					// Frame time + triggered mask + current mask
+
+/*
+Log layout:
+	char	magic[4]			"CGIR"
+	u8		version
+	u8		keyNum
+	u8		keys[keyNum]
+	then for every frame:
+	f32		frameTime
+	u8		triggered mask		(bit i <=> keys[i])
+	u8		current mask		(bit i <=> keys[i])
+*/
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+// Keys polled by the game states. Any other key is passed through live and reads as released while replaying
+static const u8		sgRecordedKeys[] = { 'S', 'R', 'G' };
+#define RECORDED_KEY_NUM	(sizeof(sgRecordedKeys) / sizeof(sgRecordedKeys[0]))
+
+static unsigned int	sgMode = INPUT_RECORDER_MODE_LIVE;
+static FILE			*spLogFile;								// Record only
+
+static u8			*spLogData;								// Replay only: the whole log
+static u8			*spLogCursor;
+static u8			*spLogEnd;
+static u8			sgLogKeys[INPUT_LOG_KEY_NUM_MAX];
+static u8			sgLogKeyNum;
+
+static u32			sgFrameCount;
+
+// Current frame
+static f32			sgFrameTime;
+static u8			sgTriggeredMask;
+static u8			sgCurrMask;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static int KeyIndex(const u8 *pKeys, u8 keyNum, u8 key);
+
+// ---------------------------------------------------------------------------
+
+int InputRecorderStartRecord(const char *pFileName)
+{
+	u8 header[INPUT_LOG_HEADER_SIZE];
+
+	InputRecorderStop();
+
+	spLogFile = fopen(pFileName, "wb");
+	if (0 == spLogFile)
+		return 0;
+
+	header[0] = 'C';
+	header[1] = 'G';
+	header[2] = 'I';
+	header[3] = 'R';
+	header[4] = INPUT_LOG_VERSION;
+	header[5] = (u8)RECORDED_KEY_NUM;
+
+	fwrite(header, 1, INPUT_LOG_HEADER_SIZE, spLogFile);
+	fwrite(sgRecordedKeys, 1, RECORDED_KEY_NUM, spLogFile);
+
+	sgMode = INPUT_RECORDER_MODE_RECORD;
+	sgFrameCount = 0;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int InputRecorderStartReplay(const char *pFileName)
+{
+	FILE *pFile;
+	long size;
+
+	InputRecorderStop();
+
+	pFile = fopen(pFileName, "rb");
+	if (0 == pFile)
+		return 0;
+
+	fseek(pFile, 0, SEEK_END);
+	size = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+
+	if (size < INPUT_LOG_HEADER_SIZE)
+	{
+		fclose(pFile);
+		return 0;
+	}
+
+	spLogData = (u8 *)malloc(size);
+	if (0 == spLogData || (size_t)size != fread(spLogData, 1, size, pFile))
+	{
+		fclose(pFile);
+		InputRecorderStop();
+		return 0;
+	}
+	fclose(pFile);
+
+	if (0 != memcmp(spLogData, "CGIR", 4) ||
+		INPUT_LOG_VERSION != spLogData[4] ||
+		INPUT_LOG_KEY_NUM_MAX < spLogData[5] ||
+		size < INPUT_LOG_HEADER_SIZE + spLogData[5])
+	{
+		InputRecorderStop();
+		return 0;
+	}
+
+	sgLogKeyNum = spLogData[5];
+	memcpy(sgLogKeys, spLogData + INPUT_LOG_HEADER_SIZE, sgLogKeyNum);
+
+	spLogCursor = spLogData + INPUT_LOG_HEADER_SIZE + sgLogKeyNum;
+	spLogEnd = spLogData + size;
+
+	sgMode = INPUT_RECORDER_MODE_REPLAY;
+	sgFrameCount = 0;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void InputRecorderStop(void)
+{
+	if (0 != spLogFile)
+	{
+		fclose(spLogFile);
+		spLogFile = 0;
+	}
+
+	if (0 != spLogData)
+	{
+		free(spLogData);
+		spLogData = 0;
+	}
+
+	spLogCursor = spLogEnd = 0;
+	sgMode = INPUT_RECORDER_MODE_LIVE;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int InputRecorderGetMode(void)
+{
+	return sgMode;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 InputRecorderGetFrameCount(void)
+{
+	return sgFrameCount;
+}
+
+// ---------------------------------------------------------------------------
+
+int InputRecorderFrameStart(void)
+{
+	unsigned int i;
+
+	switch (sgMode)
+	{
+	case INPUT_RECORDER_MODE_RECORD:
+		sgFrameTime = (f32)AEFrameRateControllerGetFrameTime();
+		sgTriggeredMask = 0;
+		sgCurrMask = 0;
+
+		for (i = 0; i < RECORDED_KEY_NUM; ++i)
+		{
+			if (AEInputCheckTriggered(sgRecordedKeys[i]))
+				sgTriggeredMask |= 1 << i;
+			if (AEInputCheckCurr(sgRecordedKeys[i]))
+				sgCurrMask |= 1 << i;
+		}
+
+		fwrite(&sgFrameTime, sizeof(f32), 1, spLogFile);
+		fwrite(&sgTriggeredMask, 1, 1, spLogFile);
+		fwrite(&sgCurrMask, 1, 1, spLogFile);
+
+		++sgFrameCount;
+		return 1;
+
+	case INPUT_RECORDER_MODE_REPLAY:
+		if (spLogEnd - spLogCursor < INPUT_LOG_FRAME_SIZE)
+			return 0;
+
+		memcpy(&sgFrameTime, spLogCursor, sizeof(f32));
+		sgTriggeredMask = spLogCursor[4];
+		sgCurrMask = spLogCursor[5];
+		spLogCursor += INPUT_LOG_FRAME_SIZE;
+
+		++sgFrameCount;
+		return 1;
+	}
+
+	// Live: latched too, so the update reads the same value all frame, even on its own thread (see GameStateMgr.c)
+	sgFrameTime = (f32)AEFrameRateControllerGetFrameTime();
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+u8 InputCheckTriggered(u8 key)
+{
+	int i;
+
+	switch (sgMode)
+	{
+	case INPUT_RECORDER_MODE_RECORD:
+		i = KeyIndex(sgRecordedKeys, RECORDED_KEY_NUM, key);
+		return (i < 0) ? AEInputCheckTriggered(key) : ((sgTriggeredMask >> i) & 1);
+
+	case INPUT_RECORDER_MODE_REPLAY:
+		i = KeyIndex(sgLogKeys, sgLogKeyNum, key);
+		return (i < 0) ? 0 : ((sgTriggeredMask >> i) & 1);
+	}
+
+	return AEInputCheckTriggered(key);
+}
+
+// ---------------------------------------------------------------------------
+
+u8 InputCheckCurr(u8 key)
+{
+	int i;
+
+	switch (sgMode)
+	{
+	case INPUT_RECORDER_MODE_RECORD:
+		i = KeyIndex(sgRecordedKeys, RECORDED_KEY_NUM, key);
+		return (i < 0) ? AEInputCheckCurr(key) : ((sgCurrMask >> i) & 1);
+
+	case INPUT_RECORDER_MODE_REPLAY:
+		i = KeyIndex(sgLogKeys, sgLogKeyNum, key);
+		return (i < 0) ? 0 : ((sgCurrMask >> i) & 1);
+	}
+
+	return AEInputCheckCurr(key);
+}
+
+// ---------------------------------------------------------------------------
+
+f32 InputGetFrameTime(void)
+{
+	return sgFrameTime;
+}
+
+// ---------------------------------------------------------------------------
+
+int KeyIndex(const u8 *pKeys, u8 keyNum, u8 key)
+{
+	int i;
+
+	for (i = 0; i < keyNum; ++i)
+		if (pKeys[i] == key)
+			return i;
+
+	return -1;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	InputRecorder.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the input recorder/replayer
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+
+// ---------------------------------------------------------------------------
+// Defines/Enums
+
+enum INPUT_RECORDER_MODE
+{
+	INPUT_RECORDER_MODE_LIVE = 0,		// Input comes straight from the Alpha Engine
+	INPUT_RECORDER_MODE_RECORD,			// Input comes from the Alpha Engine and is written to the log
+	INPUT_RECORDER_MODE_REPLAY			// Input comes from the log
+};
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Starts writing every frame's input and frame time to "pFileName".
+Returns 1 on success, 0 if the file could not be opened.
+*/
+int InputRecorderStartRecord(const char *pFileName);
+
+/*
+Loads the whole log "pFileName" in memory and starts feeding it back.
+Returns 1 on success, 0 if the file could not be read or is not a valid log.
+*/
+int InputRecorderStartReplay(const char *pFileName);
+
+/*
+Flushes/frees the current log and goes back to live input
+*/
+void InputRecorderStop(void);
+
+unsigned int InputRecorderGetMode(void);
+
+// Number of frames recorded or replayed so far
+u32 InputRecorderGetFrameCount(void);
+
+/*
+Call once per frame, right after AEInputUpdate.
+ - Record:	samples the recorded keys and frame time and appends them to the log
+ - Replay:	loads the next frame from the log
+ - Live:	latches the frame time
+
+ - Returned value: 0 once the replay log is exhausted, 1 otherwise
+*/
+int InputRecorderFrameStart(void);
+
+// Game states poll the input through these instead of the AEInput functions,
+// so the same code runs live, while recording and while replaying
+u8 InputCheckTriggered(u8 key);
+u8 InputCheckCurr(u8 key);
+f32 InputGetFrameTime(void);
+
+// ---------------------------------------------------------------------------
+
+#endif // INPUT_RECORDER_H
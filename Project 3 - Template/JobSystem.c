@@ -0,0 +1,529 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	JobSystem.c
+// Creation Date	:	2026/10/19
+// Purpose			:	fiber job system: a fixed pool of workers running jobs
+//						from one queue, waiting on counters by switching fibers
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "JobSystem.h"
+
+// Fibers never move to another thread, so the thread locals need no fiber-safe compilation (/GT)
+#ifdef _MSC_VER
+#define JOB_THREAD_LOCAL			__declspec(thread)
+#else
+#define JOB_THREAD_LOCAL			__thread
+#endif
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct
+{
+	JobDecl				mJob;
+	JobCounter			*mpCounter;
+}JobEntry;
+
+// ---------------------------------------------------------------------------
+
+// A job parked in JobWait, on its own fiber
+typedef struct
+{
+	void				*mpFiber;
+	JobCounter			*mpCounter;
+}JobWaiter;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	u32					mIndex;
+	HANDLE				mThread;
+	HANDLE				mWake;									// Auto reset: a job was queued, or a counter reached 0
+	void				*mpThreadFiber;							// The thread itself, back to it to exit
+
+	// Only touched by the worker's thread, but mWaiterNum, read by the wake-ups
+	void				*mpFibers[JOB_FIBER_NUM_PER_WORKER];	// All of them, to delete them
+	void				*mpFreeFibers[JOB_FIBER_NUM_PER_WORKER];	// Parked in WorkerLoop
+	u32					mFreeNum;
+	JobWaiter			mWaiters[JOB_FIBER_NUM_PER_WORKER];
+	volatile LONG		mWaiterNum;
+}JobWorker;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	JobRangeFunction	mpFunction;
+	void				*mpData;
+	u32					mFirst;
+	u32					mNum;
+}JobRange;
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+static JobWorker				sgWorkers[JOB_THREAD_NUM_MAX];			// 0 is unused: the threads outside the pool
+static u32						sgWorkerNum;
+static volatile LONG			sgWorkerLimit;
+static volatile LONG			sgRunning;
+static volatile LONG			sgQuit;
+
+static CRITICAL_SECTION			sgQueueLock;
+static JobEntry					sgQueue[JOB_QUEUE_SIZE];
+static u32						sgQueueRead;							// Free running
+static u32						sgQueueWrite;
+
+static HANDLE					sgExternalWake;							// Auto reset, for the threads outside the pool
+
+static JOB_THREAD_LOCAL JobWorker	*spWorker;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void StopWorkers(void);
+static DWORD WINAPI WorkerThread(LPVOID pParam);
+static void CALLBACK WorkerFiber(void *pParam);
+static void WorkerLoop(JobWorker *pWorker);
+static void* TakeReadyWaiter(JobWorker *pWorker);
+static int PopJob(JobEntry *pEntry);
+static void RunJob(const JobEntry *pEntry);
+static void WakeAll(void);
+static void RunRange(void *pData);
+
+// ---------------------------------------------------------------------------
+
+int JobSystemInit(u32 WorkerNum)
+{
+	SYSTEM_INFO systemInfo;
+	u32 w, f;
+
+	if (sgRunning)
+		return 1;
+
+	if (0 == WorkerNum)
+	{
+		GetSystemInfo(&systemInfo);
+		WorkerNum = (systemInfo.dwNumberOfProcessors > 1) ? systemInfo.dwNumberOfProcessors - 1 : 0;
+	}
+	WorkerNum = (WorkerNum < JOB_THREAD_NUM_MAX - 1) ? WorkerNum : JOB_THREAD_NUM_MAX - 1;
+
+	memset(sgWorkers, 0, sizeof(sgWorkers));
+	sgWorkerNum = 0;
+	sgWorkerLimit = WorkerNum;
+	sgQuit = 0;
+	sgQueueRead = sgQueueWrite = 0;
+
+	InitializeCriticalSection(&sgQueueLock);
+
+	sgExternalWake = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (NULL == sgExternalWake)
+	{
+		DeleteCriticalSection(&sgQueueLock);
+		return 0;
+	}
+
+	for (w = 1; w <= WorkerNum; ++w)
+	{
+		JobWorker *pWorker = sgWorkers + w;
+
+		pWorker->mIndex = w;
+		pWorker->mWake = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+		for (f = 0; pWorker->mWake && f < JOB_FIBER_NUM_PER_WORKER; ++f)
+		{
+			pWorker->mpFibers[f] = CreateFiber(JOB_FIBER_STACK_SIZE, WorkerFiber, pWorker);
+			if (NULL == pWorker->mpFibers[f])
+				break;
+
+			pWorker->mpFreeFibers[pWorker->mFreeNum++] = pWorker->mpFibers[f];
+		}
+
+		pWorker->mThread = (JOB_FIBER_NUM_PER_WORKER == pWorker->mFreeNum) ? CreateThread(NULL, 0, WorkerThread, pWorker, 0, NULL) : NULL;
+
+		if (NULL == pWorker->mThread)
+		{
+			AE_WARNING_MESG(0, "Couldn't start job worker %lu", (unsigned long)w);
+			StopWorkers();
+			DeleteCriticalSection(&sgQueueLock);
+			return 0;
+		}
+
+		// Counted once the thread exists, so StopWorkers only waits for the started ones
+		sgWorkerNum = w;
+	}
+
+	sgRunning = 1;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void JobSystemShutdown(void)
+{
+	JobEntry entry;
+
+	if (0 == sgRunning)
+		return;
+
+	// Whatever is still queued runs here
+	while (PopJob(&entry))
+		RunJob(&entry);
+
+	sgRunning = 0;
+
+	StopWorkers();
+	DeleteCriticalSection(&sgQueueLock);
+}
+
+// ---------------------------------------------------------------------------
+
+int JobSystemIsRunning(void)
+{
+	return (0 != sgRunning);
+}
+
+// ---------------------------------------------------------------------------
+
+u32 JobSystemGetWorkerNum(void)
+{
+	return sgRunning ? sgWorkerNum : 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void JobSystemSetWorkerLimit(u32 Num)
+{
+	InterlockedExchange(&sgWorkerLimit, (LONG)Num);
+
+	// The workers let in check the queue
+	WakeAll();
+}
+
+// ---------------------------------------------------------------------------
+
+u32 JobGetThreadIndex(void)
+{
+	return spWorker ? spWorker->mIndex : 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void JobRun(const JobDecl *pJobs, u32 Num, JobCounter *pCounter)
+{
+	u32 i, queuedNum;
+
+	if (0 == Num)
+		return;
+
+	if (pCounter)
+		InterlockedExchangeAdd(&pCounter->mValue, (LONG)Num);
+
+	queuedNum = 0;
+
+	if (sgRunning)
+	{
+		EnterCriticalSection(&sgQueueLock);
+
+		for (; queuedNum < Num && sgQueueWrite - sgQueueRead < JOB_QUEUE_SIZE; ++queuedNum)
+		{
+			JobEntry *pEntry = sgQueue + (sgQueueWrite++ & (JOB_QUEUE_SIZE - 1));
+
+			pEntry->mJob = pJobs[queuedNum];
+			pEntry->mpCounter = pCounter;
+		}
+
+		LeaveCriticalSection(&sgQueueLock);
+
+		WakeAll();
+	}
+
+	// No system, or a full queue
+	for (i = queuedNum; i < Num; ++i)
+	{
+		JobEntry entry;
+
+		entry.mJob = pJobs[i];
+		entry.mpCounter = pCounter;
+		RunJob(&entry);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void JobWait(JobCounter *pCounter)
+{
+	JobWorker *pWorker = spWorker;
+	JobEntry entry;
+
+	if (0 == pCounter->mValue)
+		return;
+
+	if (pWorker && pWorker->mFreeNum > 0)
+	{
+		JobWaiter *pWaiter = pWorker->mWaiters + pWorker->mWaiterNum;
+
+		pWaiter->mpFiber = GetCurrentFiber();
+		pWaiter->mpCounter = pCounter;
+
+		// Published after the entry: a counter reaching 0 from now on wakes this worker
+		InterlockedIncrement(&pWorker->mWaiterNum);
+
+		// The next fiber checks the waiters before anything else, so a counter
+		// that reached 0 in between isn't missed. WorkerLoop switches back here
+		SwitchToFiber(pWorker->mpFreeFibers[--pWorker->mFreeNum]);
+
+		return;
+	}
+
+	// Outside the pool, or out of fibers: run jobs on this thread meanwhile.
+	// The timeout covers several threads sharing sgExternalWake
+	while (pCounter->mValue > 0)
+	{
+		if (PopJob(&entry))
+			RunJob(&entry);
+		else
+			WaitForSingleObject(pWorker ? pWorker->mWake : sgExternalWake, 1);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void JobParallelFor(JobRangeFunction pFunction, void *pData, u32 Num, u32 BatchSize)
+{
+	JobRange ranges[JOB_PARALLEL_FOR_BATCH_MAX];
+	JobDecl jobs[JOB_PARALLEL_FOR_BATCH_MAX];
+	JobCounter counter;
+	u32 batchNum, i;
+
+	BatchSize = (BatchSize > 0) ? BatchSize : 1;
+
+	// Not worth a job
+	if (Num <= BatchSize || 0 == sgRunning)
+	{
+		if (Num > 0)
+			pFunction(pData, 0, Num);
+
+		return;
+	}
+
+	batchNum = (Num - 1) / BatchSize + 1;
+	batchNum = (batchNum < JOB_PARALLEL_FOR_BATCH_MAX) ? batchNum : JOB_PARALLEL_FOR_BATCH_MAX;
+
+	for (i = 0; i < batchNum; ++i)
+	{
+		ranges[i].mpFunction = pFunction;
+		ranges[i].mpData = pData;
+		ranges[i].mFirst = (u32)((u64)Num * i / batchNum);
+		ranges[i].mNum = (u32)((u64)Num * (i + 1) / batchNum) - ranges[i].mFirst;
+
+		jobs[i].mpFunction = RunRange;
+		jobs[i].mpData = ranges + i;
+	}
+
+	counter.mValue = 0;
+
+	// The calling thread takes the first batch
+	JobRun(jobs + 1, batchNum - 1, &counter);
+	RunRange(ranges);
+	JobWait(&counter);
+}
+
+// ---------------------------------------------------------------------------
+
+void StopWorkers(void)
+{
+	u32 w, f;
+
+	InterlockedExchange(&sgQuit, 1);
+	WakeAll();
+
+	for (w = 1; w < JOB_THREAD_NUM_MAX; ++w)
+	{
+		JobWorker *pWorker = sgWorkers + w;
+
+		if (pWorker->mThread)
+		{
+			WaitForSingleObject(pWorker->mThread, INFINITE);
+			CloseHandle(pWorker->mThread);
+		}
+
+		// Not running anywhere anymore
+		for (f = 0; f < JOB_FIBER_NUM_PER_WORKER; ++f)
+			if (pWorker->mpFibers[f])
+				DeleteFiber(pWorker->mpFibers[f]);
+
+		if (pWorker->mWake)
+			CloseHandle(pWorker->mWake);
+	}
+
+	memset(sgWorkers, 0, sizeof(sgWorkers));
+	sgWorkerNum = 0;
+
+	if (sgExternalWake)
+		CloseHandle(sgExternalWake);
+	sgExternalWake = NULL;
+}
+
+// ---------------------------------------------------------------------------
+
+DWORD WINAPI WorkerThread(LPVOID pParam)
+{
+	JobWorker *pWorker = (JobWorker *)pParam;
+
+	spWorker = pWorker;
+
+	pWorker->mpThreadFiber = ConvertThreadToFiber(NULL);
+
+	if (pWorker->mpThreadFiber)
+	{
+		// Back here once a fiber sees the quit
+		SwitchToFiber(pWorker->mpFreeFibers[--pWorker->mFreeNum]);
+		ConvertFiberToThread();
+	}
+	else
+	{
+		// Without fibers, JobWait runs jobs on this thread like on the threads outside the pool
+		pWorker->mFreeNum = 0;
+		WorkerLoop(pWorker);
+	}
+
+	spWorker = NULL;
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void CALLBACK WorkerFiber(void *pParam)
+{
+	JobWorker *pWorker = (JobWorker *)pParam;
+
+	WorkerLoop(pWorker);
+
+	// A fiber must never return
+	SwitchToFiber(pWorker->mpThreadFiber);
+}
+
+// ---------------------------------------------------------------------------
+
+void WorkerLoop(JobWorker *pWorker)
+{
+	JobEntry entry;
+	void *pReady;
+
+	while (0 == sgQuit)
+	{
+		// Parked jobs first: they hold a fiber, and their callers are waiting already
+		pReady = TakeReadyWaiter(pWorker);
+		if (pReady)
+		{
+			pWorker->mpFreeFibers[pWorker->mFreeNum++] = GetCurrentFiber();
+			SwitchToFiber(pReady);
+
+			continue;
+		}
+
+		if (pWorker->mIndex <= (u32)sgWorkerLimit && PopJob(&entry))
+		{
+			RunJob(&entry);
+
+			continue;
+		}
+
+		WaitForSingleObject(pWorker->mWake, INFINITE);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void* TakeReadyWaiter(JobWorker *pWorker)
+{
+	u32 i, num = (u32)pWorker->mWaiterNum;
+
+	for (i = 0; i < num; ++i)
+	{
+		if (0 == pWorker->mWaiters[i].mpCounter->mValue)
+		{
+			void *pFiber = pWorker->mWaiters[i].mpFiber;
+
+			pWorker->mWaiters[i] = pWorker->mWaiters[num - 1];
+			InterlockedDecrement(&pWorker->mWaiterNum);
+
+			return pFiber;
+		}
+	}
+
+	return NULL;
+}
+
+// ---------------------------------------------------------------------------
+
+int PopJob(JobEntry *pEntry)
+{
+	int popped = 0;
+
+	// Checked without the lock first: idle threads poll often
+	if (sgQueueRead == sgQueueWrite)
+		return 0;
+
+	EnterCriticalSection(&sgQueueLock);
+
+	if (sgQueueRead != sgQueueWrite)
+	{
+		*pEntry = sgQueue[sgQueueRead++ & (JOB_QUEUE_SIZE - 1)];
+		popped = 1;
+	}
+
+	LeaveCriticalSection(&sgQueueLock);
+
+	return popped;
+}
+
+// ---------------------------------------------------------------------------
+
+void RunJob(const JobEntry *pEntry)
+{
+	u32 w;
+
+	pEntry->mJob.mpFunction(pEntry->mJob.mpData);
+
+	if (0 == pEntry->mpCounter || 0 != InterlockedDecrement(&pEntry->mpCounter->mValue))
+		return;
+
+	// Only the workers with parked jobs can be waiting for it
+	for (w = 1; w <= sgWorkerNum; ++w)
+		if (sgWorkers[w].mWaiterNum > 0)
+			SetEvent(sgWorkers[w].mWake);
+
+	if (sgExternalWake)
+		SetEvent(sgExternalWake);
+}
+
+// ---------------------------------------------------------------------------
+
+void WakeAll(void)
+{
+	u32 w;
+
+	for (w = 1; w < JOB_THREAD_NUM_MAX; ++w)
+		if (sgWorkers[w].mWake)
+			SetEvent(sgWorkers[w].mWake);
+
+	if (sgExternalWake)
+		SetEvent(sgExternalWake);
+}
+
+// ---------------------------------------------------------------------------
+
+void RunRange(void *pData)
+{
+	JobRange *pRange = (JobRange *)pData;
+
+	pRange->mpFunction(pRange->mpData, pRange->mFirst, pRange->mNum);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	JobSystem.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the fiber job system
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define JOB_THREAD_NUM_MAX				64					// Workers, plus the threads outside the pool (index 0)
+#define JOB_QUEUE_SIZE					4096				// Jobs waiting to run (power of 2). Jobs pushed to a full queue run right away
+#define JOB_FIBER_NUM_PER_WORKER		32					// Jobs a worker can have waiting at once, plus one running
+#define JOB_FIBER_STACK_SIZE			(64 * 1024)
+#define JOB_PARALLEL_FOR_BATCH_MAX		256					// Batches per JobParallelFor, the batch size grows past it
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef void (*JobFunction)(void *pData);
+
+typedef struct JobDecl
+{
+	JobFunction			mpFunction;
+	void				*mpData;
+}JobDecl;
+
+// ---------------------------------------------------------------------------
+
+// Jobs left to run in a group: JobRun adds to it, every job of the group subtracts one when done
+typedef struct JobCounter
+{
+	volatile LONG		mValue;
+}JobCounter;
+
+// ---------------------------------------------------------------------------
+
+// Runs the items [First, First + Num) of a JobParallelFor
+typedef void (*JobRangeFunction)(void *pData, u32 First, u32 Num);
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Starts WorkerNum worker threads, 0 for one per processor but one: the thread calling
+JobWait helps too. Every worker runs its jobs on its own pool of fibers: a job waiting on
+a counter is parked, and the worker runs other jobs meanwhile. A parked job resumes on
+the thread it started on, so thread locals (like the profiler's scopes) stay valid
+across a wait; a scope open across a wait is still only safe in jobs nothing else
+on the thread waits for.
+
+Called by GameStateMgrInit. Without a running system, JobRun runs the jobs right away.
+
+ - Returns 1 on success, 0 if a thread or a fiber couldn't be created (the system is off then)
+*/
+int JobSystemInit(u32 WorkerNum);
+
+// Waits for the queued jobs, then stops the workers. Called once the game state manager reaches GS_QUIT
+void JobSystemShutdown(void);
+
+int JobSystemIsRunning(void);
+u32 JobSystemGetWorkerNum(void);
+
+/*
+Workers with an index past Num take no new job. For benchmarks scaling over the thread count;
+JobSystemInit starts with no limit
+*/
+void JobSystemSetWorkerLimit(u32 Num);
+
+/*
+0 on the threads outside the pool, 1 to JobSystemGetWorkerNum() on the workers:
+an index into per thread scratch, for jobs that don't wait while using it
+*/
+u32 JobGetThreadIndex(void);
+
+// Queues Num jobs. pCounter, if not 0, is increased by Num and decreased as every job finishes
+void JobRun(const JobDecl *pJobs, u32 Num, JobCounter *pCounter);
+
+/*
+Returns once pCounter is 0.
+ - In a job on a worker: parks the job's fiber, the worker runs other jobs
+ - Anywhere else: runs queued jobs on the calling thread meanwhile
+*/
+void JobWait(JobCounter *pCounter);
+
+/*
+Calls pFunction on [0, Num) split in batches of at least BatchSize items, spread over
+the workers and the calling thread, and returns once they're all done
+*/
+void JobParallelFor(JobRangeFunction pFunction, void *pData, u32 Num, u32 BatchSize);
+
+// ---------------------------------------------------------------------------
+
+#endif // JOB_SYSTEM_H
@@ -1,3 +1,6 @@
+#include <string.h>
+#include <xmmintrin.h>
+
 #include "LineSegment2D.h"
 
 
@@ -24,4 +27,52 @@ int BuildLineSegment2D(LineSegment2D *LS, Vector2D *Point0, Vector2D *Point1)
 		return 1;
 	}
 	//return 0;
-}
\ No newline at end of file
+}
+
+
+int LineSegment2DArrayInit(LineSegment2DArray *pArray, const LineSegment2D *pSegments, u32 Num)
+{
+	u32 i, allocNum = (Num > 0) ? Num : 1;
+
+	pArray->mpPlanes = (LineSegment2DPlane *)_mm_malloc(sizeof(LineSegment2DPlane) * allocNum, LINE_SEGMENT2D_ALIGNMENT);
+	pArray->mpEnds = (LineSegment2DEnds *)_mm_malloc(sizeof(LineSegment2DEnds) * allocNum, LINE_SEGMENT2D_ALIGNMENT);
+	pArray->mNum = Num;
+
+	if (0 == pArray->mpPlanes || 0 == pArray->mpEnds)
+	{
+		LineSegment2DArrayFree(pArray);
+		return 0;
+	}
+
+	for (i = 0; i < Num; ++i)
+	{
+		pArray->mpPlanes[i].mN = pSegments[i].mN;
+		pArray->mpPlanes[i].mNdotP0 = pSegments[i].mNdotP0;
+		pArray->mpPlanes[i].mPad = 0.0f;
+
+		pArray->mpEnds[i].mP0 = pSegments[i].mP0;
+		pArray->mpEnds[i].mP1 = pSegments[i].mP1;
+	}
+
+	return 1;
+}
+
+
+void LineSegment2DArrayFree(LineSegment2DArray *pArray)
+{
+	if (pArray->mpPlanes)
+		_mm_free(pArray->mpPlanes);
+	if (pArray->mpEnds)
+		_mm_free(pArray->mpEnds);
+
+	memset(pArray, 0, sizeof(LineSegment2DArray));
+}
+
+
+void LineSegment2DArrayGet(const LineSegment2DArray *pArray, u32 Index, LineSegment2D *pSegment)
+{
+	pSegment->mP0 = pArray->mpEnds[Index].mP0;
+	pSegment->mP1 = pArray->mpEnds[Index].mP1;
+	pSegment->mN = pArray->mpPlanes[Index].mN;
+	pSegment->mNdotP0 = pArray->mpPlanes[Index].mNdotP0;
+}
@@ -1,6 +1,7 @@
 #ifndef LINESEGMENT2D_H
 #define LINESEGMENT2D_H
 
+#include "AETypes.h"
 #include "Vector2D.h"
 
 
@@ -30,5 +31,48 @@ int BuildLineSegment2D(LineSegment2D *LS, Vector2D *Point0, Vector2D *Point1);
 
 
 
+/*
+Hot/cold split of an array of line segments, for the loops testing many of them.
+A LineSegment2D is 28 bytes, so in an array most of them straddle 2 cache lines,
+while the rejection tests only need the line equation. Here the line equations
+are packed 4 per cache line, and the endpoints live in a parallel array that's
+only read once a line is crossed. Both arrays are LINE_SEGMENT2D_ALIGNMENT aligned
+*/
+#define LINE_SEGMENT2D_ALIGNMENT	64
+
+typedef struct LineSegment2DPlane
+{
+	Vector2D mN;		// Line's normal
+	float mNdotP0;
+	float mPad;			// To 16 bytes
+}LineSegment2DPlane;
+
+typedef struct LineSegment2DEnds
+{
+	Vector2D mP0;
+	Vector2D mP1;
+}LineSegment2DEnds;
+
+typedef struct LineSegment2DArray
+{
+	LineSegment2DPlane *mpPlanes;		// Hot
+	LineSegment2DEnds *mpEnds;			// Cold
+	u32 mNum;
+}LineSegment2DArray;
+
+
+/*
+This function splits Num line segments into the hot and cold arrays
+
+ - Returns 1 on success, 0 if an allocation failed
+*/
+int LineSegment2DArrayInit(LineSegment2DArray *pArray, const LineSegment2D *pSegments, u32 Num);
+void LineSegment2DArrayFree(LineSegment2DArray *pArray);
+
+// Puts segment "Index" back together
+void LineSegment2DArrayGet(const LineSegment2DArray *pArray, u32 Index, LineSegment2D *pSegment);
+
+
+
 
 #endif
\ No newline at end of file
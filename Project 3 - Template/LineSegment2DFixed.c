@@ -0,0 +1,23 @@
+#include "LineSegment2DFixed.h"
+
+
+int BuildLineSegment2DFixed(LineSegment2DFixed *LS, Vector2DFixed *Point0, Vector2DFixed *Point1)
+{
+	if (Point0->x == Point1->x && Point0->y == Point1->y)
+	{
+		return 0;
+	}
+
+	LS->mP0 = *Point0;
+	LS->mP1 = *Point1;
+
+	LS->mN.x = LS->mP1.y - LS->mP0.y;
+	LS->mN.y = LS->mP0.x - LS->mP1.x;
+
+	Vector2DFixedNormalize(&LS->mN, &LS->mN);
+
+	// |N| = 1, so N.P0 is within the coordinates' range
+	LS->mNdotP0 = FixedFromWide(Vector2DFixedDotProduct(&LS->mN, &LS->mP0));
+
+	return 1;
+}
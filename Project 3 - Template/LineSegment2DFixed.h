@@ -0,0 +1,30 @@
+#ifndef LINESEGMENT2DFIXED_H
+#define LINESEGMENT2DFIXED_H
+
+#include "Vector2DFixed.h"
+
+
+
+/*
+Fixed-point version of LineSegment2D, for the deterministic simulation
+*/
+typedef struct LineSegment2DFixed
+{
+	Vector2DFixed mP0;		// Point on the line
+	Vector2DFixed mP1;		// Point on the line
+	Vector2DFixed mN;		// Line's normal
+	Fixed mNdotP0;			// To avoid computing it every time it's needed
+}LineSegment2DFixed;
+
+
+/*
+This function builds a fixed-point 2D line segment's data using 2 points, like BuildLineSegment2D
+
+ - Returns 1 if the line equation was built successfully 
+*/
+int BuildLineSegment2DFixed(LineSegment2DFixed *LS, Vector2DFixed *Point0, Vector2DFixed *Point1);
+
+
+
+
+#endif
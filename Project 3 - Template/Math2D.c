@@ -1,4 +1,5 @@
 #include "Math2D.h"
+#include "CollisionStats.h"
 #include "stdio.h"
 
 int StaticPointToStaticCircle(Vector2D *pP, Vector2D *pCenter, float Radius)
@@ -77,14 +78,14 @@ int StaticCircleToStaticRectangle(Vector2D *pCenter, float Radius, Vector2D *pRe
 
 
 
-	if (pCenter->x > pRect->x + 0.5*Width)
+	if (pCenter->x > pRect->x + 0.5f*Width)
 	{
-		closestPoint.x = pRect->x + 0.5*Width;
+		closestPoint.x = pRect->x + 0.5f*Width;
 	}
 
-	else if (pCenter->x < pRect->x - 0.5*Width)
+	else if (pCenter->x < pRect->x - 0.5f*Width)
 	{
-		closestPoint.x = pRect->x - 0.5*Width;
+		closestPoint.x = pRect->x - 0.5f*Width;
 	}
 
 	else
@@ -93,14 +94,14 @@ int StaticCircleToStaticRectangle(Vector2D *pCenter, float Radius, Vector2D *pRe
 	}
 
 
-	if (pCenter->y > pRect->y + 0.5*Height)
+	if (pCenter->y > pRect->y + 0.5f*Height)
 	{
-		closestPoint.y = pRect->y + 0.5*Height;
+		closestPoint.y = pRect->y + 0.5f*Height;
 	}
 
-	else if (pCenter->y < pRect->y - 0.5*Height)
+	else if (pCenter->y < pRect->y - 0.5f*Height)
 	{
-		closestPoint.y = pRect->y - 0.5*Height;
+		closestPoint.y = pRect->y - 0.5f*Height;
 	}
 
 	else
@@ -140,6 +141,78 @@ float StaticPointToStaticLineSegment(Vector2D *P, LineSegment2D *LS)
 }
 
 
+/*
+This function finds the point of a line segment closest to a point
+
+ - Parameters
+	- P:		The point
+	- LS:		The line segment
+	- Pc:		This will be used to store the closest point's coordinates
+
+ - Returned value: The distance between P and Pc, signed like StaticPointToStaticLineSegment:
+	- Negative if the point is in the line's inside half plane
+	- Positive if the point is in the line's outside half plane
+	- Zero if the point is on the line segment
+*/
+float ClosestPointOnStaticLineSegment(Vector2D *P, LineSegment2D *LS, Vector2D *Pc)
+{
+	Vector2D e, w;
+	float t, lengthSquare, distance;
+
+	Vector2DSub(&e, &LS->mP1, &LS->mP0);
+	Vector2DSub(&w, P, &LS->mP0);
+
+	// Projection of P on the segment's line, clamped to the end points
+	lengthSquare = Vector2DSquareLength(&e);
+	t = (lengthSquare > 0.0f) ? Vector2DDotProduct(&w, &e) / lengthSquare : 0.0f;
+
+	if (t < 0.0f)
+		t = 0.0f;
+	else
+	if (t > 1.0f)
+		t = 1.0f;
+
+	Vector2DScaleAdd(Pc, &e, &LS->mP0, t);
+	distance = Vector2DDistance(P, Pc);
+
+	return (StaticPointToStaticLineSegment(P, LS) < 0.0f) ? -distance : distance;
+}
+
+
+/*
+This function finds the point of a circle's outline closest to a point
+
+ - Parameters
+	- P:		The point
+	- Center:	The circle's center
+	- Radius:	The circle's radius
+	- Pc:		This will be used to store the closest point's coordinates
+
+ - Returned value: The signed distance between P and the circle
+	- Negative if the point is inside the circle
+	- Positive if the point is outside the circle
+	- Zero if the point is on the circle
+*/
+float ClosestPointOnStaticCircle(Vector2D *P, Vector2D *Center, float Radius, Vector2D *Pc)
+{
+	Vector2D d;
+	float length;
+
+	Vector2DSub(&d, P, Center);
+	length = Vector2DLength(&d);
+
+	// Any point of the outline is the closest to the center
+	if (0.0f == length)
+		Vector2DSet(&d, 1.0f, 0.0f);
+	else
+		Vector2DScale(&d, &d, 1.0f / length);
+
+	Vector2DScaleAdd(Pc, &d, Center, Radius);
+
+	return length - Radius;
+}
+
+
 /*
 This function checks whether an animated point is colliding with a line segment
 
@@ -155,8 +228,17 @@ This function checks whether an animated point is colliding with a line segment
 */
 float AnimatedPointToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, LineSegment2D *LS, Vector2D *Pi)
 {
-	if( (Pe->x == Ps->x && Pe->y == Ps->y) ||(Vector2DDotProduct(&LS->mN, Ps) > LS->mNdotP0 && Vector2DDotProduct(&LS->mN, Pe) > LS->mNdotP0) || (Vector2DDotProduct(&LS->mN, Ps) < LS->mNdotP0 && Vector2DDotProduct(&LS->mN, Pe) < LS->mNdotP0))
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	if (Pe->x == Ps->x && Pe->y == Ps->y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -1.f;
+	}
+
+	if ((Vector2DDotProduct(&LS->mN, Ps) > LS->mNdotP0 && Vector2DDotProduct(&LS->mN, Pe) > LS->mNdotP0) || (Vector2DDotProduct(&LS->mN, Ps) < LS->mNdotP0 && Vector2DDotProduct(&LS->mN, Pe) < LS->mNdotP0))
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SAME_SIDE]);
 		return -1.f;
 	}
 	//return -1.0f;
@@ -167,6 +249,7 @@ float AnimatedPointToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, LineSegment2D
 
 	if (  t == 0.f)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_PARALLEL]);
 		return -1;
 	}
 
@@ -174,6 +257,7 @@ float AnimatedPointToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, LineSegment2D
 
 	 if (t > 1 || t < 0)
 	 {
+		 COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
 		 return -1.f;
 	 }
 
@@ -187,10 +271,13 @@ float AnimatedPointToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, LineSegment2D
 	 Vector2DSub(&nLine, &LS->mP0, &LS->mP1);
 	 if (Vector2DDotProduct(&line, &ItoP0) < 0 || Vector2DDotProduct(&nLine, &ItoP1) < 0)
 	 {
+		 COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OUTSIDE_SEGMENT]);
 		 return -1.f;
 	 }
 
 
+	 COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
 	 Vector2DSet(Pi, tempI.x, tempI.y);
 	 return t;
 	
@@ -218,8 +305,18 @@ float AnimatedCircleToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, float Radius
 {
 	//return -1.0f;
 	float nR = -1 * Radius;
-	if ((Pe->x == Ps->x && Pe->y == Ps->y) || (Vector2DDotProduct(&LS->mN, Ps) - LS->mNdotP0) < nR  &&  (Vector2DDotProduct(&LS->mN, Pe) - LS->mNdotP0  < nR) || (Vector2DDotProduct(&LS->mN, Ps)- LS->mNdotP0  > Radius &&   Vector2DDotProduct(&LS->mN, Pe) - LS->mNdotP0 > Radius))
+
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	if (Pe->x == Ps->x && Pe->y == Ps->y)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -1.f;
+	}
+
+	if ((Vector2DDotProduct(&LS->mN, Ps) - LS->mNdotP0) < nR  &&  (Vector2DDotProduct(&LS->mN, Pe) - LS->mNdotP0  < nR) || (Vector2DDotProduct(&LS->mN, Ps)- LS->mNdotP0  > Radius &&   Vector2DDotProduct(&LS->mN, Pe) - LS->mNdotP0 > Radius))
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SAME_SIDE]);
 		return -1.f;
 	}
 	//return -1.0f;
@@ -238,6 +335,7 @@ float AnimatedCircleToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, float Radius
 
 	if (t == 0.f)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_PARALLEL]);
 		return -1;
 	}
 
@@ -245,6 +343,7 @@ float AnimatedCircleToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, float Radius
 
 	if (t > 1 || t < 0)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
 		return -1.f;
 	}
 
@@ -256,15 +355,80 @@ float AnimatedCircleToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, float Radius
 	Vector2DSub(&nLine, &LS->mP0, &LS->mP1);
 	if (Vector2DDotProduct(&line, &ItoP0) < 0 || Vector2DDotProduct(&nLine, &ItoP1) < 0)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OUTSIDE_SEGMENT]);
 		return -1.f;
 	}
 
 
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
 	Vector2DSet(Pi, tempI.x, tempI.y);
 	return t;
 }
 
 
+/*
+AnimatedCircleToStaticLineSegment on the hot/cold split: same tests in the same order,
+so the results and the collision stats are identical
+*/
+float AnimatedCircleToStaticLineSegmentSplit(Vector2D *Ps, Vector2D *Pe, float Radius, const LineSegment2DPlane *pPlane, const LineSegment2DEnds *pEnds, Vector2D *Pi)
+{
+	Vec2 s = *Ps, e = *Pe, v, tempI;
+	float ds, de, vn, t;
+
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	if (e.x == s.x && e.y == s.y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -1.f;
+	}
+
+	// Hot data only: signed distances of both ends of the motion
+	ds = Vec2Dot(pPlane->mN, s) - pPlane->mNdotP0;
+	de = Vec2Dot(pPlane->mN, e) - pPlane->mNdotP0;
+
+	if ((ds < -Radius && de < -Radius) || (ds > Radius && de > Radius))
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SAME_SIDE]);
+		return -1.f;
+	}
+
+	v = Vec2Sub(e, s);
+	vn = Vec2Dot(pPlane->mN, v);
+
+	if (vn == 0.f)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_PARALLEL]);
+		return -1.f;
+	}
+
+	// Touches the line at the radius, on the starting side
+	t = (-ds + ((ds < 0) ? -Radius : Radius)) / vn;
+
+	if (t > 1 || t < 0)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
+		return -1.f;
+	}
+
+	// Cold data: is the contact between the endpoints
+	tempI = Vec2ScaleAdd(v, s, t);
+
+	if (Vec2Dot(Vec2Sub(pEnds->mP1, pEnds->mP0), Vec2Sub(tempI, pEnds->mP0)) < 0 ||
+		Vec2Dot(Vec2Sub(pEnds->mP0, pEnds->mP1), Vec2Sub(tempI, pEnds->mP1)) < 0)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OUTSIDE_SEGMENT]);
+		return -1.f;
+	}
+
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	*Pi = tempI;
+	return t;
+}
+
+
 /*
 This function reflects an animated point on a line segment.
 It should first make sure that the animated point is intersecting with the line 
@@ -362,28 +526,42 @@ This function checks whether an animated point is colliding with a static circle
 */
 float AnimatedPointToStaticCircle(Vector2D *Ps, Vector2D *Pe, Vector2D *Center, float Radius, Vector2D *Pi)
 {
-	//return -1.0f;
-	Vector2D v, bc, vUnit;
-	float f, disc, a, b, c,m,n;
+	Vec2 s = *Ps, v, bc;
+	float f, disc, a, b, c, m, n, radiusSquare = Radius * Radius;
 
-	Vector2DSub(&v, Pe, Ps);
-	Vector2DSub(&bc, Center, Ps);
-	Vector2DNormalize(&vUnit, &v);
-	m = Vector2DDotProduct(&bc, &vUnit);
-	n = ((v.x * v.x) + (v.y * v.y)) - (m*m);
-	if ((Pe->x == Ps->x && Pe->y == Ps->y) || (n > Radius*Radius) || (m < 0 && Vector2DSquareDistance(Ps,Center) > Radius*Radius))
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_CIRCLE]);
+
+	if (Pe->x == s.x && Pe->y == s.y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -1.f;
+	}
+
+	v = Vec2Sub(*Pe, s);
+	bc = Vec2Sub(*Center, s);
+	m = Vec2Dot(bc, Vec2Normalize(v));
+	n = Vec2SquareLength(v) - (m*m);
+
+	if (n > radiusSquare)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_MISS_DISTANCE]);
 		return -1.f;
 	}
-	//Vector2D bc2;
-	//Vector2DScale(&bc2, &bc, -2.f);
-	a = Vector2DDotProduct(&v, &v);
-	b = -2*  Vector2DDotProduct(&bc, &v);
-	c = (Vector2DDotProduct(&bc, &bc)) - (Radius * Radius);
+
+	if (m < 0 && Vec2SquareLength(bc) > radiusSquare)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_MOVING_AWAY]);
+		return -1.f;
+	}
+
+	a = Vec2SquareLength(v);
+	b = -2 * Vec2Dot(bc, v);
+	c = Vec2SquareLength(bc) - radiusSquare;
 	disc = (b*b) - (4.f * a*c);
 
 	if(disc<0)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_ROOT]);
 		return -1.f;
 	}
 
@@ -404,9 +582,13 @@ float AnimatedPointToStaticCircle(Vector2D *Ps, Vector2D *Pe, Vector2D *Center,
 
 	if (f > 1.f || f < 0.f)
 	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
 		return -1;
 	}
-	Vector2DScaleAdd(Pi, &v, Ps, f);
+
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_CIRCLE]);
+
+	*Pi = Vec2ScaleAdd(v, s, f);
 	return f;
 
 }
@@ -500,3 +682,259 @@ float ReflectAnimatedCircleOnStaticCircle(Vector2D *Center0s, Vector2D *Center0e
 	return ReflectAnimatedPointOnStaticCircle(Center0s, Center0e, Center1, (Radius0 + Radius1), Pi, R);
 
 }
+
+
+/*
+Time at which Ps + t * V enters the circle of radius "Radius" around the polygon's
+corner C, for Ps outside of it. -1.0f if it doesn't within [0, 1]
+*/
+static float AnimatedPointToCorner(Vector2D *Ps, Vector2D *V, Vector2D *C, float Radius)
+{
+	Vector2D m;
+	float a, b, c, disc, t;
+
+	Vector2DSub(&m, Ps, C);
+	a = Vector2DSquareLength(V);
+	b = Vector2DDotProduct(&m, V);
+	c = Vector2DSquareLength(&m) - Radius * Radius;
+	disc = b * b - a * c;
+
+	if (c < 0.0f || b >= 0.0f || disc < 0.0f)
+		return -1.0f;
+
+	t = (-b - sqrtf(disc)) / a;
+
+	return (t > 1.0f) ? -1.0f : t;
+}
+
+
+/*
+This function checks whether an animated circle is colliding with a static convex polygon.
+Separating axes (the edge normals and the motion's normal) reject most misses before
+the time of impact is computed: the motion is clipped against the edges pushed out by
+the radius, then checked against the corner's circle when it enters outside an edge
+
+ - Parameters
+	- Ps:		The center's starting location
+	- Pe:		The center's ending location
+	- Radius:	The circle's radius
+	- Poly:		The convex polygon
+	- Pi:		This will be used to store the center's coordinates at the intersection (In case there's an intersection)
+	- N:		This will be used to store the polygon's outward normal at the contact (In case there's an intersection)
+
+ - Returned value: Intersection time t
+	- -1.0f:				If there's no intersection, or if the circle already overlaps the polygon at Ps
+	- Intersection time:	If there's an intersection
+*/
+float AnimatedCircleToStaticConvexPolygon(Vector2D *Ps, Vector2D *Pe, float Radius, ConvexPolygon2D *Poly, Vector2D *Pi, Vector2D *N)
+{
+	Vector2D v, m, w;
+	float t, tEnter = 0.0f, tExit = 1.0f, lengthSquare, projection, minProjection, maxProjection, reach;
+	unsigned int i, enterEdge = CONVEX_POLYGON_VERTEX_NUM_MAX, vertex;
+
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_CONVEX_POLYGON]);
+
+	if (Pe->x == Ps->x && Pe->y == Ps->y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -1.f;
+	}
+
+	Vector2DSub(&v, Pe, Ps);
+	lengthSquare = Vector2DSquareLength(&v);
+
+	// Bounding circle against the swept circle
+	Vector2DSub(&w, &Poly->mCenter, Ps);
+	t = Vector2DDotProduct(&w, &v) / lengthSquare;
+	t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+	Vector2DScaleSub(&w, &v, &w, t);
+
+	if (Vector2DSquareLength(&w) > (Radius + Poly->mRadius) * (Radius + Poly->mRadius))
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_MISS_DISTANCE]);
+		return -1.f;
+	}
+
+	// Separating axes: every edge normal...
+	for (i = 0; i < Poly->mVertexNum; ++i)
+	{
+		if (Vector2DDotProduct(&Poly->mN[i], Ps) - Poly->mNdotP[i] > Radius && Vector2DDotProduct(&Poly->mN[i], Pe) - Poly->mNdotP[i] > Radius)
+		{
+			COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SEPARATING_AXIS]);
+			return -1.f;
+		}
+	}
+
+	// ...and the motion's normal, not normalized: the radius is scaled instead
+	Vector2DSet(&m, -v.y, v.x);
+	projection = Vector2DDotProduct(&m, Ps);
+	reach = Radius * sqrtf(lengthSquare);
+	minProjection = maxProjection = Vector2DDotProduct(&m, &Poly->mVertices[0]);
+
+	for (i = 1; i < Poly->mVertexNum; ++i)
+	{
+		float vertexProjection = Vector2DDotProduct(&m, &Poly->mVertices[i]);
+
+		if (vertexProjection < minProjection)
+			minProjection = vertexProjection;
+		if (vertexProjection > maxProjection)
+			maxProjection = vertexProjection;
+	}
+
+	if (minProjection > projection + reach || maxProjection < projection - reach)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SEPARATING_AXIS]);
+		return -1.f;
+	}
+
+	// Cyrus-Beck: clip the center's motion against the edges pushed out by the radius
+	for (i = 0; i < Poly->mVertexNum; ++i)
+	{
+		float distance = Vector2DDotProduct(&Poly->mN[i], Ps) - Poly->mNdotP[i] - Radius;
+		float speed = Vector2DDotProduct(&Poly->mN[i], &v);
+
+		if (speed == 0.0f)
+		{
+			if (distance > 0.0f)
+			{
+				COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_PARALLEL]);
+				return -1.f;
+			}
+
+			continue;
+		}
+
+		t = -distance / speed;
+
+		if (speed < 0.0f)
+		{
+			if (t > tEnter)
+			{
+				tEnter = t;
+				enterEdge = i;
+			}
+		}
+		else
+		if (t < tExit)
+			tExit = t;
+
+		if (tEnter > tExit)
+		{
+			COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
+			return -1.f;
+		}
+	}
+
+	// Ps is inside every pushed out edge: either overlapping already, or next to a corner
+	if (CONVEX_POLYGON_VERTEX_NUM_MAX == enterEdge)
+	{
+		float closest = -1.0f;
+
+		for (i = 0; i < Poly->mVertexNum; ++i)
+		{
+			Vector2D e, p;
+			float s;
+
+			Vector2DSub(&e, &Poly->mVertices[(i + 1) % Poly->mVertexNum], &Poly->mVertices[i]);
+			Vector2DSub(&p, Ps, &Poly->mVertices[i]);
+			s = Vector2DDotProduct(&p, &e) / Vector2DSquareLength(&e);
+			s = (s < 0.0f) ? 0.0f : ((s > 1.0f) ? 1.0f : s);
+			Vector2DScaleSub(&p, &e, &p, s);
+
+			if (closest < 0.0f || Vector2DSquareLength(&p) < closest)
+				closest = Vector2DSquareLength(&p);
+		}
+
+		if (closest <= Radius * Radius)
+		{
+			COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OVERLAPPING]);
+			return -1.f;
+		}
+
+		// Only the corner's circle can be hit: take the earliest corner
+		t = -1.0f;
+		for (i = 0; i < Poly->mVertexNum; ++i)
+		{
+			float tVertex = AnimatedPointToCorner(Ps, &v, &Poly->mVertices[i], Radius);
+
+			if (tVertex >= 0.0f && (t < 0.0f || tVertex < t))
+			{
+				t = tVertex;
+				vertex = i;
+			}
+		}
+	}
+	else
+	{
+		Vector2D e, p;
+		float s;
+
+		// Where the pushed out edge is crossed, relative to the real edge
+		Vector2DSub(&e, &Poly->mVertices[(enterEdge + 1) % Poly->mVertexNum], &Poly->mVertices[enterEdge]);
+		Vector2DScaleAdd(&p, &v, Ps, tEnter);
+		Vector2DSub(&p, &p, &Poly->mVertices[enterEdge]);
+		s = Vector2DDotProduct(&p, &e) / Vector2DSquareLength(&e);
+
+		if (s >= 0.0f && s <= 1.0f)
+		{
+			COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_CONVEX_POLYGON]);
+
+			Vector2DScaleAdd(Pi, &v, Ps, tEnter);
+			*N = Poly->mN[enterEdge];
+			return tEnter;
+		}
+
+		// Past the edge's end: only that corner's circle can be hit
+		vertex = (s < 0.0f) ? enterEdge : (enterEdge + 1) % Poly->mVertexNum;
+		t = AnimatedPointToCorner(Ps, &v, &Poly->mVertices[vertex], Radius);
+	}
+
+	if (t < 0.0f)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OUTSIDE_SEGMENT]);
+		return -1.f;
+	}
+
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_CONVEX_POLYGON]);
+
+	Vector2DScaleAdd(Pi, &v, Ps, t);
+	Vector2DSub(N, Pi, &Poly->mVertices[vertex]);
+	Vector2DScale(N, N, 1.0f / Radius);
+	return t;
+}
+
+
+/*
+This function reflects an animated circle on a static convex polygon.
+It should first make sure that the animated circle is intersecting with the polygon
+
+ - Parameters
+	- Ps:		The center's starting location
+	- Pe:		The center's ending location
+	- Radius:	The circle's radius
+	- Poly:		The convex polygon
+	- Pi:		This will be used to store the intersection point's coordinates (In case there's an intersection)
+	- R:		Reflected vector R
+
+ - Returned value: Intersection time t
+	- -1.0f:				If there's no intersection
+	- Intersection time:	If there's an intersection
+*/
+float ReflectAnimatedCircleOnStaticConvexPolygon(Vector2D *Ps, Vector2D *Pe, float Radius, ConvexPolygon2D *Poly, Vector2D *Pi, Vector2D *R)
+{
+	Vector2D n, i, r;
+	float f = AnimatedCircleToStaticConvexPolygon(Ps, Pe, Radius, Poly, Pi, &n);
+
+	if (f < 0)
+	{
+		return -1.0f;
+	}
+
+	Vector2DSet(&i, Pe->x - Pi->x, Pe->y - Pi->y);
+	Vector2DScale(&r, &n, 2 * Vector2DDotProduct(&i, &n));
+	Vector2DSub(&r, &i, &r);
+	Vector2DNormalize(&r, &r);
+	Vector2DSet(R, r.x, r.y);
+
+	return f;
+}
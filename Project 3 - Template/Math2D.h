@@ -3,6 +3,7 @@
 
 
 #include "LineSegment2D.h"
+#include "ConvexPolygon2D.h"
 
 ////////////////////////
 // From Project 1 & 2 //
@@ -66,6 +67,39 @@ This function determines the distance separating a point from a line
 float StaticPointToStaticLineSegment(Vector2D *P, LineSegment2D *LS);
 
 
+/*
+This function finds the point of a line segment closest to a point
+
+ - Parameters
+	- P:		The point
+	- LS:		The line segment
+	- Pc:		This will be used to store the closest point's coordinates
+
+ - Returned value: The distance between P and Pc, signed like StaticPointToStaticLineSegment:
+	- Negative if the point is in the line's inside half plane
+	- Positive if the point is in the line's outside half plane
+	- Zero if the point is on the line segment
+*/
+float ClosestPointOnStaticLineSegment(Vector2D *P, LineSegment2D *LS, Vector2D *Pc);
+
+
+/*
+This function finds the point of a circle's outline closest to a point
+
+ - Parameters
+	- P:		The point
+	- Center:	The circle's center
+	- Radius:	The circle's radius
+	- Pc:		This will be used to store the closest point's coordinates
+
+ - Returned value: The signed distance between P and the circle
+	- Negative if the point is inside the circle
+	- Positive if the point is outside the circle
+	- Zero if the point is on the circle
+*/
+float ClosestPointOnStaticCircle(Vector2D *P, Vector2D *Center, float Radius, Vector2D *Pc);
+
+
 /*
 This function checks whether an animated point is colliding with a line segment
 
@@ -99,6 +133,26 @@ This function checks whether an animated circle is colliding with a line segment
 float AnimatedCircleToStaticLineSegment(Vector2D *Ps, Vector2D *Pe, float Radius, LineSegment2D *LS, Vector2D *Pi);
 
 
+/*
+This function is AnimatedCircleToStaticLineSegment on a segment of a LineSegment2DArray,
+with the same results. The early outs only read the hot line equation; the endpoints
+are only read once the motion crosses the line within the time range
+
+ - Parameters
+	- Ps:		The center's starting location
+	- Pe:		The center's ending location
+	- Radius:	The circle's radius
+	- pPlane:	The segment's line equation, from LineSegment2DArray::mpPlanes
+	- pEnds:	The segment's endpoints, from LineSegment2DArray::mpEnds
+	- Pi:		This will be used to store the intersection point's coordinates (In case there's an intersection)
+
+ - Returned value: Intersection time t
+	- -1.0f:				If there's no intersection
+	- Intersection time:	If there's an intersection
+*/
+float AnimatedCircleToStaticLineSegmentSplit(Vector2D *Ps, Vector2D *Pe, float Radius, const LineSegment2DPlane *pPlane, const LineSegment2DEnds *pEnds, Vector2D *Pi);
+
+
 /*
 This function reflects an animated point on a line segment.
 It should first make sure that the animated point is intersecting with the line 
@@ -211,4 +265,44 @@ It should first make sure that the animated circle is intersecting with the stat
 float ReflectAnimatedCircleOnStaticCircle(Vector2D *Center0s, Vector2D *Center0e, float Radius0, Vector2D *Center1, float Radius1, Vector2D *Pi, Vector2D *R);
 
 
+/*
+This function checks whether an animated circle is colliding with a static convex polygon.
+Separating axes (the edge normals and the motion's normal) reject most misses before
+the time of impact is computed: the motion is clipped against the edges pushed out by
+the radius, then checked against the corner's circle when it enters outside an edge
+
+ - Parameters
+	- Ps:		The center's starting location
+	- Pe:		The center's ending location
+	- Radius:	The circle's radius
+	- Poly:		The convex polygon
+	- Pi:		This will be used to store the center's coordinates at the intersection (In case there's an intersection)
+	- N:		This will be used to store the polygon's outward normal at the contact (In case there's an intersection)
+
+ - Returned value: Intersection time t
+	- -1.0f:				If there's no intersection, or if the circle already overlaps the polygon at Ps
+	- Intersection time:	If there's an intersection
+*/
+float AnimatedCircleToStaticConvexPolygon(Vector2D *Ps, Vector2D *Pe, float Radius, ConvexPolygon2D *Poly, Vector2D *Pi, Vector2D *N);
+
+
+/*
+This function reflects an animated circle on a static convex polygon.
+It should first make sure that the animated circle is intersecting with the polygon
+
+ - Parameters
+	- Ps:		The center's starting location
+	- Pe:		The center's ending location
+	- Radius:	The circle's radius
+	- Poly:		The convex polygon
+	- Pi:		This will be used to store the intersection point's coordinates (In case there's an intersection)
+	- R:		Reflected vector R
+
+ - Returned value: Intersection time t
+	- -1.0f:				If there's no intersection
+	- Intersection time:	If there's an intersection
+*/
+float ReflectAnimatedCircleOnStaticConvexPolygon(Vector2D *Ps, Vector2D *Pe, float Radius, ConvexPolygon2D *Poly, Vector2D *Pi, Vector2D *R);
+
+
 #endif
\ No newline at end of file
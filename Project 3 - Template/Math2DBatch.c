@@ -0,0 +1,220 @@
+#include <string.h>
+#include <xmmintrin.h>
+
+#include "Math2DBatch.h"
+#include "Math2D.h"
+
+
+// Number of set bits in a 4 bit SSE mask
+static const unsigned int sgMaskBitNum[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+
+/*
+Zeroes the masks of Num shapes
+*/
+static void ClearMasks(u32 *pMasks, unsigned int Num)
+{
+	memset(pMasks, 0, sizeof(u32) * ((Num + 31) >> 5));
+}
+
+
+/*
+Stores the 4 bit SSE mask of shapes i to i + 3 (i being a multiple of 4), and returns its bit count
+*/
+static unsigned int StoreMask(u32 *pMasks, unsigned int i, int Bits)
+{
+	pMasks[i >> 5] |= (u32)Bits << (i & 31);
+
+	return sgMaskBitNum[Bits];
+}
+
+
+/*
+Sets the bit of shape i if "Hit", and returns "Hit"
+*/
+static unsigned int StoreBit(u32 *pMasks, unsigned int i, int Hit)
+{
+	if (Hit)
+		pMasks[i >> 5] |= (u32)1 << (i & 31);
+
+	return Hit ? 1 : 0;
+}
+
+
+unsigned int StaticPointToStaticRectBatch(Vector2D *pPos, RectArray2D *pRects, u32 *pMasks)
+{
+	__m128 px = _mm_set1_ps(pPos->x);
+	__m128 py = _mm_set1_ps(pPos->y);
+	__m128 half = _mm_set1_ps(0.5f);
+	unsigned int i, hitNum = 0;
+
+	ClearMasks(pMasks, pRects->mNum);
+
+	for (i = 0; i + 4 <= pRects->mNum; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pRects->mpX + i);
+		__m128 y = _mm_loadu_ps(pRects->mpY + i);
+		__m128 halfWidth = _mm_mul_ps(_mm_loadu_ps(pRects->mpWidth + i), half);
+		__m128 halfHeight = _mm_mul_ps(_mm_loadu_ps(pRects->mpHeight + i), half);
+		__m128 inside;
+
+		inside = _mm_and_ps(_mm_cmpge_ps(px, _mm_sub_ps(x, halfWidth)), _mm_cmple_ps(px, _mm_add_ps(x, halfWidth)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(py, _mm_sub_ps(y, halfHeight)), _mm_cmple_ps(py, _mm_add_ps(y, halfHeight))));
+
+		hitNum += StoreMask(pMasks, i, _mm_movemask_ps(inside));
+	}
+
+	for (; i < pRects->mNum; ++i)
+	{
+		Vector2D rect;
+
+		Vector2DSet(&rect, pRects->mpX[i], pRects->mpY[i]);
+		hitNum += StoreBit(pMasks, i, StaticPointToStaticRect(pPos, &rect, pRects->mpWidth[i], pRects->mpHeight[i]));
+	}
+
+	return hitNum;
+}
+
+
+unsigned int StaticPointsToStaticRectBatch(PointArray2D *pPoints, Vector2D *pRect, float Width, float Height, u32 *pMasks)
+{
+	__m128 left = _mm_set1_ps(pRect->x - Width * 0.5f);
+	__m128 right = _mm_set1_ps(pRect->x + Width * 0.5f);
+	__m128 bottom = _mm_set1_ps(pRect->y - Height * 0.5f);
+	__m128 top = _mm_set1_ps(pRect->y + Height * 0.5f);
+	unsigned int i, hitNum = 0;
+
+	ClearMasks(pMasks, pPoints->mNum);
+
+	for (i = 0; i + 4 <= pPoints->mNum; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pPoints->mpX + i);
+		__m128 y = _mm_loadu_ps(pPoints->mpY + i);
+		__m128 inside;
+
+		inside = _mm_and_ps(_mm_cmpge_ps(x, left), _mm_cmple_ps(x, right));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(y, bottom), _mm_cmple_ps(y, top)));
+
+		hitNum += StoreMask(pMasks, i, _mm_movemask_ps(inside));
+	}
+
+	for (; i < pPoints->mNum; ++i)
+	{
+		Vector2D pos;
+
+		Vector2DSet(&pos, pPoints->mpX[i], pPoints->mpY[i]);
+		hitNum += StoreBit(pMasks, i, StaticPointToStaticRect(&pos, pRect, Width, Height));
+	}
+
+	return hitNum;
+}
+
+
+unsigned int StaticRectToStaticRectBatch(Vector2D *pRect, float Width, float Height, RectArray2D *pRects, u32 *pMasks)
+{
+	__m128 left = _mm_set1_ps(pRect->x - Width * 0.5f);
+	__m128 right = _mm_set1_ps(pRect->x + Width * 0.5f);
+	__m128 bottom = _mm_set1_ps(pRect->y - Height * 0.5f);
+	__m128 top = _mm_set1_ps(pRect->y + Height * 0.5f);
+	__m128 half = _mm_set1_ps(0.5f);
+	unsigned int i, hitNum = 0;
+
+	ClearMasks(pMasks, pRects->mNum);
+
+	for (i = 0; i + 4 <= pRects->mNum; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pRects->mpX + i);
+		__m128 y = _mm_loadu_ps(pRects->mpY + i);
+		__m128 halfWidth = _mm_mul_ps(_mm_loadu_ps(pRects->mpWidth + i), half);
+		__m128 halfHeight = _mm_mul_ps(_mm_loadu_ps(pRects->mpHeight + i), half);
+		__m128 overlap;
+
+		// Overlapping on both axes: no side of one is past the opposite side of the other
+		overlap = _mm_and_ps(_mm_cmple_ps(left, _mm_add_ps(x, halfWidth)), _mm_cmple_ps(_mm_sub_ps(x, halfWidth), right));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(bottom, _mm_add_ps(y, halfHeight)), _mm_cmple_ps(_mm_sub_ps(y, halfHeight), top)));
+
+		hitNum += StoreMask(pMasks, i, _mm_movemask_ps(overlap));
+	}
+
+	for (; i < pRects->mNum; ++i)
+	{
+		Vector2D rect;
+
+		Vector2DSet(&rect, pRects->mpX[i], pRects->mpY[i]);
+		hitNum += StoreBit(pMasks, i, StaticRectToStaticRect(pRect, Width, Height, &rect, pRects->mpWidth[i], pRects->mpHeight[i]));
+	}
+
+	return hitNum;
+}
+
+
+unsigned int StaticCircleToStaticRectangleBatch(Vector2D *pCenter, float Radius, RectArray2D *pRects, u32 *pMasks)
+{
+	__m128 cx = _mm_set1_ps(pCenter->x);
+	__m128 cy = _mm_set1_ps(pCenter->y);
+	__m128 radiusSquare = _mm_set1_ps(Radius * Radius);
+	__m128 half = _mm_set1_ps(0.5f);
+	unsigned int i, hitNum = 0;
+
+	ClearMasks(pMasks, pRects->mNum);
+
+	for (i = 0; i + 4 <= pRects->mNum; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pRects->mpX + i);
+		__m128 y = _mm_loadu_ps(pRects->mpY + i);
+		__m128 halfWidth = _mm_mul_ps(_mm_loadu_ps(pRects->mpWidth + i), half);
+		__m128 halfHeight = _mm_mul_ps(_mm_loadu_ps(pRects->mpHeight + i), half);
+		__m128 dx, dy;
+
+		// Offset from the rectangle's closest point (the center, clamped) to the center
+		dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, _mm_sub_ps(x, halfWidth)), _mm_add_ps(x, halfWidth)), cx);
+		dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, _mm_sub_ps(y, halfHeight)), _mm_add_ps(y, halfHeight)), cy);
+
+		hitNum += StoreMask(pMasks, i, _mm_movemask_ps(_mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), radiusSquare)));
+	}
+
+	for (; i < pRects->mNum; ++i)
+	{
+		Vector2D rect;
+
+		Vector2DSet(&rect, pRects->mpX[i], pRects->mpY[i]);
+		hitNum += StoreBit(pMasks, i, StaticCircleToStaticRectangle(pCenter, Radius, &rect, pRects->mpWidth[i], pRects->mpHeight[i]));
+	}
+
+	return hitNum;
+}
+
+
+unsigned int StaticCirclesToStaticRectangleBatch(CircleArray2D *pCircles, Vector2D *pRect, float Width, float Height, u32 *pMasks)
+{
+	__m128 left = _mm_set1_ps(pRect->x - Width * 0.5f);
+	__m128 right = _mm_set1_ps(pRect->x + Width * 0.5f);
+	__m128 bottom = _mm_set1_ps(pRect->y - Height * 0.5f);
+	__m128 top = _mm_set1_ps(pRect->y + Height * 0.5f);
+	unsigned int i, hitNum = 0;
+
+	ClearMasks(pMasks, pCircles->mNum);
+
+	for (i = 0; i + 4 <= pCircles->mNum; i += 4)
+	{
+		__m128 cx = _mm_loadu_ps(pCircles->mpX + i);
+		__m128 cy = _mm_loadu_ps(pCircles->mpY + i);
+		__m128 radius = _mm_loadu_ps(pCircles->mpRadius + i);
+		__m128 dx, dy;
+
+		dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, left), right), cx);
+		dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, bottom), top), cy);
+
+		hitNum += StoreMask(pMasks, i, _mm_movemask_ps(_mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(radius, radius))));
+	}
+
+	for (; i < pCircles->mNum; ++i)
+	{
+		Vector2D center;
+
+		Vector2DSet(&center, pCircles->mpX[i], pCircles->mpY[i]);
+		hitNum += StoreBit(pMasks, i, StaticCircleToStaticRectangle(&center, pCircles->mpRadius[i], pRect, Width, Height));
+	}
+
+	return hitNum;
+}
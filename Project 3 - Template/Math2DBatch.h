@@ -0,0 +1,72 @@
+#ifndef MATH2DBATCH_H
+#define MATH2DBATCH_H
+
+
+#include "AETypes.h"
+#include "Vector2D.h"
+
+
+////////////////////////////////////////////
+// Batched versions of the Math2D kernels //
+////////////////////////////////////////////
+
+/*
+Shapes are passed as structures of arrays, so 4 of them are tested per SSE
+instruction. The arrays don't need any alignment or padding.
+
+Results are bitmasks: bit (i & 31) of pMasks[i >> 5] is set if shape i overlaps,
+so pMasks must hold (Num + 31) / 32 words. Every function returns the number
+of overlaps, and matches its scalar version, edges included
+*/
+
+typedef struct PointArray2D
+{
+	float *mpX, *mpY;
+	unsigned int mNum;
+}PointArray2D;
+
+typedef struct CircleArray2D
+{
+	float *mpX, *mpY;				// Centers
+	float *mpRadius;
+	unsigned int mNum;
+}CircleArray2D;
+
+typedef struct RectArray2D
+{
+	float *mpX, *mpY;				// Centers
+	float *mpWidth, *mpHeight;
+	unsigned int mNum;
+}RectArray2D;
+
+
+/*
+Batched StaticPointToStaticRect: one point against N rectangles
+*/
+unsigned int StaticPointToStaticRectBatch(Vector2D *pPos, RectArray2D *pRects, u32 *pMasks);
+
+/*
+Batched StaticPointToStaticRect: N points against one rectangle
+*/
+unsigned int StaticPointsToStaticRectBatch(PointArray2D *pPoints, Vector2D *pRect, float Width, float Height, u32 *pMasks);
+
+/*
+Batched StaticRectToStaticRect: one rectangle against N rectangles.
+Also covers N rectangles against one, since the test is symmetric
+*/
+unsigned int StaticRectToStaticRectBatch(Vector2D *pRect, float Width, float Height, RectArray2D *pRects, u32 *pMasks);
+
+/*
+Batched StaticCircleToStaticRectangle: one circle against N rectangles
+*/
+unsigned int StaticCircleToStaticRectangleBatch(Vector2D *pCenter, float Radius, RectArray2D *pRects, u32 *pMasks);
+
+/*
+Batched StaticCircleToStaticRectangle: N circles against one rectangle
+*/
+unsigned int StaticCirclesToStaticRectangleBatch(CircleArray2D *pCircles, Vector2D *pRect, float Width, float Height, u32 *pMasks);
+
+
+
+
+#endif
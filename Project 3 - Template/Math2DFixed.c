@@ -0,0 +1,276 @@
+#include "Math2DFixed.h"
+#include "CollisionStats.h"
+
+
+/*
+Reflects V on the line whose unit normal is N: R = V - 2 (V.N) N, then normalizes R
+*/
+static void ReflectFixed(Vector2DFixed *V, Vector2DFixed *N, Vector2DFixed *R);
+
+/*
+Keeps P between the segment's end points, given that it's on the segment's line
+*/
+static int IsOnStaticLineSegmentFixed(Vector2DFixed *P, LineSegment2DFixed *LS);
+
+
+int StaticPointToStaticCircleFixed(Vector2DFixed *pP, Vector2DFixed *pCenter, Fixed Radius)
+{
+	if (Vector2DFixedSquareDistance(pP, pCenter) > FixedMulWide(Radius, Radius))
+	{
+		return 0;
+	}
+	return 1;
+}
+
+
+int StaticPointToStaticRectFixed(Vector2DFixed *pPos, Vector2DFixed *pRect, Fixed Width, Fixed Height)
+{
+	if (pPos->x < pRect->x - Width / 2 || pPos->x > pRect->x + Width / 2 || pPos->y < pRect->y - Height / 2 || pPos->y > pRect->y + Height / 2)
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+
+int StaticCircleToStaticCircleFixed(Vector2DFixed *pCenter0, Fixed Radius0, Vector2DFixed *pCenter1, Fixed Radius1)
+{
+	if (Vector2DFixedSquareDistance(pCenter0, pCenter1) > FixedMulWide(Radius0 + Radius1, Radius0 + Radius1))
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+
+int StaticRectToStaticRectFixed(Vector2DFixed *pRect0, Fixed Width0, Fixed Height0, Vector2DFixed *pRect1, Fixed Width1, Fixed Height1)
+{
+	if (pRect0->x - Width0 / 2 > pRect1->x + Width1 / 2 || pRect1->x - Width1 / 2 > pRect0->x + Width0 / 2 || pRect0->y - Height0 / 2 > pRect1->y + Height1 / 2 || pRect1->y - Height1 / 2 > pRect0->y + Height0 / 2)
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+
+int StaticCircleToStaticRectangleFixed(Vector2DFixed *pCenter, Fixed Radius, Vector2DFixed *pRect, Fixed Width, Fixed Height)
+{
+	Vector2DFixed closestPoint = *pCenter;
+
+	// Center, clamped to the rectangle
+	if (closestPoint.x > pRect->x + Width / 2)
+		closestPoint.x = pRect->x + Width / 2;
+	else
+	if (closestPoint.x < pRect->x - Width / 2)
+		closestPoint.x = pRect->x - Width / 2;
+
+	if (closestPoint.y > pRect->y + Height / 2)
+		closestPoint.y = pRect->y + Height / 2;
+	else
+	if (closestPoint.y < pRect->y - Height / 2)
+		closestPoint.y = pRect->y - Height / 2;
+
+	return StaticPointToStaticCircleFixed(&closestPoint, pCenter, Radius);
+}
+
+
+Fixed StaticPointToStaticLineSegmentFixed(Vector2DFixed *P, LineSegment2DFixed *LS)
+{
+	return FixedFromWide(Vector2DFixedDotProduct(&LS->mN, P) - LS->mNdotP0);
+}
+
+
+Fixed AnimatedPointToStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, LineSegment2DFixed *LS, Vector2DFixed *Pi)
+{
+	return AnimatedCircleToStaticLineSegmentFixed(Ps, Pe, 0, LS, Pi);
+}
+
+
+Fixed AnimatedCircleToStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Fixed Radius, LineSegment2DFixed *LS, Vector2DFixed *Pi)
+{
+	Vector2DFixed v, intersection;
+	Fixed ds, de, d, nv, t;
+
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	if (Pe->x == Ps->x && Pe->y == Ps->y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -FIXED_ONE;
+	}
+
+	ds = StaticPointToStaticLineSegmentFixed(Ps, LS);
+	de = StaticPointToStaticLineSegmentFixed(Pe, LS);
+
+	if ((ds < -Radius && de < -Radius) || (ds > Radius && de > Radius))
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_SAME_SIDE]);
+		return -FIXED_ONE;
+	}
+
+	// The circle touches the line when its center is at distance Radius, on its starting side
+	d = (ds < 0) ? -Radius : Radius;
+
+	Vector2DFixedSub(&v, Pe, Ps);
+	nv = FixedFromWide(Vector2DFixedDotProduct(&LS->mN, &v));
+
+	if (0 == nv)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_PARALLEL]);
+		return -FIXED_ONE;
+	}
+
+	t = FixedDiv(d - ds, nv);
+
+	if (t > FIXED_ONE || t < 0)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
+		return -FIXED_ONE;
+	}
+
+	Vector2DFixedScaleAdd(&intersection, &v, Ps, t);
+
+	if (0 == IsOnStaticLineSegmentFixed(&intersection, LS))
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_OUTSIDE_SEGMENT]);
+		return -FIXED_ONE;
+	}
+
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_LINE_SEGMENT]);
+
+	*Pi = intersection;
+	return t;
+}
+
+
+Fixed ReflectAnimatedPointOnStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, LineSegment2DFixed *LS, Vector2DFixed *Pi, Vector2DFixed *R)
+{
+	return ReflectAnimatedCircleOnStaticLineSegmentFixed(Ps, Pe, 0, LS, Pi, R);
+}
+
+
+Fixed ReflectAnimatedCircleOnStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Fixed Radius, LineSegment2DFixed *LS, Vector2DFixed *Pi, Vector2DFixed *R)
+{
+	Vector2DFixed i;
+	Fixed t = AnimatedCircleToStaticLineSegmentFixed(Ps, Pe, Radius, LS, Pi);
+
+	if (t < 0)
+	{
+		return -FIXED_ONE;
+	}
+
+	// Pe - Ps rather than Pe - Pi: same direction, and not 0 when t = 1
+	Vector2DFixedSub(&i, Pe, Ps);
+	ReflectFixed(&i, &LS->mN, R);
+
+	return t;
+}
+
+
+Fixed AnimatedPointToStaticCircleFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Vector2DFixed *Center, Fixed Radius, Vector2DFixed *Pi)
+{
+	Vector2DFixed v, bc, vUnit;
+	FixedWide radiusSquare, missSquare;
+	Fixed m, length, t;
+
+	COLLISION_STAT_INC(mTests[COLLISION_OBSTACLE_CIRCLE]);
+
+	if (Pe->x == Ps->x && Pe->y == Ps->y)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_NO_MOTION]);
+		return -FIXED_ONE;
+	}
+
+	Vector2DFixedSub(&v, Pe, Ps);
+	Vector2DFixedSub(&bc, Center, Ps);
+	Vector2DFixedNormalize(&vUnit, &v);
+
+	// Distance along the motion to the closest approach, and squared distance at the closest approach
+	m = FixedFromWide(Vector2DFixedDotProduct(&bc, &vUnit));
+	radiusSquare = FixedMulWide(Radius, Radius);
+	missSquare = Vector2DFixedSquareLength(&bc) - FixedMulWide(m, m);
+
+	if (m < 0 && Vector2DFixedSquareLength(&bc) > radiusSquare)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_MOVING_AWAY]);
+		return -FIXED_ONE;
+	}
+
+	if (missSquare > radiusSquare)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_MISS_DISTANCE]);
+		return -FIXED_ONE;
+	}
+
+	// Back from the closest approach to the entry point. Starting inside gives a negative time
+	length = Vector2DFixedLength(&v);
+	t = FixedDiv(m - FixedSqrt(radiusSquare - missSquare), length);
+
+	if (t > FIXED_ONE || t < 0)
+	{
+		COLLISION_STAT_INC(mEarlyOuts[COLLISION_EARLY_OUT_TIME_RANGE]);
+		return -FIXED_ONE;
+	}
+
+	COLLISION_STAT_INC(mHits[COLLISION_OBSTACLE_CIRCLE]);
+
+	Vector2DFixedScaleAdd(Pi, &v, Ps, t);
+	return t;
+}
+
+
+Fixed ReflectAnimatedPointOnStaticCircleFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Vector2DFixed *Center, Fixed Radius, Vector2DFixed *Pi, Vector2DFixed *R)
+{
+	Vector2DFixed i, n;
+	Fixed t = AnimatedPointToStaticCircleFixed(Ps, Pe, Center, Radius, Pi);
+
+	if (t < 0)
+	{
+		return -FIXED_ONE;
+	}
+
+	// Same reflection as the line segment's, on the tangent at Pi
+	Vector2DFixedSub(&i, Pi, Ps);
+	Vector2DFixedSub(&n, Pi, Center);
+	Vector2DFixedNormalize(&n, &n);
+	ReflectFixed(&i, &n, R);
+
+	return t;
+}
+
+
+Fixed AnimatedCircleToStaticCircleFixed(Vector2DFixed *Center0s, Vector2DFixed *Center0e, Fixed Radius0, Vector2DFixed *Center1, Fixed Radius1, Vector2DFixed *Pi)
+{
+	return AnimatedPointToStaticCircleFixed(Center0s, Center0e, Center1, Radius0 + Radius1, Pi);
+}
+
+
+Fixed ReflectAnimatedCircleOnStaticCircleFixed(Vector2DFixed *Center0s, Vector2DFixed *Center0e, Fixed Radius0, Vector2DFixed *Center1, Fixed Radius1, Vector2DFixed *Pi, Vector2DFixed *R)
+{
+	return ReflectAnimatedPointOnStaticCircleFixed(Center0s, Center0e, Center1, Radius0 + Radius1, Pi, R);
+}
+
+
+void ReflectFixed(Vector2DFixed *V, Vector2DFixed *N, Vector2DFixed *R)
+{
+	Fixed vn = FixedFromWide(Vector2DFixedDotProduct(V, N));
+
+	Vector2DFixedScaleSub(R, N, V, 2 * vn);
+	Vector2DFixedNeg(R, R);
+	Vector2DFixedNormalize(R, R);
+}
+
+
+int IsOnStaticLineSegmentFixed(Vector2DFixed *P, LineSegment2DFixed *LS)
+{
+	Vector2DFixed line, toP0, toP1;
+
+	Vector2DFixedSub(&line, &LS->mP1, &LS->mP0);
+	Vector2DFixedSub(&toP0, P, &LS->mP0);
+	Vector2DFixedSub(&toP1, P, &LS->mP1);
+
+	return Vector2DFixedDotProduct(&line, &toP0) >= 0 && Vector2DFixedDotProduct(&line, &toP1) <= 0;
+}
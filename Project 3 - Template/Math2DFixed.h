@@ -0,0 +1,57 @@
+#ifndef MATH2DFIXED_H
+#define MATH2DFIXED_H
+
+
+#include "LineSegment2DFixed.h"
+
+
+////////////////////////////////////////////////////
+// Fixed-point versions of the Math2D kernels     //
+// for the deterministic (lockstep) simulation    //
+////////////////////////////////////////////////////
+
+/*
+Same parameters and results as their Math2D counterparts, in 16.16 fixed point.
+Times are Fixed too: -FIXED_ONE if there's no intersection.
+
+The results are bit-identical on every build, so peers running the same inputs
+stay in sync without exchanging positions. They are close to, but not the same as,
+the float results.
+
+The circle tests solve for the entry point from the closest approach (distance along
+the motion, then back by sqrt(R^2 - miss distance^2)) rather than with the quadratic
+formula, whose b^2 - 4ac overflows 64 bits at room scale.
+*/
+
+
+int StaticPointToStaticCircleFixed(Vector2DFixed *pP, Vector2DFixed *pCenter, Fixed Radius);
+
+int StaticPointToStaticRectFixed(Vector2DFixed *pPos, Vector2DFixed *pRect, Fixed Width, Fixed Height);
+
+int StaticCircleToStaticCircleFixed(Vector2DFixed *pCenter0, Fixed Radius0, Vector2DFixed *pCenter1, Fixed Radius1);
+
+int StaticRectToStaticRectFixed(Vector2DFixed *pRect0, Fixed Width0, Fixed Height0, Vector2DFixed *pRect1, Fixed Width1, Fixed Height1);
+
+int StaticCircleToStaticRectangleFixed(Vector2DFixed *pCenter, Fixed Radius, Vector2DFixed *pRect, Fixed Width, Fixed Height);
+
+Fixed StaticPointToStaticLineSegmentFixed(Vector2DFixed *P, LineSegment2DFixed *LS);
+
+Fixed AnimatedPointToStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, LineSegment2DFixed *LS, Vector2DFixed *Pi);
+
+Fixed AnimatedCircleToStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Fixed Radius, LineSegment2DFixed *LS, Vector2DFixed *Pi);
+
+Fixed ReflectAnimatedPointOnStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, LineSegment2DFixed *LS, Vector2DFixed *Pi, Vector2DFixed *R);
+
+Fixed ReflectAnimatedCircleOnStaticLineSegmentFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Fixed Radius, LineSegment2DFixed *LS, Vector2DFixed *Pi, Vector2DFixed *R);
+
+Fixed AnimatedPointToStaticCircleFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Vector2DFixed *Center, Fixed Radius, Vector2DFixed *Pi);
+
+Fixed ReflectAnimatedPointOnStaticCircleFixed(Vector2DFixed *Ps, Vector2DFixed *Pe, Vector2DFixed *Center, Fixed Radius, Vector2DFixed *Pi, Vector2DFixed *R);
+
+Fixed AnimatedCircleToStaticCircleFixed(Vector2DFixed *Center0s, Vector2DFixed *Center0e, Fixed Radius0, Vector2DFixed *Center1, Fixed Radius1, Vector2DFixed *Pi);
+
+Fixed ReflectAnimatedCircleOnStaticCircleFixed(Vector2DFixed *Center0s, Vector2DFixed *Center0e, Fixed Radius0, Vector2DFixed *Center1, Fixed Radius1, Vector2DFixed *Pi, Vector2DFixed *R);
+
+
+
+#endif
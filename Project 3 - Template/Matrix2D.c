@@ -1,4 +1,5 @@
 #include "Matrix2D.h"
+#include "SinCos.h"
 
 
 
@@ -134,8 +135,12 @@ Save the resultant matrix in Result
 */
 void Matrix2DRotRad(Matrix2D *pResult, float Angle)
 {
-	pResult->m[0][0] = cosf(Angle);
-	pResult->m[0][1] = -1.f*sinf(Angle);
+	float sine, cosine;
+
+	SinCos(Angle, &sine, &cosine, SINCOS_ACCURACY_1E7);
+
+	pResult->m[0][0] = cosine;
+	pResult->m[0][1] = -1.f*sine;
 	pResult->m[0][2] = 0.f;
 	pResult->m[1][0] = -1.f*pResult->m[0][1];
 	pResult->m[1][1] = pResult->m[0][0];
@@ -0,0 +1,617 @@
+#include <math.h>
+#include <string.h>
+#include <emmintrin.h>
+
+#include "Matrix4D.h"
+#include "SinCos.h"
+
+
+// Number of set bits in a 4 bit SSE mask
+static const unsigned int sgMaskBitNum[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+
+/*
+The 16 entries of Mtx, each broadcast to the 4 lanes of a register
+*/
+typedef struct Matrix4DLanes
+{
+	__m128 m[4][4];
+}Matrix4DLanes;
+
+
+static void LoadLanes(Matrix4DLanes *pLanes, Matrix4D *pMtx)
+{
+	int i, j;
+
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			pLanes->m[i][j] = _mm_set1_ps(pMtx->m[i][j]);
+}
+
+
+/*
+Mtx * (x, y, z, w) on 4 points, summed in the same order as TransformPoint
+*/
+static void TransformLanes(Matrix4DLanes *pLanes, __m128 *pX, __m128 *pY, __m128 *pZ, __m128 *pW)
+{
+	__m128 r[4];
+	int i;
+
+	for (i = 0; i < 4; ++i)
+	{
+		r[i] = _mm_add_ps(_mm_mul_ps(pLanes->m[i][0], *pX), _mm_mul_ps(pLanes->m[i][1], *pY));
+		r[i] = _mm_add_ps(r[i], _mm_mul_ps(pLanes->m[i][2], *pZ));
+		r[i] = _mm_add_ps(r[i], _mm_mul_ps(pLanes->m[i][3], *pW));
+	}
+
+	*pX = r[0];
+	*pY = r[1];
+	*pZ = r[2];
+	*pW = r[3];
+}
+
+
+static void TransformPoint(Matrix4D *pMtx, float *pX, float *pY, float *pZ, float *pW)
+{
+	float r[4];
+	int i;
+
+	for (i = 0; i < 4; ++i)
+	{
+		r[i] = pMtx->m[i][0] * *pX + pMtx->m[i][1] * *pY;
+		r[i] = r[i] + pMtx->m[i][2] * *pZ;
+		r[i] = r[i] + pMtx->m[i][3] * *pW;
+	}
+
+	*pX = r[0];
+	*pY = r[1];
+	*pZ = r[2];
+	*pW = r[3];
+}
+
+
+/*
+Clip codes and perspective divide of 4 transformed points: stores the 4 codes, and returns the 4 bit mask of the inside ones
+*/
+static int ProjectLanes(__m128 *pX, __m128 *pY, __m128 *pZ, __m128 *pW, u8 *pClipCodes)
+{
+	__m128 negW = _mm_sub_ps(_mm_setzero_ps(), *pW);
+	__m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), *pW);
+	__m128i codes;
+	int packed;
+
+	codes = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(*pX, negW)), _mm_set1_epi32(CLIP_CODE_LEFT));
+	codes = _mm_or_si128(codes, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(*pX, *pW)), _mm_set1_epi32(CLIP_CODE_RIGHT)));
+	codes = _mm_or_si128(codes, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(*pY, negW)), _mm_set1_epi32(CLIP_CODE_BOTTOM)));
+	codes = _mm_or_si128(codes, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(*pY, *pW)), _mm_set1_epi32(CLIP_CODE_TOP)));
+	codes = _mm_or_si128(codes, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(*pZ, negW)), _mm_set1_epi32(CLIP_CODE_NEAR)));
+	codes = _mm_or_si128(codes, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(*pZ, *pW)), _mm_set1_epi32(CLIP_CODE_FAR)));
+
+	// 32 bit codes to 4 bytes
+	packed = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(codes, codes), _mm_setzero_si128()));
+	memcpy(pClipCodes, &packed, 4);
+
+	*pX = _mm_mul_ps(*pX, invW);
+	*pY = _mm_mul_ps(*pY, invW);
+	*pZ = _mm_mul_ps(*pZ, invW);
+	*pW = invW;
+
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(codes, _mm_setzero_si128())));
+}
+
+
+static int ProjectPoint(float *pX, float *pY, float *pZ, float *pW, u8 *pClipCode)
+{
+	float negW = 0.0f - *pW;
+	float invW = 1.0f / *pW;
+	int code = 0;
+
+	code |= (*pX < negW) ? CLIP_CODE_LEFT : 0;
+	code |= (*pX > *pW) ? CLIP_CODE_RIGHT : 0;
+	code |= (*pY < negW) ? CLIP_CODE_BOTTOM : 0;
+	code |= (*pY > *pW) ? CLIP_CODE_TOP : 0;
+	code |= (*pZ < negW) ? CLIP_CODE_NEAR : 0;
+	code |= (*pZ > *pW) ? CLIP_CODE_FAR : 0;
+
+	*pClipCode = (u8)code;
+
+	*pX = *pX * invW;
+	*pY = *pY * invW;
+	*pZ = *pZ * invW;
+	*pW = invW;
+
+	return (0 == code) ? 1 : 0;
+}
+
+
+/*
+Loads the 4 points of an array of structures into 4 registers of x, y, z and w
+*/
+static void LoadPoints(Vector4D *pPoints, __m128 *pX, __m128 *pY, __m128 *pZ, __m128 *pW)
+{
+	*pX = _mm_loadu_ps(&pPoints[0].x);
+	*pY = _mm_loadu_ps(&pPoints[1].x);
+	*pZ = _mm_loadu_ps(&pPoints[2].x);
+	*pW = _mm_loadu_ps(&pPoints[3].x);
+
+	_MM_TRANSPOSE4_PS(*pX, *pY, *pZ, *pW);
+}
+
+
+static void StorePoints(Vector4D *pPoints, __m128 X, __m128 Y, __m128 Z, __m128 W)
+{
+	_MM_TRANSPOSE4_PS(X, Y, Z, W);
+
+	_mm_storeu_ps(&pPoints[0].x, X);
+	_mm_storeu_ps(&pPoints[1].x, Y);
+	_mm_storeu_ps(&pPoints[2].x, Z);
+	_mm_storeu_ps(&pPoints[3].x, W);
+}
+
+
+/*
+Result = Vec0 x Vec1, on x, y and z
+*/
+static void Cross(Vector4D *pResult, Vector4D *pVec0, Vector4D *pVec1)
+{
+	Vector4D t;
+
+	t.x = pVec0->y * pVec1->z - pVec0->z * pVec1->y;
+	t.y = pVec0->z * pVec1->x - pVec0->x * pVec1->z;
+	t.z = pVec0->x * pVec1->y - pVec0->y * pVec1->x;
+	t.w = 0.0f;
+
+	*pResult = t;
+}
+
+
+static float Dot(Vector4D *pVec0, Vector4D *pVec1)
+{
+	return pVec0->x * pVec1->x + pVec0->y * pVec1->y + pVec0->z * pVec1->z;
+}
+
+
+static void Normalize(Vector4D *pResult, Vector4D *pVec0)
+{
+	float length = sqrtf(Dot(pVec0, pVec0));
+	float scale = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+	pResult->x = pVec0->x * scale;
+	pResult->y = pVec0->y * scale;
+	pResult->z = pVec0->z * scale;
+	pResult->w = 0.0f;
+}
+
+
+/*
+This function sets the matrix Result to the identity matrix
+*/
+void Matrix4DIdentity(Matrix4D *pResult)
+{
+	memset(pResult, 0, sizeof(Matrix4D));
+
+	pResult->m[0][0] = 1.f;
+	pResult->m[1][1] = 1.f;
+	pResult->m[2][2] = 1.f;
+	pResult->m[3][3] = 1.f;
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+This functions calculated the transpose matrix of Mtx and saves it in Result
+*/
+void Matrix4DTranspose(Matrix4D *pResult, Matrix4D *pMtx)
+{
+	__m128 r0 = _mm_loadu_ps(pMtx->m[0]);
+	__m128 r1 = _mm_loadu_ps(pMtx->m[1]);
+	__m128 r2 = _mm_loadu_ps(pMtx->m[2]);
+	__m128 r3 = _mm_loadu_ps(pMtx->m[3]);
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	_mm_storeu_ps(pResult->m[0], r0);
+	_mm_storeu_ps(pResult->m[1], r1);
+	_mm_storeu_ps(pResult->m[2], r2);
+	_mm_storeu_ps(pResult->m[3], r3);
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+This function multiplies Mtx0 with Mtx1 and saves the result in Result
+Result = Mtx0*Mtx1
+*/
+void Matrix4DConcat(Matrix4D *pResult, Matrix4D *pMtx0, Matrix4D *pMtx1)
+{
+	__m128 b0 = _mm_loadu_ps(pMtx1->m[0]);
+	__m128 b1 = _mm_loadu_ps(pMtx1->m[1]);
+	__m128 b2 = _mm_loadu_ps(pMtx1->m[2]);
+	__m128 b3 = _mm_loadu_ps(pMtx1->m[3]);
+	__m128 r[4];
+	int i;
+
+	// Row i of the result: the rows of Mtx1, weighted by row i of Mtx0
+	for (i = 0; i < 4; ++i)
+	{
+		r[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(pMtx0->m[i][0]), b0), _mm_mul_ps(_mm_set1_ps(pMtx0->m[i][1]), b1));
+		r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(pMtx0->m[i][2]), b2));
+		r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(pMtx0->m[i][3]), b3));
+	}
+
+	// Stored once both are read, Result can be either
+	for (i = 0; i < 4; ++i)
+		_mm_storeu_ps(pResult->m[i], r[i]);
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+This function multiplies the matrix Mtx with the vector Vec and saves the result in Result
+Result = Mtx * Vec
+*/
+void Matrix4DMultVec(Vector4D *pResult, Matrix4D *pMtx, Vector4D *pVec)
+{
+	Vector4D t = *pVec;
+
+	TransformPoint(pMtx, &t.x, &t.y, &t.z, &t.w);
+
+	*pResult = t;
+}
+
+// ---------------------------------------------------------------------------
+
+float Matrix4DDeterminant(Matrix4D *pMtx)
+{
+	float (*m)[4] = pMtx->m;
+
+	// 2x2 determinants of the bottom 2 rows
+	float s01 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+	float s02 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+	float s03 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+	float s12 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+	float s13 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+	float s23 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+
+	// Cofactors of the first row
+	float c0 = m[1][1] * s23 - m[1][2] * s13 + m[1][3] * s12;
+	float c1 = m[1][0] * s23 - m[1][2] * s03 + m[1][3] * s02;
+	float c2 = m[1][0] * s13 - m[1][1] * s03 + m[1][3] * s01;
+	float c3 = m[1][0] * s12 - m[1][1] * s02 + m[1][2] * s01;
+
+	return m[0][0] * c0 - m[0][1] * c1 + m[0][2] * c2 - m[0][3] * c3;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DScale(Matrix4D *pResult, float x, float y, float z)
+{
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = x;
+	pResult->m[1][1] = y;
+	pResult->m[2][2] = z;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DTranslate(Matrix4D *pResult, float x, float y, float z)
+{
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][3] = x;
+	pResult->m[1][3] = y;
+	pResult->m[2][3] = z;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DRotXRad(Matrix4D *pResult, float Angle)
+{
+	float s, c;
+
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+	Matrix4DIdentity(pResult);
+
+	pResult->m[1][1] = c;
+	pResult->m[1][2] = -s;
+	pResult->m[2][1] = s;
+	pResult->m[2][2] = c;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DRotYRad(Matrix4D *pResult, float Angle)
+{
+	float s, c;
+
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = c;
+	pResult->m[0][2] = s;
+	pResult->m[2][0] = -s;
+	pResult->m[2][2] = c;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DRotZRad(Matrix4D *pResult, float Angle)
+{
+	float s, c;
+
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = c;
+	pResult->m[0][1] = -s;
+	pResult->m[1][0] = s;
+	pResult->m[1][1] = c;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DRotAxisRad(Matrix4D *pResult, Vector4D *pAxis, float Angle)
+{
+	Vector4D a;
+	float s, c, t;
+
+	Normalize(&a, pAxis);
+	SinCos(Angle, &s, &c, SINCOS_ACCURACY_1E7);
+	t = 1.0f - c;
+
+	// Rodrigues: c * I + (1 - c) * a * aT + s * [a]x
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = c + t * a.x * a.x;
+	pResult->m[0][1] = t * a.x * a.y - s * a.z;
+	pResult->m[0][2] = t * a.x * a.z + s * a.y;
+	pResult->m[1][0] = t * a.x * a.y + s * a.z;
+	pResult->m[1][1] = c + t * a.y * a.y;
+	pResult->m[1][2] = t * a.y * a.z - s * a.x;
+	pResult->m[2][0] = t * a.x * a.z - s * a.y;
+	pResult->m[2][1] = t * a.y * a.z + s * a.x;
+	pResult->m[2][2] = c + t * a.z * a.z;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DRotOrthogonal(Matrix4D *pResult, Vector4D *pU, Vector4D *pV, Vector4D *pW)
+{
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = pU->x;
+	pResult->m[0][1] = pU->y;
+	pResult->m[0][2] = pU->z;
+	pResult->m[1][0] = pV->x;
+	pResult->m[1][1] = pV->y;
+	pResult->m[1][2] = pV->z;
+	pResult->m[2][0] = pW->x;
+	pResult->m[2][1] = pW->y;
+	pResult->m[2][2] = pW->z;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DLookAt(Matrix4D *pResult, Vector4D *pPosition, Vector4D *pTarget, Vector4D *pUp)
+{
+	Vector4D forward, right, up;
+
+	forward.x = pTarget->x - pPosition->x;
+	forward.y = pTarget->y - pPosition->y;
+	forward.z = pTarget->z - pPosition->z;
+	Normalize(&forward, &forward);
+
+	Cross(&right, &forward, pUp);
+	Normalize(&right, &right);
+	Cross(&up, &right, &forward);
+
+	// The camera frame is (right, up, -forward), centered on Position
+	forward.x = -forward.x;
+	forward.y = -forward.y;
+	forward.z = -forward.z;
+
+	Matrix4DRotOrthogonal(pResult, &right, &up, &forward);
+
+	pResult->m[0][3] = -Dot(&right, pPosition);
+	pResult->m[1][3] = -Dot(&up, pPosition);
+	pResult->m[2][3] = -Dot(&forward, pPosition);
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DOrthogonalProjection(Matrix4D *pResult, float Left, float Right, float Bottom, float Top, float Near, float Far)
+{
+	Matrix4DIdentity(pResult);
+
+	pResult->m[0][0] = 2.0f / (Right - Left);
+	pResult->m[0][3] = -(Right + Left) / (Right - Left);
+	pResult->m[1][1] = 2.0f / (Top - Bottom);
+	pResult->m[1][3] = -(Top + Bottom) / (Top - Bottom);
+	pResult->m[2][2] = -2.0f / (Far - Near);
+	pResult->m[2][3] = -(Far + Near) / (Far - Near);
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DPerspectiveProjection(Matrix4D *pResult, float FovY, float AspectRatio, float Near, float Far)
+{
+	float f = 1.0f / tanf(0.5f * FovY);
+
+	memset(pResult, 0, sizeof(Matrix4D));
+
+	pResult->m[0][0] = f / AspectRatio;
+	pResult->m[1][1] = f;
+	pResult->m[2][2] = (Far + Near) / (Near - Far);
+	pResult->m[2][3] = 2.0f * Far * Near / (Near - Far);
+	pResult->m[3][2] = -1.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+int Matrix4DNormalMatrix(Matrix4D *pResult, Matrix4D *pMtx)
+{
+	Vector4D r0, r1, r2, c0, c1, c2;
+	float det;
+
+	r0.x = pMtx->m[0][0]; r0.y = pMtx->m[0][1]; r0.z = pMtx->m[0][2];
+	r1.x = pMtx->m[1][0]; r1.y = pMtx->m[1][1]; r1.z = pMtx->m[1][2];
+	r2.x = pMtx->m[2][0]; r2.y = pMtx->m[2][1]; r2.z = pMtx->m[2][2];
+
+	// The rows of the inverse transpose are the cross products of the rows, over the determinant
+	Cross(&c0, &r1, &r2);
+	Cross(&c1, &r2, &r0);
+	Cross(&c2, &r0, &r1);
+	det = Dot(&r0, &c0);
+
+	if (0.0f == det)
+	{
+		Matrix4DIdentity(pResult);
+		return 0;
+	}
+
+	det = 1.0f / det;
+	c0.x *= det; c0.y *= det; c0.z *= det;
+	c1.x *= det; c1.y *= det; c1.z *= det;
+	c2.x *= det; c2.y *= det; c2.z *= det;
+
+	Matrix4DRotOrthogonal(pResult, &c0, &c1, &c2);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DTransformPoints(Matrix4D *pMtx, Vector4D *pResult, Vector4D *pPoints, unsigned int Num)
+{
+	Matrix4DLanes lanes;
+	unsigned int i;
+
+	LoadLanes(&lanes, pMtx);
+
+	for (i = 0; i + 4 <= Num; i += 4)
+	{
+		__m128 x, y, z, w;
+
+		LoadPoints(pPoints + i, &x, &y, &z, &w);
+		TransformLanes(&lanes, &x, &y, &z, &w);
+		StorePoints(pResult + i, x, y, z, w);
+	}
+
+	for (; i < Num; ++i)
+		Matrix4DMultVec(pResult + i, pMtx, pPoints + i);
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix4DTransformPointArray(Matrix4D *pMtx, PointArray4D *pResult, PointArray4D *pPoints)
+{
+	Matrix4DLanes lanes;
+	unsigned int i, num = pPoints->mNum;
+
+	LoadLanes(&lanes, pMtx);
+
+	for (i = 0; i + 4 <= num; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pPoints->mpX + i);
+		__m128 y = _mm_loadu_ps(pPoints->mpY + i);
+		__m128 z = _mm_loadu_ps(pPoints->mpZ + i);
+		__m128 w = _mm_loadu_ps(pPoints->mpW + i);
+
+		TransformLanes(&lanes, &x, &y, &z, &w);
+
+		_mm_storeu_ps(pResult->mpX + i, x);
+		_mm_storeu_ps(pResult->mpY + i, y);
+		_mm_storeu_ps(pResult->mpZ + i, z);
+		_mm_storeu_ps(pResult->mpW + i, w);
+	}
+
+	for (; i < num; ++i)
+	{
+		float x = pPoints->mpX[i], y = pPoints->mpY[i], z = pPoints->mpZ[i], w = pPoints->mpW[i];
+
+		TransformPoint(pMtx, &x, &y, &z, &w);
+
+		pResult->mpX[i] = x;
+		pResult->mpY[i] = y;
+		pResult->mpZ[i] = z;
+		pResult->mpW[i] = w;
+	}
+
+	pResult->mNum = num;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int Matrix4DProjectPoints(Matrix4D *pMtx, Vector4D *pResult, Vector4D *pPoints, u8 *pClipCodes, unsigned int Num)
+{
+	Matrix4DLanes lanes;
+	unsigned int i, insideNum = 0;
+
+	LoadLanes(&lanes, pMtx);
+
+	for (i = 0; i + 4 <= Num; i += 4)
+	{
+		__m128 x, y, z, w;
+
+		LoadPoints(pPoints + i, &x, &y, &z, &w);
+		TransformLanes(&lanes, &x, &y, &z, &w);
+		insideNum += sgMaskBitNum[ProjectLanes(&x, &y, &z, &w, pClipCodes + i)];
+		StorePoints(pResult + i, x, y, z, w);
+	}
+
+	for (; i < Num; ++i)
+	{
+		Vector4D t = pPoints[i];
+
+		TransformPoint(pMtx, &t.x, &t.y, &t.z, &t.w);
+		insideNum += ProjectPoint(&t.x, &t.y, &t.z, &t.w, pClipCodes + i);
+
+		pResult[i] = t;
+	}
+
+	return insideNum;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int Matrix4DProjectPointArray(Matrix4D *pMtx, PointArray4D *pResult, PointArray4D *pPoints, u8 *pClipCodes)
+{
+	Matrix4DLanes lanes;
+	unsigned int i, num = pPoints->mNum, insideNum = 0;
+
+	LoadLanes(&lanes, pMtx);
+
+	for (i = 0; i + 4 <= num; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(pPoints->mpX + i);
+		__m128 y = _mm_loadu_ps(pPoints->mpY + i);
+		__m128 z = _mm_loadu_ps(pPoints->mpZ + i);
+		__m128 w = _mm_loadu_ps(pPoints->mpW + i);
+
+		TransformLanes(&lanes, &x, &y, &z, &w);
+		insideNum += sgMaskBitNum[ProjectLanes(&x, &y, &z, &w, pClipCodes + i)];
+
+		_mm_storeu_ps(pResult->mpX + i, x);
+		_mm_storeu_ps(pResult->mpY + i, y);
+		_mm_storeu_ps(pResult->mpZ + i, z);
+		_mm_storeu_ps(pResult->mpW + i, w);
+	}
+
+	for (; i < num; ++i)
+	{
+		float x = pPoints->mpX[i], y = pPoints->mpY[i], z = pPoints->mpZ[i], w = pPoints->mpW[i];
+
+		TransformPoint(pMtx, &x, &y, &z, &w);
+		insideNum += ProjectPoint(&x, &y, &z, &w, pClipCodes + i);
+
+		pResult->mpX[i] = x;
+		pResult->mpY[i] = y;
+		pResult->mpZ[i] = z;
+		pResult->mpW[i] = w;
+	}
+
+	pResult->mNum = num;
+
+	return insideNum;
+}
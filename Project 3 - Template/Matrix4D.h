@@ -0,0 +1,147 @@
+#ifndef MATRIX4D_H
+#define MATRIX4D_H
+
+
+#include "AETypes.h"
+
+
+/*
+The 3D pipeline math of 3DPipelineTools.h, in C: 4x4 matrices applied to column
+vectors (Result = Mtx * Vec), m[row][column] like Matrix2D. Angles are in radian.
+
+The projections follow OpenGL: the camera looks down -z, and a point is in the
+view volume if -w <= x, y, z <= w once projected
+*/
+
+typedef struct Vector4D
+{
+	float x, y, z, w;
+}Vector4D;
+
+typedef struct Matrix4D
+{
+	float m[4][4];
+}Matrix4D;
+
+/*
+Points as a structure of arrays, like the Math2DBatch shapes. The arrays don't
+need any alignment or padding
+*/
+typedef struct PointArray4D
+{
+	float *mpX, *mpY, *mpZ, *mpW;
+	unsigned int mNum;
+}PointArray4D;
+
+// Sides of the view volume a projected point is out of
+enum CLIP_CODE
+{
+	CLIP_CODE_LEFT		= 1 << 0,			// x < -w
+	CLIP_CODE_RIGHT		= 1 << 1,			// x > w
+	CLIP_CODE_BOTTOM	= 1 << 2,			// y < -w
+	CLIP_CODE_TOP		= 1 << 3,			// y > w
+	CLIP_CODE_NEAR		= 1 << 4,			// z < -w
+	CLIP_CODE_FAR		= 1 << 5			// z > w
+};
+
+
+/*
+This function sets the matrix Result to the identity matrix
+*/
+void Matrix4DIdentity(Matrix4D *pResult);
+
+/*
+This functions calculated the transpose matrix of Mtx and saves it in Result
+*/
+void Matrix4DTranspose(Matrix4D *pResult, Matrix4D *pMtx);
+
+/*
+This function multiplies Mtx0 with Mtx1 and saves the result in Result
+Result = Mtx0*Mtx1
+*/
+void Matrix4DConcat(Matrix4D *pResult, Matrix4D *pMtx0, Matrix4D *pMtx1);
+
+/*
+This function multiplies the matrix Mtx with the vector Vec and saves the result in Result
+Result = Mtx * Vec
+*/
+void Matrix4DMultVec(Vector4D *pResult, Matrix4D *pMtx, Vector4D *pVec);
+
+float Matrix4DDeterminant(Matrix4D *pMtx);
+
+void Matrix4DScale(Matrix4D *pResult, float x, float y, float z);
+void Matrix4DTranslate(Matrix4D *pResult, float x, float y, float z);
+void Matrix4DRotXRad(Matrix4D *pResult, float Angle);
+void Matrix4DRotYRad(Matrix4D *pResult, float Angle);
+void Matrix4DRotZRad(Matrix4D *pResult, float Angle);
+
+/*
+Rotation of "Angle" around Axis (x, y, z: w is ignored). Axis doesn't need to be normalized
+*/
+void Matrix4DRotAxisRad(Matrix4D *pResult, Vector4D *pAxis, float Angle);
+
+/*
+Rotation to the orthonormal frame (U, V, W): its rows are U, V and W
+*/
+void Matrix4DRotOrthogonal(Matrix4D *pResult, Vector4D *pU, Vector4D *pV, Vector4D *pW);
+
+/*
+World to camera: the camera at Position, looking at Target, with Up roughly up
+*/
+void Matrix4DLookAt(Matrix4D *pResult, Vector4D *pPosition, Vector4D *pTarget, Vector4D *pUp);
+
+void Matrix4DOrthogonalProjection(Matrix4D *pResult, float Left, float Right, float Bottom, float Top, float Near, float Far);
+
+/*
+FovY: the vertical field of view. AspectRatio: width / height
+*/
+void Matrix4DPerspectiveProjection(Matrix4D *pResult, float FovY, float AspectRatio, float Near, float Far);
+
+/*
+The matrix transforming the normals of the points Mtx transforms: the inverse
+transpose of its upper 3x3, without translation.
+Returns 0, and the identity, if that 3x3 can't be inverted
+*/
+int Matrix4DNormalMatrix(Matrix4D *pResult, Matrix4D *pMtx);
+
+
+/////////////////////////////
+// Batched vertex pipeline //
+/////////////////////////////
+
+/*
+The batch functions run 4 points per SSE instruction, and give the same results
+as Matrix4DMultVec, bit for bit.
+Result can be the input, to work in place; other overlaps aren't supported.
+They only touch the arrays they're given: split a big batch over JobParallelFor
+to use every core
+*/
+
+/*
+Result[i] = Mtx * Points[i], i in [0, Num)
+*/
+void Matrix4DTransformPoints(Matrix4D *pMtx, Vector4D *pResult, Vector4D *pPoints, unsigned int Num);
+
+/*
+Same on a structure of arrays. Result must hold as many points as Points
+*/
+void Matrix4DTransformPointArray(Matrix4D *pMtx, PointArray4D *pResult, PointArray4D *pPoints);
+
+/*
+Projects the points: Result[i] = Mtx * Points[i], then
+	- ClipCodes[i] gets the CLIP_CODE bits of the sides of the view volume it's out of
+	- x, y and z are divided by w, and w becomes 1 / w for perspective correct interpolation
+
+The divide happens for every point: only the ones with a 0 clip code are sure
+to have meaningful normalized coordinates. Returns the number of those
+*/
+unsigned int Matrix4DProjectPoints(Matrix4D *pMtx, Vector4D *pResult, Vector4D *pPoints, u8 *pClipCodes, unsigned int Num);
+
+/*
+Same on a structure of arrays
+*/
+unsigned int Matrix4DProjectPointArray(Matrix4D *pMtx, PointArray4D *pResult, PointArray4D *pPoints, u8 *pClipCodes);
+
+
+
+#endif
@@ -0,0 +1,358 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	ObstacleGrid.c
+// Creation Date	:	2026/10/19
+// Purpose			:	uniform grid over the static obstacles, built once per
+//						level, with SSE friendly cell lists
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <xmmintrin.h>
+
+#include "ObstacleGrid.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define GRID_MIN(a, b)		((a) < (b) ? (a) : (b))
+#define GRID_MAX(a, b)		((a) > (b) ? (a) : (b))
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void BinSegment(ObstacleGrid *pGrid, u32 Id, u32 *pCursors, int Fill);
+static void BinCircle(ObstacleGrid *pGrid, u32 Id, u32 *pCursors, int Fill);
+static u32 PadCounts(u32 *pStart, u32 *pCounts, s32 CellNum);
+static float* AllocateFloats(u32 Num, float PadValue);
+
+// ---------------------------------------------------------------------------
+
+int ObstacleGridBuild(ObstacleGrid *pGrid, const LineSegment2D *pSegments, u32 SegmentNum, const Vector2D *pCircleCenters, const float *pCircleRadii, u32 CircleNum, float CellSize, float Margin)
+{
+	Vector2D maxPoint;
+	float width, height;
+	s32 cellNum;
+	u32 i, *pCounts;
+
+	memset(pGrid, 0, sizeof(ObstacleGrid));
+
+	pGrid->mpSegments = pSegments;
+	pGrid->mSegmentNum = SegmentNum;
+	pGrid->mpCircleCenters = pCircleCenters;
+	pGrid->mpCircleRadii = pCircleRadii;
+	pGrid->mCircleNum = CircleNum;
+	pGrid->mMargin = Margin;
+
+	// Bounds of the obstacles
+	Vector2DSet(&pGrid->mMin, 0.0f, 0.0f);
+	Vector2DSet(&maxPoint, 0.0f, 0.0f);
+
+	for (i = 0; i < SegmentNum; ++i)
+	{
+		const LineSegment2D *pSegment = pSegments + i;
+
+		if (0 == i)
+		{
+			pGrid->mMin = pSegment->mP0;
+			maxPoint = pSegment->mP0;
+		}
+
+		pGrid->mMin.x = GRID_MIN(pGrid->mMin.x, GRID_MIN(pSegment->mP0.x, pSegment->mP1.x));
+		pGrid->mMin.y = GRID_MIN(pGrid->mMin.y, GRID_MIN(pSegment->mP0.y, pSegment->mP1.y));
+		maxPoint.x = GRID_MAX(maxPoint.x, GRID_MAX(pSegment->mP0.x, pSegment->mP1.x));
+		maxPoint.y = GRID_MAX(maxPoint.y, GRID_MAX(pSegment->mP0.y, pSegment->mP1.y));
+	}
+
+	for (i = 0; i < CircleNum; ++i)
+	{
+		const Vector2D *pCenter = pCircleCenters + i;
+		float radius = pCircleRadii[i];
+
+		if (0 == i && 0 == SegmentNum)
+		{
+			pGrid->mMin = *pCenter;
+			maxPoint = *pCenter;
+		}
+
+		pGrid->mMin.x = GRID_MIN(pGrid->mMin.x, pCenter->x - radius);
+		pGrid->mMin.y = GRID_MIN(pGrid->mMin.y, pCenter->y - radius);
+		maxPoint.x = GRID_MAX(maxPoint.x, pCenter->x + radius);
+		maxPoint.y = GRID_MAX(maxPoint.y, pCenter->y + radius);
+	}
+
+	pGrid->mMin.x -= Margin;
+	pGrid->mMin.y -= Margin;
+	maxPoint.x += Margin;
+	maxPoint.y += Margin;
+
+	width = maxPoint.x - pGrid->mMin.x;
+	height = maxPoint.y - pGrid->mMin.y;
+
+	// Cell size
+	if (CellSize <= 0.0f)
+	{
+		CellSize = sqrtf(width * height / GRID_MAX(1, SegmentNum + CircleNum));
+
+		if (CellSize <= 0.0f)
+			CellSize = GRID_MAX(width, height);
+		if (CellSize <= 0.0f)
+			CellSize = 1.0f;
+	}
+
+	for (;;)
+	{
+		pGrid->mCellsX = (s32)(width / CellSize) + 1;
+		pGrid->mCellsY = (s32)(height / CellSize) + 1;
+
+		if ((double)pGrid->mCellsX * pGrid->mCellsY <= OBSTACLE_GRID_CELL_NUM_MAX)
+			break;
+
+		CellSize *= 2.0f;
+	}
+
+	pGrid->mCellSize = CellSize;
+	pGrid->mInvCellSize = 1.0f / CellSize;
+	cellNum = pGrid->mCellsX * pGrid->mCellsY;
+
+	// Count, pad the counts to the lane width, then fill through per cell cursors
+	pCounts = (u32 *)calloc(cellNum, sizeof(u32));
+	pGrid->mpSegmentStart = (u32 *)malloc(sizeof(u32) * (cellNum + 1));
+	pGrid->mpCircleStart = (u32 *)malloc(sizeof(u32) * (cellNum + 1));
+
+	if (0 == pCounts || 0 == pGrid->mpSegmentStart || 0 == pGrid->mpCircleStart)
+	{
+		free(pCounts);
+		ObstacleGridFree(pGrid);
+		return 0;
+	}
+
+	// Line segments
+	for (i = 0; i < SegmentNum; ++i)
+		BinSegment(pGrid, i, pCounts, 0);
+
+	pGrid->mSegmentSlotNum = PadCounts(pGrid->mpSegmentStart, pCounts, cellNum);
+	pGrid->mpSegmentIds = (u32 *)malloc(sizeof(u32) * GRID_MAX(1, pGrid->mSegmentSlotNum));
+	pGrid->mpSegmentX0 = AllocateFloats(pGrid->mSegmentSlotNum, OBSTACLE_GRID_PAD_POSITION);
+	pGrid->mpSegmentY0 = AllocateFloats(pGrid->mSegmentSlotNum, OBSTACLE_GRID_PAD_POSITION);
+	pGrid->mpSegmentDX = AllocateFloats(pGrid->mSegmentSlotNum, 0.0f);
+	pGrid->mpSegmentDY = AllocateFloats(pGrid->mSegmentSlotNum, 0.0f);
+
+	if (0 == pGrid->mpSegmentIds || 0 == pGrid->mpSegmentX0 || 0 == pGrid->mpSegmentY0 || 0 == pGrid->mpSegmentDX || 0 == pGrid->mpSegmentDY)
+	{
+		free(pCounts);
+		ObstacleGridFree(pGrid);
+		return 0;
+	}
+
+	for (i = 0; i < pGrid->mSegmentSlotNum; ++i)
+		pGrid->mpSegmentIds[i] = OBSTACLE_GRID_PAD_ID;
+
+	memcpy(pCounts, pGrid->mpSegmentStart, sizeof(u32) * cellNum);
+	for (i = 0; i < SegmentNum; ++i)
+		BinSegment(pGrid, i, pCounts, 1);
+
+	// Circles
+	memset(pCounts, 0, sizeof(u32) * cellNum);
+	for (i = 0; i < CircleNum; ++i)
+		BinCircle(pGrid, i, pCounts, 0);
+
+	pGrid->mCircleSlotNum = PadCounts(pGrid->mpCircleStart, pCounts, cellNum);
+	pGrid->mpCircleIds = (u32 *)malloc(sizeof(u32) * GRID_MAX(1, pGrid->mCircleSlotNum));
+	pGrid->mpCircleX = AllocateFloats(pGrid->mCircleSlotNum, OBSTACLE_GRID_PAD_POSITION);
+	pGrid->mpCircleY = AllocateFloats(pGrid->mCircleSlotNum, OBSTACLE_GRID_PAD_POSITION);
+	pGrid->mpCircleR2 = AllocateFloats(pGrid->mCircleSlotNum, -1.0f);
+
+	if (0 == pGrid->mpCircleIds || 0 == pGrid->mpCircleX || 0 == pGrid->mpCircleY || 0 == pGrid->mpCircleR2)
+	{
+		free(pCounts);
+		ObstacleGridFree(pGrid);
+		return 0;
+	}
+
+	for (i = 0; i < pGrid->mCircleSlotNum; ++i)
+		pGrid->mpCircleIds[i] = OBSTACLE_GRID_PAD_ID;
+
+	memcpy(pCounts, pGrid->mpCircleStart, sizeof(u32) * cellNum);
+	for (i = 0; i < CircleNum; ++i)
+		BinCircle(pGrid, i, pCounts, 1);
+
+	free(pCounts);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void ObstacleGridFree(ObstacleGrid *pGrid)
+{
+	free(pGrid->mpSegmentStart);
+	free(pGrid->mpSegmentIds);
+	_mm_free(pGrid->mpSegmentX0);
+	_mm_free(pGrid->mpSegmentY0);
+	_mm_free(pGrid->mpSegmentDX);
+	_mm_free(pGrid->mpSegmentDY);
+
+	free(pGrid->mpCircleStart);
+	free(pGrid->mpCircleIds);
+	_mm_free(pGrid->mpCircleX);
+	_mm_free(pGrid->mpCircleY);
+	_mm_free(pGrid->mpCircleR2);
+
+	memset(pGrid, 0, sizeof(ObstacleGrid));
+}
+
+// ---------------------------------------------------------------------------
+
+s32 ObstacleGridCellX(const ObstacleGrid *pGrid, float x)
+{
+	float cell = floorf((x - pGrid->mMin.x) * pGrid->mInvCellSize);
+
+	if (cell < 0.0f)
+		return 0;
+	if (cell >= (float)pGrid->mCellsX)
+		return pGrid->mCellsX - 1;
+
+	return (s32)cell;
+}
+
+// ---------------------------------------------------------------------------
+
+s32 ObstacleGridCellY(const ObstacleGrid *pGrid, float y)
+{
+	float cell = floorf((y - pGrid->mMin.y) * pGrid->mInvCellSize);
+
+	if (cell < 0.0f)
+		return 0;
+	if (cell >= (float)pGrid->mCellsY)
+		return pGrid->mCellsY - 1;
+
+	return (s32)cell;
+}
+
+// ---------------------------------------------------------------------------
+
+float ObstacleGridGetSlotRatio(const ObstacleGrid *pGrid)
+{
+	u32 obstacleNum = pGrid->mSegmentNum + pGrid->mCircleNum;
+
+	return obstacleNum ? (float)(pGrid->mSegmentSlotNum + pGrid->mCircleSlotNum) / obstacleNum : 0.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+void BinSegment(ObstacleGrid *pGrid, u32 Id, u32 *pCursors, int Fill)
+{
+	const LineSegment2D *pSegment = pGrid->mpSegments + Id;
+	float halfSize = pGrid->mCellSize * 0.5f + pGrid->mMargin;
+	float reach = halfSize * (fabsf(pSegment->mN.x) + fabsf(pSegment->mN.y));
+	s32 minX = ObstacleGridCellX(pGrid, GRID_MIN(pSegment->mP0.x, pSegment->mP1.x) - pGrid->mMargin);
+	s32 maxX = ObstacleGridCellX(pGrid, GRID_MAX(pSegment->mP0.x, pSegment->mP1.x) + pGrid->mMargin);
+	s32 minY = ObstacleGridCellY(pGrid, GRID_MIN(pSegment->mP0.y, pSegment->mP1.y) - pGrid->mMargin);
+	s32 maxY = ObstacleGridCellY(pGrid, GRID_MAX(pSegment->mP0.y, pSegment->mP1.y) + pGrid->mMargin);
+	s32 x, y;
+
+	for (y = minY; y <= maxY; ++y)
+	{
+		for (x = minX; x <= maxX; ++x)
+		{
+			// The bounding box test is implied by the cell range: only the line itself can still separate the cell
+			Vector2D center;
+			u32 slot;
+
+			Vector2DSet(&center, pGrid->mMin.x + (x + 0.5f) * pGrid->mCellSize, pGrid->mMin.y + (y + 0.5f) * pGrid->mCellSize);
+
+			if (fabsf(Vector2DDotProduct((Vector2D *)&pSegment->mN, &center) - pSegment->mNdotP0) > reach)
+				continue;
+
+			slot = pCursors[y * pGrid->mCellsX + x]++;
+
+			if (0 == Fill)
+				continue;
+
+			pGrid->mpSegmentIds[slot] = Id;
+			pGrid->mpSegmentX0[slot] = pSegment->mP0.x;
+			pGrid->mpSegmentY0[slot] = pSegment->mP0.y;
+			pGrid->mpSegmentDX[slot] = pSegment->mP1.x - pSegment->mP0.x;
+			pGrid->mpSegmentDY[slot] = pSegment->mP1.y - pSegment->mP0.y;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void BinCircle(ObstacleGrid *pGrid, u32 Id, u32 *pCursors, int Fill)
+{
+	const Vector2D *pCenter = pGrid->mpCircleCenters + Id;
+	float radius = pGrid->mpCircleRadii[Id];
+	float reach = radius + pGrid->mMargin;
+	s32 minX = ObstacleGridCellX(pGrid, pCenter->x - reach);
+	s32 maxX = ObstacleGridCellX(pGrid, pCenter->x + reach);
+	s32 minY = ObstacleGridCellY(pGrid, pCenter->y - reach);
+	s32 maxY = ObstacleGridCellY(pGrid, pCenter->y + reach);
+	s32 x, y;
+
+	for (y = minY; y <= maxY; ++y)
+	{
+		for (x = minX; x <= maxX; ++x)
+		{
+			// Distance from the center to the closest point of the cell
+			float cellX = pGrid->mMin.x + x * pGrid->mCellSize;
+			float cellY = pGrid->mMin.y + y * pGrid->mCellSize;
+			float dx = pCenter->x - GRID_MAX(cellX, GRID_MIN(pCenter->x, cellX + pGrid->mCellSize));
+			float dy = pCenter->y - GRID_MAX(cellY, GRID_MIN(pCenter->y, cellY + pGrid->mCellSize));
+			u32 slot;
+
+			if (dx * dx + dy * dy > reach * reach)
+				continue;
+
+			slot = pCursors[y * pGrid->mCellsX + x]++;
+
+			if (0 == Fill)
+				continue;
+
+			pGrid->mpCircleIds[slot] = Id;
+			pGrid->mpCircleX[slot] = pCenter->x;
+			pGrid->mpCircleY[slot] = pCenter->y;
+			pGrid->mpCircleR2[slot] = radius * radius;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+u32 PadCounts(u32 *pStart, u32 *pCounts, s32 CellNum)
+{
+	u32 start = 0;
+	s32 i;
+
+	for (i = 0; i < CellNum; ++i)
+	{
+		pStart[i] = start;
+		start += (pCounts[i] + OBSTACLE_GRID_LANES - 1) & ~(OBSTACLE_GRID_LANES - 1);
+	}
+
+	pStart[CellNum] = start;
+
+	return start;
+}
+
+// ---------------------------------------------------------------------------
+
+float* AllocateFloats(u32 Num, float PadValue)
+{
+	float *pFloats = (float *)_mm_malloc(sizeof(float) * GRID_MAX(OBSTACLE_GRID_LANES, Num), 16);
+	u32 i;
+
+	if (0 == pFloats)
+		return 0;
+
+	for (i = 0; i < Num; ++i)
+		pFloats[i] = PadValue;
+
+	return pFloats;
+}
+
+// ---------------------------------------------------------------------------
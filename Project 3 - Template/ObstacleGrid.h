@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	ObstacleGrid.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the static obstacle acceleration grid
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef OBSTACLE_GRID_H
+#define OBSTACLE_GRID_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+#include "Vector2D.h"
+#include "LineSegment2D.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define OBSTACLE_GRID_LANES				4					// Cell lists are padded to a multiple of this, for the SSE kernels
+#define OBSTACLE_GRID_CELL_NUM_MAX		(1 << 22)			// The cell size grows until the grid fits
+#define OBSTACLE_GRID_PAD_ID			0xFFFFFFFF			// Id of the padding slots
+#define OBSTACLE_GRID_PAD_POSITION		1e30f				// Coordinate of the padding slots, far from any query
+
+// ---------------------------------------------------------------------------
+
+enum OBSTACLE_TYPE
+{
+	OBSTACLE_TYPE_LINE_SEGMENT,
+	OBSTACLE_TYPE_CIRCLE,
+
+	// Keep this one last
+	OBSTACLE_TYPE_NUM,
+
+	OBSTACLE_TYPE_NONE = OBSTACLE_TYPE_NUM
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+/*
+Uniform grid over static line segments and circles, in compressed sparse row form:
+the slots of cell c are [mpXStart[c], mpXStart[c + 1]). Every slot holds a copy of
+the obstacle's data, structure of arrays, so a cell's obstacles are tested 4 at a
+time with aligned loads. Padding slots never intersect anything, and are out of reach
+of the distance queries
+*/
+typedef struct ObstacleGrid
+{
+	Vector2D				mMin;					// Corner of cell (0, 0)
+	float					mCellSize;
+	float					mInvCellSize;
+	s32						mCellsX;
+	s32						mCellsY;
+	float					mMargin;				// Obstacles were inflated by this much when binned
+
+	// Source obstacles, not owned by the grid
+	const LineSegment2D		*mpSegments;
+	u32						mSegmentNum;
+	const Vector2D			*mpCircleCenters;
+	const float				*mpCircleRadii;
+	u32						mCircleNum;
+
+	// Line segment slots: P0 and P0->P1
+	u32						*mpSegmentStart;		// mCellsX * mCellsY + 1 entries
+	u32						mSegmentSlotNum;
+	u32						*mpSegmentIds;
+	float					*mpSegmentX0, *mpSegmentY0;
+	float					*mpSegmentDX, *mpSegmentDY;
+
+	// Circle slots: center and squared radius (-1 in the padding)
+	u32						*mpCircleStart;
+	u32						mCircleSlotNum;
+	u32						*mpCircleIds;
+	float					*mpCircleX, *mpCircleY;
+	float					*mpCircleR2;
+}ObstacleGrid;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Bins the obstacles in a grid of square cells covering their bounds.
+The arrays are referenced, not copied, and must outlive the grid.
+
+ - Parameters
+	- CellSize:		The cell size. 0 picks one giving about one obstacle per cell
+	- Margin:		Every obstacle is also binned in the cells closer than this. Use
+					the biggest radius when the grid is queried with circles, 0 for rays
+
+ - Returns 1 on success, 0 if an allocation failed
+*/
+int ObstacleGridBuild(ObstacleGrid *pGrid, const LineSegment2D *pSegments, u32 SegmentNum, const Vector2D *pCircleCenters, const float *pCircleRadii, u32 CircleNum, float CellSize, float Margin);
+void ObstacleGridFree(ObstacleGrid *pGrid);
+
+// Cell containing the coordinate, clamped to the grid
+s32 ObstacleGridCellX(const ObstacleGrid *pGrid, float x);
+s32 ObstacleGridCellY(const ObstacleGrid *pGrid, float y);
+
+// Slots per obstacle, including the padding. 1.0 means every obstacle is in exactly one cell
+float ObstacleGridGetSlotRatio(const ObstacleGrid *pGrid);
+
+// ---------------------------------------------------------------------------
+
+#endif // OBSTACLE_GRID_H
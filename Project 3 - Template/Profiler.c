@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	Profiler.c
+// Creation Date	:	2026/10/19
+// Purpose			:	scoped frame-phase profiler. Each thread records its
+//						scopes into its own ring buffer, which is drained
+//						once per frame into the frame history
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "Profiler.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PROFILER_THREAD_LOCAL		__declspec(thread)
+#define PROFILER_ATOMIC_INC(p)		(_InterlockedIncrement((volatile long *)(p)) - 1)
+#else
+#include <x86intrin.h>
+#define PROFILER_THREAD_LOCAL		__thread
+#define PROFILER_ATOMIC_INC(p)		__sync_fetch_and_add((p), 1)
+#endif
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct
+{
+	u64				mStart;							// Tick count when the scope was opened
+	u32				mDuration;						// Ticks, saturated
+	u16				mZone;
+	u16				mDepth;
+}ProfileEvent;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	ProfileEvent	mEvents[PROFILER_RING_SIZE];
+	volatile u32	mWrite;							// Only written by the owner thread, after the event is complete
+	u32				mRead;							// Only touched by ProfilerFrameEnd
+
+	u64				mStack[PROFILER_DEPTH_MAX];		// Start ticks of the open scopes
+	u16				mStackZone[PROFILER_DEPTH_MAX];
+	u32				mDepth;
+}ProfileThread;
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+static const char *sgZoneNames[PROFILE_ZONE_NUM] =
+{
+	"frame",
+	"frame_start",
+	"input",
+	"update",
+	"draw",
+	"frame_end",
+	"update_wait",
+	"snapshot",
+	"collision",
+	"transform",
+	"draw_loop",
+};
+
+static ProfileThread					sgThreads[PROFILER_THREAD_NUM_MAX];
+static volatile long					sgThreadNum;
+static PROFILER_THREAD_LOCAL ProfileThread	*spThread;
+
+static u64			sgFrameTicks[PROFILER_FRAME_HISTORY][PROFILE_ZONE_NUM];
+static u32			sgFrameNum;								// Total frames collected, the history keeps the last PROFILER_FRAME_HISTORY
+
+static u64			sgCalibrationTicks;
+static f64			sgCalibrationTime;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static ProfileThread* GetThread(void);
+static int CompareU64(const void *pA, const void *pB);
+
+// ---------------------------------------------------------------------------
+
+void ProfilerInit(void)
+{
+	memset(sgFrameTicks, 0, sizeof(sgFrameTicks));
+	sgFrameNum = 0;
+
+	AEGetTime(&sgCalibrationTime);
+	sgCalibrationTicks = __rdtsc();
+}
+
+// ---------------------------------------------------------------------------
+
+void ProfilerBegin(unsigned int zone)
+{
+	ProfileThread *pThread = GetThread();
+
+	if (0 == pThread || pThread->mDepth >= PROFILER_DEPTH_MAX)
+		return;
+
+	pThread->mStackZone[pThread->mDepth] = (u16)zone;
+	pThread->mStack[pThread->mDepth++] = __rdtsc();
+}
+
+// ---------------------------------------------------------------------------
+
+void ProfilerEnd(unsigned int zone)
+{
+	u64 end = __rdtsc(), duration;
+	ProfileThread *pThread = spThread;
+	ProfileEvent *pEvent;
+
+	if (0 == pThread || 0 == pThread->mDepth)
+		return;
+
+	--pThread->mDepth;
+	AE_WARNING_MESG(pThread->mStackZone[pThread->mDepth] == zone, "Profiler scope %s closed as %s", sgZoneNames[pThread->mStackZone[pThread->mDepth]], sgZoneNames[zone]);
+
+	duration = end - pThread->mStack[pThread->mDepth];
+
+	pEvent = pThread->mEvents + (pThread->mWrite & (PROFILER_RING_SIZE - 1));
+	pEvent->mStart = pThread->mStack[pThread->mDepth];
+	pEvent->mDuration = (duration > 0xFFFFFFFF) ? 0xFFFFFFFF : (u32)duration;
+	pEvent->mZone = (u16)zone;
+	pEvent->mDepth = (u16)pThread->mDepth;
+
+	// Publish the event once it is fully written
+	++pThread->mWrite;
+}
+
+// ---------------------------------------------------------------------------
+
+void ProfilerFrameEnd(void)
+{
+	long threadNum = sgThreadNum, t;
+	u64 *pRow = sgFrameTicks[sgFrameNum % PROFILER_FRAME_HISTORY];
+
+	memset(pRow, 0, sizeof(u64) * PROFILE_ZONE_NUM);
+
+	if (threadNum > PROFILER_THREAD_NUM_MAX)
+		threadNum = PROFILER_THREAD_NUM_MAX;
+
+	for (t = 0; t < threadNum; ++t)
+	{
+		ProfileThread *pThread = sgThreads + t;
+		u32 write = pThread->mWrite;
+
+		// The owner lapped us: the oldest events are gone
+		if (write - pThread->mRead > PROFILER_RING_SIZE)
+			pThread->mRead = write - PROFILER_RING_SIZE;
+
+		for (; pThread->mRead != write; ++pThread->mRead)
+		{
+			ProfileEvent *pEvent = pThread->mEvents + (pThread->mRead & (PROFILER_RING_SIZE - 1));
+			pRow[pEvent->mZone] += pEvent->mDuration;
+		}
+	}
+
+	++sgFrameNum;
+}
+
+// ---------------------------------------------------------------------------
+
+int ProfilerDumpCSV(const char *pFileName)
+{
+	FILE *pFile;
+	u32 frameNum, first, i, z;
+	f64 now, msPerTick;
+	u64 *pSorted;
+
+	pFile = fopen(pFileName, "w");
+	if (0 == pFile)
+		return 0;
+
+	AEGetTime(&now);
+	msPerTick = (now > sgCalibrationTime) ? (now - sgCalibrationTime) * 1000.0 / (f64)(__rdtsc() - sgCalibrationTicks) : 0.0;
+
+	frameNum = (sgFrameNum < PROFILER_FRAME_HISTORY) ? sgFrameNum : PROFILER_FRAME_HISTORY;
+	first = sgFrameNum - frameNum;
+
+	fprintf(pFile, "frame");
+	for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+		fprintf(pFile, ",%s_ms", sgZoneNames[z]);
+	fprintf(pFile, "\n");
+
+	for (i = first; i < sgFrameNum; ++i)
+	{
+		fprintf(pFile, "%lu", (unsigned long)i);
+		for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+			fprintf(pFile, ",%.4f", sgFrameTicks[i % PROFILER_FRAME_HISTORY][z] * msPerTick);
+		fprintf(pFile, "\n");
+	}
+
+	// Summary rows
+	pSorted = (u64 *)malloc(sizeof(u64) * (frameNum ? frameNum : 1));
+
+	if (0 != pSorted && 0 != frameNum)
+	{
+		f64 stats[3][PROFILE_ZONE_NUM];
+
+		for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+		{
+			f64 sum = 0.0;
+
+			for (i = 0; i < frameNum; ++i)
+			{
+				pSorted[i] = sgFrameTicks[(first + i) % PROFILER_FRAME_HISTORY][z];
+				sum += (f64)pSorted[i];
+			}
+
+			qsort(pSorted, frameNum, sizeof(u64), CompareU64);
+
+			stats[0][z] = pSorted[0] * msPerTick;
+			stats[1][z] = sum / frameNum * msPerTick;
+			stats[2][z] = pSorted[(frameNum * 99) / 100] * msPerTick;
+		}
+
+		fprintf(pFile, "min");
+		for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+			fprintf(pFile, ",%.4f", stats[0][z]);
+		fprintf(pFile, "\navg");
+		for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+			fprintf(pFile, ",%.4f", stats[1][z]);
+		fprintf(pFile, "\np99");
+		for (z = 0; z < PROFILE_ZONE_NUM; ++z)
+			fprintf(pFile, ",%.4f", stats[2][z]);
+		fprintf(pFile, "\n");
+	}
+
+	free(pSorted);
+	fclose(pFile);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+ProfileThread* GetThread(void)
+{
+	if (0 == spThread)
+	{
+		long index = PROFILER_ATOMIC_INC(&sgThreadNum);
+
+		// Threads past the maximum are not profiled
+		if (index < PROFILER_THREAD_NUM_MAX)
+			spThread = sgThreads + index;
+	}
+
+	return spThread;
+}
+
+// ---------------------------------------------------------------------------
+
+int CompareU64(const void *pA, const void *pB)
+{
+	u64 a = *(const u64 *)pA, b = *(const u64 *)pB;
+
+	return (a > b) - (a < b);
+}
+
+// ---------------------------------------------------------------------------
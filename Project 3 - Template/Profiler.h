@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	Profiler.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the scoped frame-phase profiler
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define PROFILER_ENABLED				1					// Set this to 0 to compile every scope out
+
+#define PROFILER_RING_SIZE				4096				// Events buffered per thread between 2 ProfilerFrameEnd (power of 2)
+#define PROFILER_DEPTH_MAX				32					// Maximum scope nesting
+#define PROFILER_THREAD_NUM_MAX			16
+#define PROFILER_FRAME_HISTORY			4096				// Frames kept for the CSV dump
+
+// ---------------------------------------------------------------------------
+
+enum PROFILE_ZONE
+{
+	// Main loop phases
+	PROFILE_ZONE_FRAME,
+	PROFILE_ZONE_FRAME_START,
+	PROFILE_ZONE_INPUT,
+	PROFILE_ZONE_UPDATE,
+	PROFILE_ZONE_DRAW,
+	PROFILE_ZONE_FRAME_END,
+	PROFILE_ZONE_UPDATE_WAIT,				// Main thread waiting for the update thread
+	PROFILE_ZONE_SNAPSHOT,
+
+	// Play state loops
+	PROFILE_ZONE_COLLISION,
+	PROFILE_ZONE_TRANSFORM,
+	PROFILE_ZONE_DRAW_LOOP,
+
+	// Keep this one last
+	PROFILE_ZONE_NUM
+};
+
+// ---------------------------------------------------------------------------
+// Scope macros
+// Scopes nest, and every PROFILE_BEGIN must be closed by a PROFILE_END of the same zone on the same thread
+
+#if(PROFILER_ENABLED)
+
+#define PROFILE_BEGIN(zone)		ProfilerBegin(zone)
+#define PROFILE_END(zone)		ProfilerEnd(zone)
+
+#else
+
+#define PROFILE_BEGIN(zone)
+#define PROFILE_END(zone)
+
+#endif
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Resets the history and calibrates the tick counter against AEGetTime
+void ProfilerInit(void);
+
+// Opens/closes a scope on the calling thread. Use the PROFILE_BEGIN/PROFILE_END macros instead
+void ProfilerBegin(unsigned int zone);
+void ProfilerEnd(unsigned int zone);
+
+/*
+Collects the events recorded by every thread since the previous call
+into one row of the frame history. Call once per frame, from one thread.
+*/
+void ProfilerFrameEnd(void);
+
+/*
+Writes the frame history to "pFileName": one row per frame with the time
+spent in each zone (ms), followed by min/avg/p99 rows.
+Returns 1 on success, 0 if the file could not be opened
+*/
+int ProfilerDumpCSV(const char *pFileName);
+
+// ---------------------------------------------------------------------------
+
+#endif // PROFILER_H
@@ -0,0 +1,535 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	RayCast.c
+// Creation Date	:	2026/10/19
+// Purpose			:	batched ray casts against the obstacle grid, 4 SSE lanes
+//						per test: 4 obstacles for single rays, 4 rays for packets
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <float.h>
+#include <xmmintrin.h>
+
+#include "RayCast.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define RAY_MIN(a, b)		((a) < (b) ? (a) : (b))
+#define RAY_MAX(a, b)		((a) > (b) ? (a) : (b))
+
+#define PACKET_SIZE			4
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct
+{
+	float		mOX, mOY;
+	float		mDX, mDY;				// Normalized, (0, 0) for a dead ray
+	float		mBest;					// Closest hit so far, starts at the max distance
+	u32			mType;
+	u32			mId;
+}RayState;
+
+// The 4 rays of a packet, one per lane, for the whole walk. Dead rays have a (0, 0) direction
+typedef struct
+{
+	__m128		mOX, mOY;
+	__m128		mDX, mDY;
+	__m128		mBest;
+}PacketLanes;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void InitRay(const Ray2D *pRay, RayState *pState);
+static void WriteHit(const ObstacleGrid *pGrid, const RayState *pState, RayHit *pHit);
+
+static int ClipToGrid(const ObstacleGrid *pGrid, const RayState *pRay, float *pTMin, float *pTMax);
+static void CastSingle(const ObstacleGrid *pGrid, RayState *pRay);
+static void TestCellSingle(const ObstacleGrid *pGrid, s32 Cell, RayState *pRay);
+
+static int CastPacket(const ObstacleGrid *pGrid, RayState *pRays);
+static void TestCellPacket(const ObstacleGrid *pGrid, s32 Cell, PacketLanes *pLanes, RayState *pRays);
+
+// ---------------------------------------------------------------------------
+
+void RayCastBatch(const ObstacleGrid *pGrid, const Ray2D *pRays, u32 RayNum, RayHit *pHits, int Mode)
+{
+	RayState states[PACKET_SIZE];
+	u32 i = 0, k;
+
+	if (RAY_CAST_MODE_PACKET == Mode)
+	{
+		for (; i + PACKET_SIZE <= RayNum; i += PACKET_SIZE)
+		{
+			for (k = 0; k < PACKET_SIZE; ++k)
+				InitRay(pRays + i + k, states + k);
+
+			// Incoherent packet: cast its rays one by one
+			if (0 == CastPacket(pGrid, states))
+				for (k = 0; k < PACKET_SIZE; ++k)
+					CastSingle(pGrid, states + k);
+
+			for (k = 0; k < PACKET_SIZE; ++k)
+				WriteHit(pGrid, states + k, pHits + i + k);
+		}
+	}
+
+	// Single rays, and the rays left over by the packets
+	for (; i < RayNum; ++i)
+	{
+		InitRay(pRays + i, states);
+		CastSingle(pGrid, states);
+		WriteHit(pGrid, states, pHits + i);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void InitRay(const Ray2D *pRay, RayState *pState)
+{
+	float length = Vector2DLength((Vector2D *)&pRay->mDirection);
+
+	pState->mOX = pRay->mOrigin.x;
+	pState->mOY = pRay->mOrigin.y;
+	pState->mBest = pRay->mMaxDistance;
+	pState->mType = OBSTACLE_TYPE_NONE;
+	pState->mId = OBSTACLE_GRID_PAD_ID;
+
+	if (length > 0.0f)
+	{
+		pState->mDX = pRay->mDirection.x / length;
+		pState->mDY = pRay->mDirection.y / length;
+	}
+	else
+	{
+		pState->mDX = 0.0f;
+		pState->mDY = 0.0f;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void WriteHit(const ObstacleGrid *pGrid, const RayState *pState, RayHit *pHit)
+{
+	pHit->mType = pState->mType;
+	pHit->mIndex = pState->mId;
+	pHit->mDistance = pState->mBest;
+	Vector2DSet(&pHit->mPoint, pState->mOX + pState->mDX * pState->mBest, pState->mOY + pState->mDY * pState->mBest);
+	Vector2DZero(&pHit->mNormal);
+
+	if (OBSTACLE_TYPE_LINE_SEGMENT == pState->mType)
+	{
+		pHit->mNormal = pGrid->mpSegments[pState->mId].mN;
+
+		if (pHit->mNormal.x * pState->mDX + pHit->mNormal.y * pState->mDY > 0.0f)
+			Vector2DNeg(&pHit->mNormal, &pHit->mNormal);
+	}
+	else
+	if (OBSTACLE_TYPE_CIRCLE == pState->mType)
+	{
+		Vector2DSub(&pHit->mNormal, &pHit->mPoint, (Vector2D *)&pGrid->mpCircleCenters[pState->mId]);
+		Vector2DScale(&pHit->mNormal, &pHit->mNormal, 1.0f / pGrid->mpCircleRadii[pState->mId]);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+int ClipToGrid(const ObstacleGrid *pGrid, const RayState *pRay, float *pTMin, float *pTMax)
+{
+	float origin[2], direction[2], low[2], high[2];
+	int axis;
+
+	origin[0] = pRay->mOX;
+	origin[1] = pRay->mOY;
+	direction[0] = pRay->mDX;
+	direction[1] = pRay->mDY;
+	low[0] = pGrid->mMin.x;
+	low[1] = pGrid->mMin.y;
+	high[0] = low[0] + pGrid->mCellsX * pGrid->mCellSize;
+	high[1] = low[1] + pGrid->mCellsY * pGrid->mCellSize;
+
+	for (axis = 0; axis < 2; ++axis)
+	{
+		if (0.0f == direction[axis])
+		{
+			if (origin[axis] < low[axis] || origin[axis] > high[axis])
+				return 0;
+		}
+		else
+		{
+			float t0 = (low[axis] - origin[axis]) / direction[axis];
+			float t1 = (high[axis] - origin[axis]) / direction[axis];
+
+			*pTMin = RAY_MAX(*pTMin, RAY_MIN(t0, t1));
+			*pTMax = RAY_MIN(*pTMax, RAY_MAX(t0, t1));
+		}
+	}
+
+	return *pTMin <= *pTMax;
+}
+
+// ---------------------------------------------------------------------------
+
+void CastSingle(const ObstacleGrid *pGrid, RayState *pRay)
+{
+	float tMin = 0.0f, tMax = pRay->mBest;
+	float tNextX = FLT_MAX, tNextY = FLT_MAX, tDeltaX = FLT_MAX, tDeltaY = FLT_MAX;
+	s32 x, y, stepX = 0, stepY = 0;
+
+	if ((0.0f == pRay->mDX && 0.0f == pRay->mDY) || 0 == ClipToGrid(pGrid, pRay, &tMin, &tMax))
+		return;
+
+	// Grid walk (Amanatides & Woo), from the point where the ray enters the grid
+	x = ObstacleGridCellX(pGrid, pRay->mOX + pRay->mDX * tMin);
+	y = ObstacleGridCellY(pGrid, pRay->mOY + pRay->mDY * tMin);
+
+	if (0.0f != pRay->mDX)
+	{
+		stepX = (pRay->mDX > 0.0f) ? 1 : -1;
+		tNextX = (pGrid->mMin.x + (x + (stepX > 0)) * pGrid->mCellSize - pRay->mOX) / pRay->mDX;
+		tDeltaX = pGrid->mCellSize / fabsf(pRay->mDX);
+	}
+
+	if (0.0f != pRay->mDY)
+	{
+		stepY = (pRay->mDY > 0.0f) ? 1 : -1;
+		tNextY = (pGrid->mMin.y + (y + (stepY > 0)) * pGrid->mCellSize - pRay->mOY) / pRay->mDY;
+		tDeltaY = pGrid->mCellSize / fabsf(pRay->mDY);
+	}
+
+	for (;;)
+	{
+		float tExit = RAY_MIN(tNextX, tNextY);
+
+		TestCellSingle(pGrid, y * pGrid->mCellsX + x, pRay);
+
+		// An obstacle can span several cells, so a hit only ends the walk once the walk has gone past it
+		if (pRay->mBest <= tExit || tMax <= tExit)
+			break;
+
+		if (tNextX < tNextY)
+		{
+			x += stepX;
+			if (x < 0 || x >= pGrid->mCellsX)
+				break;
+
+			tNextX += tDeltaX;
+		}
+		else
+		{
+			y += stepY;
+			if (y < 0 || y >= pGrid->mCellsY)
+				break;
+
+			tNextY += tDeltaY;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void TestCellSingle(const ObstacleGrid *pGrid, s32 Cell, RayState *pRay)
+{
+	__m128 ox = _mm_set1_ps(pRay->mOX);
+	__m128 oy = _mm_set1_ps(pRay->mOY);
+	__m128 dx = _mm_set1_ps(pRay->mDX);
+	__m128 dy = _mm_set1_ps(pRay->mDY);
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	float t[4];
+	u32 i, k;
+
+	// Line segments, 4 per iteration: O + tD = P0 + sE
+	for (i = pGrid->mpSegmentStart[Cell]; i < pGrid->mpSegmentStart[Cell + 1]; i += 4)
+	{
+		__m128 ex = _mm_load_ps(pGrid->mpSegmentDX + i);
+		__m128 ey = _mm_load_ps(pGrid->mpSegmentDY + i);
+		__m128 qx = _mm_sub_ps(_mm_load_ps(pGrid->mpSegmentX0 + i), ox);
+		__m128 qy = _mm_sub_ps(_mm_load_ps(pGrid->mpSegmentY0 + i), oy);
+		__m128 denom = _mm_sub_ps(_mm_mul_ps(dx, ey), _mm_mul_ps(dy, ex));
+		__m128 invDenom = _mm_div_ps(one, denom);
+		__m128 tt = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, ey), _mm_mul_ps(qy, ex)), invDenom);
+		__m128 s = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, dy), _mm_mul_ps(qy, dx)), invDenom);
+		__m128 mask;
+		int bits;
+
+		// Padding slots have E = 0, so a 0 denominator
+		mask = _mm_and_ps(_mm_cmpneq_ps(denom, zero), _mm_cmpge_ps(tt, zero));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(tt, _mm_set1_ps(pRay->mBest)));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(s, zero), _mm_cmple_ps(s, one)));
+
+		bits = _mm_movemask_ps(mask);
+		if (0 == bits)
+			continue;
+
+		_mm_storeu_ps(t, tt);
+		for (k = 0; k < 4; ++k)
+		{
+			if ((bits & (1 << k)) && t[k] < pRay->mBest)
+			{
+				pRay->mBest = t[k];
+				pRay->mType = OBSTACLE_TYPE_LINE_SEGMENT;
+				pRay->mId = pGrid->mpSegmentIds[i + k];
+			}
+		}
+	}
+
+	// Circles, 4 per iteration: entry root of |O + tD - C|^2 = r^2, for origins outside the circle
+	for (i = pGrid->mpCircleStart[Cell]; i < pGrid->mpCircleStart[Cell + 1]; i += 4)
+	{
+		__m128 mx = _mm_sub_ps(ox, _mm_load_ps(pGrid->mpCircleX + i));
+		__m128 my = _mm_sub_ps(oy, _mm_load_ps(pGrid->mpCircleY + i));
+		__m128 b = _mm_add_ps(_mm_mul_ps(mx, dx), _mm_mul_ps(my, dy));
+		__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), _mm_load_ps(pGrid->mpCircleR2 + i));
+		__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), c);
+		__m128 tt = _mm_sub_ps(_mm_sub_ps(zero, b), _mm_sqrt_ps(_mm_max_ps(discriminant, zero)));
+		__m128 mask;
+		int bits;
+
+		// Padding slots have r^2 = -1, so a negative discriminant
+		mask = _mm_and_ps(_mm_cmpgt_ps(c, zero), _mm_cmpge_ps(discriminant, zero));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(tt, zero), _mm_cmplt_ps(tt, _mm_set1_ps(pRay->mBest))));
+
+		bits = _mm_movemask_ps(mask);
+		if (0 == bits)
+			continue;
+
+		_mm_storeu_ps(t, tt);
+		for (k = 0; k < 4; ++k)
+		{
+			if ((bits & (1 << k)) && t[k] < pRay->mBest)
+			{
+				pRay->mBest = t[k];
+				pRay->mType = OBSTACLE_TYPE_CIRCLE;
+				pRay->mId = pGrid->mpCircleIds[i + k];
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+int CastPacket(const ObstacleGrid *pGrid, RayState *pRays)
+{
+	float laneOX[PACKET_SIZE], laneOY[PACKET_SIZE], laneDX[PACKET_SIZE], laneDY[PACKET_SIZE], laneBest[PACKET_SIZE];
+	float laneLive[PACKET_SIZE], range[PACKET_SIZE];
+	PacketLanes lanes;
+	__m128 ou, ov, du, dv, live, cellSize;
+	__m128 zero = _mm_setzero_ps();
+	int axis = -1, sign = 0;
+	s32 cellsU, cellsV, u, v, start;
+	float minU, minV, startCell;
+	u32 k;
+
+	// The packet walks the grid column by column along the rays' common dominant axis "u"
+	for (k = 0; k < PACKET_SIZE; ++k)
+	{
+		RayState *pRay = pRays + k;
+		int rayAxis = (fabsf(pRay->mDX) >= fabsf(pRay->mDY)) ? 0 : 1;
+		float rayDU = rayAxis ? pRay->mDY : pRay->mDX;
+		int raySign = (rayDU > 0.0f) ? 1 : -1;
+
+		laneOX[k] = pRay->mOX;
+		laneOY[k] = pRay->mOY;
+		laneDX[k] = pRay->mDX;
+		laneDY[k] = pRay->mDY;
+		laneBest[k] = pRay->mBest;
+		laneLive[k] = (0.0f != pRay->mDX || 0.0f != pRay->mDY) ? 1.0f : 0.0f;
+
+		if (0.0f == laneLive[k])
+			continue;
+
+		if (axis < 0)
+		{
+			axis = rayAxis;
+			sign = raySign;
+		}
+		else
+		if (axis != rayAxis || sign != raySign)
+			return 0;
+	}
+
+	// Only dead rays
+	if (axis < 0)
+		return 1;
+
+	cellsU = axis ? pGrid->mCellsY : pGrid->mCellsX;
+	cellsV = axis ? pGrid->mCellsX : pGrid->mCellsY;
+	minU = axis ? pGrid->mMin.y : pGrid->mMin.x;
+	minV = axis ? pGrid->mMin.x : pGrid->mMin.y;
+
+	// Start at the column of the origin furthest behind
+	startCell = (sign > 0) ? FLT_MAX : -FLT_MAX;
+
+	for (k = 0; k < PACKET_SIZE; ++k)
+	{
+		float cell;
+
+		if (0.0f == laneLive[k])
+			continue;
+
+		cell = floorf(((axis ? laneOY[k] : laneOX[k]) - minU) * pGrid->mInvCellSize);
+		startCell = (sign > 0) ? RAY_MIN(startCell, cell) : RAY_MAX(startCell, cell);
+	}
+
+	if (startCell >= (float)cellsU)
+	{
+		if (sign > 0)
+			return 1;
+
+		start = cellsU - 1;
+	}
+	else
+	if (startCell < 0.0f)
+	{
+		if (sign < 0)
+			return 1;
+
+		start = 0;
+	}
+	else
+		start = (s32)startCell;
+
+	// In registers for the whole walk: every cell takes the lanes and gives back the closest hits
+	lanes.mOX = _mm_loadu_ps(laneOX);
+	lanes.mOY = _mm_loadu_ps(laneOY);
+	lanes.mDX = _mm_loadu_ps(laneDX);
+	lanes.mDY = _mm_loadu_ps(laneDY);
+	lanes.mBest = _mm_loadu_ps(laneBest);
+
+	// Dead lanes divide by 1 rather than 0, and are masked out
+	live = _mm_cmpneq_ps(_mm_loadu_ps(laneLive), zero);
+	ou = axis ? lanes.mOY : lanes.mOX;
+	ov = axis ? lanes.mOX : lanes.mOY;
+	du = _mm_or_ps(_mm_and_ps(live, axis ? lanes.mDY : lanes.mDX), _mm_andnot_ps(live, _mm_set1_ps(1.0f)));
+	dv = axis ? lanes.mDX : lanes.mDY;
+	cellSize = _mm_set1_ps(pGrid->mCellSize);
+
+	for (u = start; u >= 0 && u < cellsU; u += sign)
+	{
+		__m128 u0 = _mm_set1_ps(minU + u * pGrid->mCellSize);
+		__m128 tA = _mm_div_ps(_mm_sub_ps(u0, ou), du);
+		__m128 tB = _mm_div_ps(_mm_sub_ps(_mm_add_ps(u0, cellSize), ou), du);
+		__m128 tExit = _mm_max_ps(tA, tB);
+		__m128 tEnter = _mm_max_ps(_mm_min_ps(tA, tB), zero);
+		__m128 tLeave = _mm_min_ps(tExit, lanes.mBest);
+		__m128 inside = _mm_and_ps(live, _mm_cmple_ps(tEnter, tLeave));
+		__m128 v0 = _mm_add_ps(ov, _mm_mul_ps(dv, tEnter));
+		__m128 v1 = _mm_add_ps(ov, _mm_mul_ps(dv, tLeave));
+		float vMin, vMax;
+
+		// Range of "v" swept by the packet in this column, over the lanes inside it
+		_mm_storeu_ps(range, _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(v0, v1)), _mm_andnot_ps(inside, _mm_set1_ps(FLT_MAX))));
+		vMin = RAY_MIN(RAY_MIN(range[0], range[1]), RAY_MIN(range[2], range[3]));
+		_mm_storeu_ps(range, _mm_or_ps(_mm_and_ps(inside, _mm_max_ps(v0, v1)), _mm_andnot_ps(inside, _mm_set1_ps(-FLT_MAX))));
+		vMax = RAY_MAX(RAY_MAX(range[0], range[1]), RAY_MAX(range[2], range[3]));
+
+		if (vMin <= vMax)
+		{
+			float cell0 = floorf((vMin - minV) * pGrid->mInvCellSize);
+			float cell1 = floorf((vMax - minV) * pGrid->mInvCellSize);
+
+			if (cell1 >= 0.0f && cell0 < (float)cellsV)
+			{
+				s32 v0 = (cell0 < 0.0f) ? 0 : (s32)cell0;
+				s32 v1 = (cell1 >= (float)cellsV) ? cellsV - 1 : (s32)cell1;
+
+				for (v = v0; v <= v1; ++v)
+					TestCellPacket(pGrid, axis ? (u * pGrid->mCellsX + v) : (v * pGrid->mCellsX + u), &lanes, pRays);
+			}
+		}
+
+		// Done once every live ray's hit (or end) is behind the column's far side
+		if (0 == _mm_movemask_ps(_mm_and_ps(live, _mm_cmplt_ps(tExit, lanes.mBest))))
+			break;
+	}
+
+	_mm_storeu_ps(laneBest, lanes.mBest);
+	for (k = 0; k < PACKET_SIZE; ++k)
+		pRays[k].mBest = laneBest[k];
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void TestCellPacket(const ObstacleGrid *pGrid, s32 Cell, PacketLanes *pLanes, RayState *pRays)
+{
+	__m128 ox = pLanes->mOX, oy = pLanes->mOY, dx = pLanes->mDX, dy = pLanes->mDY, best = pLanes->mBest;
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	u32 i, k;
+
+	// One line segment against the 4 rays per iteration. The padding is at the end of the cell
+	for (i = pGrid->mpSegmentStart[Cell]; i < pGrid->mpSegmentStart[Cell + 1] && OBSTACLE_GRID_PAD_ID != pGrid->mpSegmentIds[i]; ++i)
+	{
+		__m128 ex = _mm_set1_ps(pGrid->mpSegmentDX[i]);
+		__m128 ey = _mm_set1_ps(pGrid->mpSegmentDY[i]);
+		__m128 qx = _mm_sub_ps(_mm_set1_ps(pGrid->mpSegmentX0[i]), ox);
+		__m128 qy = _mm_sub_ps(_mm_set1_ps(pGrid->mpSegmentY0[i]), oy);
+		__m128 denom = _mm_sub_ps(_mm_mul_ps(dx, ey), _mm_mul_ps(dy, ex));
+		__m128 invDenom = _mm_div_ps(one, denom);
+		__m128 tt = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, ey), _mm_mul_ps(qy, ex)), invDenom);
+		__m128 s = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, dy), _mm_mul_ps(qy, dx)), invDenom);
+		__m128 mask;
+		int bits;
+
+		mask = _mm_and_ps(_mm_cmpneq_ps(denom, zero), _mm_cmpge_ps(tt, zero));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(tt, best));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(s, zero), _mm_cmple_ps(s, one)));
+
+		bits = _mm_movemask_ps(mask);
+		if (0 == bits)
+			continue;
+
+		best = _mm_or_ps(_mm_and_ps(mask, tt), _mm_andnot_ps(mask, best));
+
+		for (k = 0; k < PACKET_SIZE; ++k)
+		{
+			if (bits & (1 << k))
+			{
+				pRays[k].mType = OBSTACLE_TYPE_LINE_SEGMENT;
+				pRays[k].mId = pGrid->mpSegmentIds[i];
+			}
+		}
+	}
+
+	// One circle against the 4 rays per iteration
+	for (i = pGrid->mpCircleStart[Cell]; i < pGrid->mpCircleStart[Cell + 1] && OBSTACLE_GRID_PAD_ID != pGrid->mpCircleIds[i]; ++i)
+	{
+		__m128 mx = _mm_sub_ps(ox, _mm_set1_ps(pGrid->mpCircleX[i]));
+		__m128 my = _mm_sub_ps(oy, _mm_set1_ps(pGrid->mpCircleY[i]));
+		__m128 b = _mm_add_ps(_mm_mul_ps(mx, dx), _mm_mul_ps(my, dy));
+		__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), _mm_set1_ps(pGrid->mpCircleR2[i]));
+		__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), c);
+		__m128 tt = _mm_sub_ps(_mm_sub_ps(zero, b), _mm_sqrt_ps(_mm_max_ps(discriminant, zero)));
+		__m128 mask;
+		int bits;
+
+		mask = _mm_and_ps(_mm_cmpgt_ps(c, zero), _mm_cmpge_ps(discriminant, zero));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(tt, zero), _mm_cmplt_ps(tt, best)));
+
+		bits = _mm_movemask_ps(mask);
+		if (0 == bits)
+			continue;
+
+		best = _mm_or_ps(_mm_and_ps(mask, tt), _mm_andnot_ps(mask, best));
+
+		for (k = 0; k < PACKET_SIZE; ++k)
+		{
+			if (bits & (1 << k))
+			{
+				pRays[k].mType = OBSTACLE_TYPE_CIRCLE;
+				pRays[k].mId = pGrid->mpCircleIds[i];
+			}
+		}
+	}
+
+	pLanes->mBest = best;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,69 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	RayCast.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the batched ray casts against the obstacles
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef RAY_CAST_H
+#define RAY_CAST_H
+
+// ---------------------------------------------------------------------------
+
+#include "ObstacleGrid.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+enum RAY_CAST_MODE
+{
+	RAY_CAST_MODE_SINGLE,				// Every ray walks the grid on its own, testing 4 obstacles at a time
+	RAY_CAST_MODE_PACKET,				// Groups of 4 consecutive rays walk the grid together, one ray per lane
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct Ray2D
+{
+	Vector2D		mOrigin;
+	Vector2D		mDirection;			// Doesn't need to be normalized
+	float			mMaxDistance;		// Along the normalized direction
+}Ray2D;
+
+// ---------------------------------------------------------------------------
+
+typedef struct RayHit
+{
+	u32				mType;				// OBSTACLE_TYPE_NONE if nothing was hit
+	u32				mIndex;				// Index of the obstacle in its own array
+	float			mDistance;			// mMaxDistance if nothing was hit
+	Vector2D		mPoint;
+	Vector2D		mNormal;			// Unit normal facing the ray
+}RayHit;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Finds the closest obstacle hit by each ray, among the obstacles binned in pGrid
+(which should be built with a 0 margin).
+
+ - Parameters
+	- pRays:		The rays
+	- RayNum:		The number of rays
+	- pHits:		RayNum results, in the same order as the rays
+	- Mode:			From the RAY_CAST_MODE enum. Packets pay off when consecutive
+					rays start close to each other and point the same way, like a
+					fan or a shotgun spread. Packets whose rays don't all share the
+					same dominant axis and direction fall back to single rays
+
+Rays starting inside a pillar don't hit that pillar. Segments are hit from both sides
+*/
+void RayCastBatch(const ObstacleGrid *pGrid, const Ray2D *pRays, u32 RayNum, RayHit *pHits, int Mode);
+
+// ---------------------------------------------------------------------------
+
+#endif // RAY_CAST_H
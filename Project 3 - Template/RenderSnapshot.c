@@ -0,0 +1,78 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	RenderSnapshot.c
+// Creation Date	:	2026/10/19
+// Purpose			:	immutable per-frame render snapshot, filled by the
+//						update and drawn with AEGfx
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "RenderSnapshot.h"
+#include "Matrix2D.h"
+#include "Profiler.h"
+
+// ---------------------------------------------------------------------------
+
+void RenderSnapshotClear(RenderSnapshot *pSnapshot, u32 Frame)
+{
+	pSnapshot->mItemNum = 0;
+	pSnapshot->mDroppedNum = 0;
+	pSnapshot->mLineVertexNum = 0;
+	pSnapshot->mFrame = Frame;
+}
+
+// ---------------------------------------------------------------------------
+
+int RenderSnapshotAddItem(RenderSnapshot *pSnapshot, const Affine2D *pTransform, AEGfxVertexList *pMesh, u32 DrawMode)
+{
+	RenderItem *pItem;
+
+	if (pSnapshot->mItemNum >= RENDER_SNAPSHOT_ITEM_NUM_MAX)
+	{
+		++pSnapshot->mDroppedNum;
+		return 0;
+	}
+
+	pItem = pSnapshot->mItems + pSnapshot->mItemNum++;
+	pItem->mTransform = *pTransform;
+	pItem->mpMesh = pMesh;
+	pItem->mDrawMode = DrawMode;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void RenderSnapshotTakeDebugDraw(RenderSnapshot *pSnapshot)
+{
+	pSnapshot->mLineVertexNum = DebugDrawTakeBatch(pSnapshot->mLineVertices, DEBUG_DRAW_VERTEX_NUM_MAX);
+}
+
+// ---------------------------------------------------------------------------
+
+void RenderSnapshotDraw(const RenderSnapshot *pSnapshot)
+{
+	const RenderItem *pItem, *pEnd = pSnapshot->mItems + pSnapshot->mItemNum;
+
+	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
+
+	PROFILE_BEGIN(PROFILE_ZONE_DRAW_LOOP);
+
+	for (pItem = pSnapshot->mItems; pItem < pEnd; ++pItem)
+	{
+		Affine2D affine = pItem->mTransform;
+		Matrix2D transform;
+
+		// The engine takes the full 3x3
+		Affine2DToMatrix2D(&transform, &affine);
+		AEGfxSetTransform(transform.m);
+		AEGfxMeshDraw(pItem->mpMesh, pItem->mDrawMode);
+	}
+
+	PROFILE_END(PROFILE_ZONE_DRAW_LOOP);
+
+	DebugDrawSubmit(pSnapshot->mLineVertices, pSnapshot->mLineVertexNum);
+}
+
+// ---------------------------------------------------------------------------
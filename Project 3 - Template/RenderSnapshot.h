@@ -0,0 +1,73 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	RenderSnapshot.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the immutable per-frame render snapshot
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+#include "SoftGfxCompat.h"
+#include "Affine2D.h"
+#include "DebugDraw.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define RENDER_SNAPSHOT_ITEM_NUM_MAX	2048				// Meshes drawn per frame, extra items are dropped
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct RenderItem
+{
+	Affine2D			mTransform;
+	AEGfxVertexList		*mpMesh;				// Owned by the game state, alive as long as the state is loaded
+	u32					mDrawMode;				// From the AEGfxMeshDrawMode enum
+}RenderItem;
+
+// ---------------------------------------------------------------------------
+
+/*
+Everything needed to draw one frame, copied out of the game state at the end of
+its update: the meshes with their transforms, and the debug draw batch.
+
+Once filled, a snapshot is only read, and it points at nothing the update writes
+to, so it can be drawn on one thread while the next frame is simulated on
+another (see GSM_MainLoop).
+*/
+typedef struct RenderSnapshot
+{
+	RenderItem			mItems[RENDER_SNAPSHOT_ITEM_NUM_MAX];
+	u32					mItemNum;
+	u32					mDroppedNum;			// Items that didn't fit
+
+	DebugDrawVertex		mLineVertices[DEBUG_DRAW_VERTEX_NUM_MAX];
+	u32					mLineVertexNum;
+
+	u32					mFrame;					// Of the update that filled it
+}RenderSnapshot;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+void RenderSnapshotClear(RenderSnapshot *pSnapshot, u32 Frame);
+
+// Returns 0 if the snapshot is full
+int RenderSnapshotAddItem(RenderSnapshot *pSnapshot, const Affine2D *pTransform, AEGfxVertexList *pMesh, u32 DrawMode);
+
+// Moves the debug draw batch into the snapshot (see DebugDrawTakeBatch)
+void RenderSnapshotTakeDebugDraw(RenderSnapshot *pSnapshot);
+
+// Draws the items in order, then the debug lines. Call from the thread owning the graphics context
+void RenderSnapshotDraw(const RenderSnapshot *pSnapshot);
+
+// ---------------------------------------------------------------------------
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,106 @@
+#ifndef ROTATION2D_H
+#define ROTATION2D_H
+
+#include "Vec2.h"
+#include "SinCos.h"
+
+
+
+/*
+Orientation stored as a unit complex number (cos, sin) instead of an angle.
+Building a transform from it, rotating vectors by it, and turning a direction
+into one take no trigonometry: only the angle conversions do.
+
+Composing 2 rotations is a complex multiplication, so orientations updated
+every frame drift away from unit length by a few ulp per composition. Such
+ones should call Rotation2DNormalize every now and then (every 100
+compositions keeps the scale within 1e-5)
+*/
+typedef struct Rotation2D
+{
+	float c, s;
+}Rotation2D;
+
+
+VEC2_INLINE Rotation2D Rotation2DMake(float c, float s)
+{
+	Rotation2D result;
+
+	result.c = c;
+	result.s = s;
+	return result;
+}
+
+VEC2_INLINE Rotation2D Rotation2DIdentity(void)
+{
+	return Rotation2DMake(1.0f, 0.0f);
+}
+
+VEC2_INLINE Rotation2D Rotation2DFromAngle(float Angle)
+{
+	Rotation2D result;
+
+	SinCos(Angle, &result.s, &result.c, SINCOS_ACCURACY_1E7);
+	return result;
+}
+
+// Angle in ]-PI, PI], for display and debugging
+VEC2_INLINE float Rotation2DToAngle(Rotation2D r)
+{
+	return atan2f(r.s, r.c);
+}
+
+// Orientation of the direction Dir, which doesn't need to be normalized (but can't be zero)
+VEC2_INLINE Rotation2D Rotation2DFromDirection(Vec2 Dir)
+{
+	float invLength = 1.0f / Vec2Length(Dir);
+
+	return Rotation2DMake(Dir.x * invLength, Dir.y * invLength);
+}
+
+// Unit vector pointing along the orientation: the rotated x axis
+VEC2_INLINE Vec2 Rotation2DDirection(Rotation2D r)
+{
+	return Vec2Make(r.c, r.s);
+}
+
+// a then b: the angles add up
+VEC2_INLINE Rotation2D Rotation2DConcat(Rotation2D a, Rotation2D b)
+{
+	return Rotation2DMake(a.c * b.c - a.s * b.s, a.s * b.c + a.c * b.s);
+}
+
+// The opposite angle
+VEC2_INLINE Rotation2D Rotation2DInverse(Rotation2D r)
+{
+	return Rotation2DMake(r.c, -r.s);
+}
+
+VEC2_INLINE Vec2 Rotation2DRotate(Rotation2D r, Vec2 v)
+{
+	return Vec2Make(r.c * v.x - r.s * v.y, r.s * v.x + r.c * v.y);
+}
+
+// Rotates by -angle: from world to local space
+VEC2_INLINE Vec2 Rotation2DUnrotate(Rotation2D r, Vec2 v)
+{
+	return Vec2Make(r.c * v.x + r.s * v.y, r.c * v.y - r.s * v.x);
+}
+
+// r turned by Angle more
+VEC2_INLINE Rotation2D Rotation2DRotateBy(Rotation2D r, float Angle)
+{
+	return Rotation2DConcat(r, Rotation2DFromAngle(Angle));
+}
+
+/*
+Brings r back to unit length. Only for rotations that are already close to it,
+like drifting ones: a Newton step on 1 / length instead of a square root
+*/
+VEC2_INLINE Rotation2D Rotation2DNormalize(Rotation2D r)
+{
+	float scale = 1.5f - 0.5f * (r.c * r.c + r.s * r.s);
+
+	return Rotation2DMake(r.c * scale, r.s * scale);
+}
+#endif
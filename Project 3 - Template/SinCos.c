@@ -0,0 +1,139 @@
+#include <emmintrin.h>
+
+#include "SinCos.h"
+
+
+#define SINCOS_2_OVER_PI	0.636619772367581343f
+
+// Adding and subtracting 1.5 * 2^23 rounds to the nearest integer (ties to even), without a branch or a conversion.
+// Needs a compiler that keeps float operations as written (no /fp:fast)
+#define SINCOS_ROUND		12582912.0f
+
+// PI/2 in 3 parts: q * the first 2 are exact for |q| < 2^13
+#define SINCOS_PI_2_A		1.5703125f
+#define SINCOS_PI_2_B		4.837512969970703125e-4f
+#define SINCOS_PI_2_C		7.54978995489188216e-8f
+
+#define SINCOS_SIN_COEF_MAX		3
+#define SINCOS_COS_COEF_MAX		4
+
+
+typedef union SinCosBits
+{
+	float f;
+	unsigned int u;
+}SinCosBits;
+
+
+/*
+Minimax coefficients on [-PI/4, PI/4], in r^2:
+	sin(r) = r + r * r^2 * (s[0] + r^2 * (s[1] + ...))
+	cos(r) = 1 + r^2 * (c[0] + r^2 * (c[1] + ...))
+*/
+typedef struct SinCosTier
+{
+	int mSinCoefNum;
+	int mCosCoefNum;
+	float mSin[SINCOS_SIN_COEF_MAX];
+	float mCos[SINCOS_COS_COEF_MAX];
+}SinCosTier;
+
+static const SinCosTier sgTiers[SINCOS_ACCURACY_NUM] =
+{
+	// SINCOS_ACCURACY_FAST
+	{ 1, 1, { -1.622591261e-01f }, { -4.791038282e-01f } },
+
+	// SINCOS_ACCURACY_1E4
+	{ 2, 2, { -1.666283380e-01f, 8.152992246e-03f }, { -4.997763068e-01f, 4.048893534e-02f } },
+
+	// SINCOS_ACCURACY_1E7
+	{ 3, 4, { -1.666665067e-01f, 8.331978662e-03f, -1.949563610e-04f }, { -4.999999973e-01f, 4.166662332e-02f, -1.388676358e-03f, 2.439043235e-05f } },
+};
+
+
+void SinCos(float Angle, float *pSin, float *pCos, int Accuracy)
+{
+	const SinCosTier *pTier = sgTiers + Accuracy;
+	float qf = (Angle * SINCOS_2_OVER_PI + SINCOS_ROUND) - SINCOS_ROUND;
+	int q = (int)qf;
+	float r = ((Angle - qf * SINCOS_PI_2_A) - qf * SINCOS_PI_2_B) - qf * SINCOS_PI_2_C;
+	float r2 = r * r;
+	unsigned int swap = 0u - (unsigned int)(q & 1);
+	SinCosBits s, c, result;
+
+	// Unrolled, in the same order as the loops of the batch version
+	switch (Accuracy)
+	{
+	case SINCOS_ACCURACY_FAST:
+		s.f = r + r * r2 * pTier->mSin[0];
+		c.f = 1.f + r2 * pTier->mCos[0];
+		break;
+
+	case SINCOS_ACCURACY_1E4:
+		s.f = r + r * r2 * (pTier->mSin[0] + r2 * pTier->mSin[1]);
+		c.f = 1.f + r2 * (pTier->mCos[0] + r2 * pTier->mCos[1]);
+		break;
+
+	default:
+		s.f = r + r * r2 * (pTier->mSin[0] + r2 * (pTier->mSin[1] + r2 * pTier->mSin[2]));
+		c.f = 1.f + r2 * (pTier->mCos[0] + r2 * (pTier->mCos[1] + r2 * (pTier->mCos[2] + r2 * pTier->mCos[3])));
+		break;
+	}
+
+	// Quadrant, on the bits like the batch version (branches would be mispredicted on random angles):
+	// odd ones swap sine and cosine, then the signs follow
+	result.u = ((c.u & swap) | (s.u & ~swap)) ^ ((unsigned int)(q & 2) << 30);
+	*pSin = result.f;
+	result.u = ((s.u & swap) | (c.u & ~swap)) ^ ((unsigned int)((q + 1) & 2) << 30);
+	*pCos = result.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void SinCosBatch(float *pAngles, float *pSins, float *pCoss, unsigned int Num, int Accuracy)
+{
+	const SinCosTier *pTier = sgTiers + Accuracy;
+	const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+	unsigned int n;
+	int i;
+
+	for (n = 0; n + 4 <= Num; n += 4)
+	{
+		__m128 angle = _mm_loadu_ps(pAngles + n);
+
+		__m128 qf = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(angle, _mm_set1_ps(SINCOS_2_OVER_PI)), _mm_set1_ps(SINCOS_ROUND)), _mm_set1_ps(SINCOS_ROUND));
+		__m128i q = _mm_cvttps_epi32(qf);
+		__m128 r = _mm_sub_ps(angle, _mm_mul_ps(qf, _mm_set1_ps(SINCOS_PI_2_A)));
+		__m128 r2, s, c, h, swap, sinSign, cosSign;
+
+		r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(SINCOS_PI_2_B)));
+		r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(SINCOS_PI_2_C)));
+		r2 = _mm_mul_ps(r, r);
+
+		h = _mm_set1_ps(pTier->mSin[pTier->mSinCoefNum - 1]);
+		for (i = pTier->mSinCoefNum - 2; i >= 0; --i)
+			h = _mm_add_ps(_mm_set1_ps(pTier->mSin[i]), _mm_mul_ps(r2, h));
+		s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), h));
+
+		h = _mm_set1_ps(pTier->mCos[pTier->mCosCoefNum - 1]);
+		for (i = pTier->mCosCoefNum - 2; i >= 0; --i)
+			h = _mm_add_ps(_mm_set1_ps(pTier->mCos[i]), _mm_mul_ps(r2, h));
+		c = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(r2, h));
+
+		swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+		sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+		cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+
+		h = s;
+		s = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+		c = _mm_or_ps(_mm_and_ps(swap, h), _mm_andnot_ps(swap, c));
+
+		_mm_storeu_ps(pSins + n, _mm_xor_ps(s, sinSign));
+		_mm_storeu_ps(pCoss + n, _mm_xor_ps(c, cosSign));
+	}
+
+	for (; n < Num; ++n)
+		SinCos(pAngles[n], pSins + n, pCoss + n, Accuracy);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+#ifndef SINCOS_H
+#define SINCOS_H
+
+
+
+/*
+Sine and cosine of the same angle, computed together, for a fraction of the cost
+of cosf plus sinf.
+
+The angle is brought back to r in [-PI/4, PI/4] (Cody-Waite reduction by PI/2,
+with a 3 part constant), then sin(r) and cos(r) are minimax polynomials in r,
+whose degree depends on the accuracy tier. The quadrant swaps and negates them.
+
+Maximum absolute error against the exact values, over |Angle| <= 10000, measured
+on every float in [-2PI, 2PI] and on 10M random angles up to 10000:
+	- SINCOS_ACCURACY_FAST:	2.7e-3		degree 3 sine, degree 2 cosine
+	- SINCOS_ACCURACY_1E4:	1.3e-5		degree 5 sine, degree 4 cosine
+	- SINCOS_ACCURACY_1E7:	8.9e-8		degree 7 sine, degree 8 cosine (cosf and sinf: 3.3e-8)
+Beyond 10000 the reduction loses bits and the error grows with the angle.
+The angle must be finite.
+
+The batch version gives the same results as the scalar one, bit for bit
+*/
+enum SINCOS_ACCURACY
+{
+	SINCOS_ACCURACY_FAST,					// Good enough for anything that's only drawn
+	SINCOS_ACCURACY_1E4,
+	SINCOS_ACCURACY_1E7,					// As good as cosf and sinf for float results
+
+	// Keep this one last
+	SINCOS_ACCURACY_NUM
+};
+
+
+void SinCos(float Angle, float *pSin, float *pCos, int Accuracy);
+
+/*
+SinCos on Num angles, 4 per SSE instruction. The arrays don't need any alignment.
+pSins or pCoss can be pAngles
+*/
+void SinCosBatch(float *pAngles, float *pSins, float *pCoss, unsigned int Num, int Accuracy);
+
+
+
+#endif
@@ -0,0 +1,956 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SoftGfx.c
+// Creation Date	:	2026/10/19
+// Purpose			:	portable software rasterizer: AEGfx-like meshes binned
+//						into screen tiles, rasterized in parallel
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "SoftGfx.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#define SOFT_GFX_ATOMIC_INC(p)			(InterlockedIncrement((volatile LONG *)(p)) - 1)
+#else
+#include <pthread.h>
+#define SOFT_GFX_ATOMIC_INC(p)			__sync_fetch_and_add((p), 1)
+#endif
+
+// ---------------------------------------------------------------------------
+// Defines
+
+// Triangles are rasterized on a fixed-point grid of 1/256 pixel
+#define SOFT_GFX_SUBPIXEL_BITS			8
+#define SOFT_GFX_SUBPIXEL_ONE			(1 << SOFT_GFX_SUBPIXEL_BITS)
+#define SOFT_GFX_SUBPIXEL_HALF			(SOFT_GFX_SUBPIXEL_ONE >> 1)
+
+// In pixels. Keeps the edge functions' products within 64 bits; triangles reaching past it are dropped
+#define SOFT_GFX_GUARD_BAND				1048576.0f
+
+enum SOFT_GFX_PRIMITIVE
+{
+	SOFT_GFX_PRIMITIVE_POINT,
+	SOFT_GFX_PRIMITIVE_LINE,
+	SOFT_GFX_PRIMITIVE_TRIANGLE
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct
+{
+	f32					mX, mY;
+	u32					mColor;
+}SoftGfxVertex;
+
+// ---------------------------------------------------------------------------
+
+struct SoftGfxMesh
+{
+	SoftGfxVertex		*mpVertices;
+	u32					mVertexNum;
+};
+
+// ---------------------------------------------------------------------------
+
+// In pixels, y down. Points use 1 vertex, lines 2
+typedef struct
+{
+	f32					mX[3], mY[3];
+	u32					mColor[3];
+	u32					mType;					// From the SOFT_GFX_PRIMITIVE enum
+}SoftGfxPrimitive;
+
+// ---------------------------------------------------------------------------
+
+// The primitives touching a tile, in draw order
+typedef struct
+{
+	u32					*mpPrimitives;
+	u32					mNum;
+	u32					mCapacity;
+}SoftGfxBin;
+
+// ---------------------------------------------------------------------------
+
+// Pixel bounds, inclusive
+typedef struct
+{
+	s32					mX0, mY0, mX1, mY1;
+}SoftGfxRect;
+
+// ---------------------------------------------------------------------------
+// Static variables
+
+static u32					*spFramebuffer;
+static u32					sgWidth, sgHeight;
+static u32					sgTileNumX, sgTileNumY;
+static u32					sgBackground = 0xFF000000;
+
+static SoftGfxBin			*spBins;
+static SoftGfxPrimitive		*spPrimitives;
+static u32					sgPrimitiveNum, sgPrimitiveCapacity;
+
+static f32					sgTransform[2][3];			// Mesh to pixels: the transform, then the viewport
+
+// Mesh being built
+static SoftGfxVertex		*spBuildVertices;
+static u32					sgBuildNum, sgBuildCapacity;
+
+// Raster threads. Thread 0 is the one calling SoftGfxFrameEnd
+static u32					sgThreadNum;
+static volatile long		sgNextTile;
+static u32					sgGeneration;				// Bumped by every SoftGfxFrameEnd
+static u32					sgBusyNum;					// Helper threads still rasterizing the generation
+static int					sgQuit;
+
+#ifdef _WIN32
+static CRITICAL_SECTION		sgLock;
+static CONDITION_VARIABLE	sgWorkCond;
+static CONDITION_VARIABLE	sgDoneCond;
+static HANDLE				sgThreads[SOFT_GFX_THREAD_NUM_MAX];
+#else
+static pthread_mutex_t		sgLock;
+static pthread_cond_t		sgWorkCond;
+static pthread_cond_t		sgDoneCond;
+static pthread_t			sgThreads[SOFT_GFX_THREAD_NUM_MAX];
+#endif
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void AddVertex(f32 x, f32 y, u32 Color);
+static void AddPrimitive(const SoftGfxVertex *pVertices, u32 VertexNum, u32 Type);
+static int BinPush(SoftGfxBin *pBin, u32 Primitive);
+
+static void RasterTiles(void);
+static void RasterTile(u32 Tile);
+static void RasterTriangle(const SoftGfxPrimitive *pPrimitive, const SoftGfxRect *pTile);
+static void RasterLine(const SoftGfxPrimitive *pPrimitive, const SoftGfxRect *pTile);
+static u32 LerpColor(u32 c0, u32 c1, f32 t);
+
+static int StartThreads(u32 ThreadNum);
+static void StopThreads(void);
+static void DestroyLock(void);
+static void Lock(void);
+static void Unlock(void);
+static void WaitWork(void);
+static void WaitDone(void);
+static void SignalWork(void);
+static void SignalDone(void);
+
+#ifdef _WIN32
+static DWORD WINAPI RasterThread(LPVOID pParam);
+#else
+static void* RasterThread(void *pParam);
+#endif
+
+// ---------------------------------------------------------------------------
+
+int SoftGfxInit(u32 Width, u32 Height, u32 ThreadNum)
+{
+	SoftGfxExit();
+
+	if (0 == Width || 0 == Height)
+		return 0;
+
+	sgWidth = Width;
+	sgHeight = Height;
+	sgTileNumX = (Width + SOFT_GFX_TILE_SIZE - 1) / SOFT_GFX_TILE_SIZE;
+	sgTileNumY = (Height + SOFT_GFX_TILE_SIZE - 1) / SOFT_GFX_TILE_SIZE;
+
+	spFramebuffer = (u32 *)malloc(sizeof(u32) * Width * Height);
+	spBins = (SoftGfxBin *)calloc(sgTileNumX * sgTileNumY, sizeof(SoftGfxBin));
+
+	if (0 == spFramebuffer || 0 == spBins || 0 == StartThreads(ThreadNum))
+	{
+		SoftGfxExit();
+		return 0;
+	}
+
+	memset(spFramebuffer, 0, sizeof(u32) * Width * Height);
+	sgBackground = 0xFF000000;
+	sgPrimitiveNum = 0;
+
+	{
+		float identity[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+		SoftGfxSetTransform(identity);
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxExit(void)
+{
+	u32 t;
+
+	StopThreads();
+
+	if (spBins)
+		for (t = 0; t < sgTileNumX * sgTileNumY; ++t)
+			free(spBins[t].mpPrimitives);
+
+	free(spBins);
+	free(spFramebuffer);
+	free(spPrimitives);
+	free(spBuildVertices);
+
+	spBins = 0;
+	spFramebuffer = 0;
+	spPrimitives = 0;
+	spBuildVertices = 0;
+	sgPrimitiveNum = sgPrimitiveCapacity = 0;
+	sgBuildNum = sgBuildCapacity = 0;
+	sgWidth = sgHeight = sgTileNumX = sgTileNumY = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxSetBackgroundColor(float Red, float Green, float Blue)
+{
+	u32 r = (u32)(255.0f * (Red < 0.0f ? 0.0f : Red > 1.0f ? 1.0f : Red) + 0.5f);
+	u32 g = (u32)(255.0f * (Green < 0.0f ? 0.0f : Green > 1.0f ? 1.0f : Green) + 0.5f);
+	u32 b = (u32)(255.0f * (Blue < 0.0f ? 0.0f : Blue > 1.0f ? 1.0f : Blue) + 0.5f);
+
+	sgBackground = 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxSetRenderMode(unsigned int RenderMode)
+{
+	// Colors only
+	(void)RenderMode;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxSetTransform(float pTransform[3][3])
+{
+	f32 halfWidth = 0.5f * sgWidth, halfHeight = 0.5f * sgHeight;
+
+	// The viewport flips y and moves the origin to the middle
+	sgTransform[0][0] = pTransform[0][0];
+	sgTransform[0][1] = pTransform[0][1];
+	sgTransform[0][2] = pTransform[0][2] + halfWidth;
+	sgTransform[1][0] = -pTransform[1][0];
+	sgTransform[1][1] = -pTransform[1][1];
+	sgTransform[1][2] = halfHeight - pTransform[1][2];
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxMeshStart(void)
+{
+	sgBuildNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxTriAdd(f32 x0, f32 y0, u32 c0, f32 tu0, f32 tv0,
+	f32 x1, f32 y1, u32 c1, f32 tu1, f32 tv1,
+	f32 x2, f32 y2, u32 c2, f32 tu2, f32 tv2)
+{
+	(void)tu0; (void)tv0; (void)tu1; (void)tv1; (void)tu2; (void)tv2;
+
+	AddVertex(x0, y0, c0);
+	AddVertex(x1, y1, c1);
+	AddVertex(x2, y2, c2);
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxVertexAdd(f32 x0, f32 y0, u32 c0, f32 tu0, f32 tv0)
+{
+	(void)tu0; (void)tv0;
+
+	AddVertex(x0, y0, c0);
+}
+
+// ---------------------------------------------------------------------------
+
+SoftGfxMesh* SoftGfxMeshEnd(void)
+{
+	SoftGfxMesh *pMesh = (SoftGfxMesh *)malloc(sizeof(SoftGfxMesh));
+
+	if (0 == pMesh)
+		return 0;
+
+	pMesh->mVertexNum = sgBuildNum;
+	pMesh->mpVertices = (SoftGfxVertex *)malloc(sizeof(SoftGfxVertex) * (sgBuildNum ? sgBuildNum : 1));
+
+	if (0 == pMesh->mpVertices)
+	{
+		free(pMesh);
+		return 0;
+	}
+
+	memcpy(pMesh->mpVertices, spBuildVertices, sizeof(SoftGfxVertex) * sgBuildNum);
+	sgBuildNum = 0;
+
+	return pMesh;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxMeshFree(SoftGfxMesh *pMesh)
+{
+	if (0 == pMesh)
+		return;
+
+	free(pMesh->mpVertices);
+	free(pMesh);
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxMeshDraw(SoftGfxMesh *pMesh, unsigned int MeshDrawMode)
+{
+	u32 i;
+
+	if (0 == pMesh || 0 == spBins)
+		return;
+
+	switch (MeshDrawMode)
+	{
+	case SOFT_GFX_MDM_POINTS:
+		for (i = 0; i < pMesh->mVertexNum; ++i)
+			AddPrimitive(pMesh->mpVertices + i, 1, SOFT_GFX_PRIMITIVE_POINT);
+		break;
+
+	case SOFT_GFX_MDM_LINES:
+		for (i = 0; i + 1 < pMesh->mVertexNum; i += 2)
+			AddPrimitive(pMesh->mpVertices + i, 2, SOFT_GFX_PRIMITIVE_LINE);
+		break;
+
+	case SOFT_GFX_MDM_LINES_STRIP:
+		for (i = 0; i + 1 < pMesh->mVertexNum; ++i)
+			AddPrimitive(pMesh->mpVertices + i, 2, SOFT_GFX_PRIMITIVE_LINE);
+		break;
+
+	case SOFT_GFX_MDM_TRIANGLES:
+		for (i = 0; i + 2 < pMesh->mVertexNum; i += 3)
+			AddPrimitive(pMesh->mpVertices + i, 3, SOFT_GFX_PRIMITIVE_TRIANGLE);
+		break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxFrameStart(void)
+{
+	u32 t;
+
+	sgPrimitiveNum = 0;
+
+	for (t = 0; t < sgTileNumX * sgTileNumY; ++t)
+		spBins[t].mNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void SoftGfxFrameEnd(void)
+{
+	if (0 == spBins)
+		return;
+
+	sgNextTile = 0;
+
+	if (sgThreadNum > 1)
+	{
+		Lock();
+		sgBusyNum = sgThreadNum - 1;
+		++sgGeneration;
+		SignalWork();
+		Unlock();
+	}
+
+	RasterTiles();
+
+	if (sgThreadNum > 1)
+	{
+		Lock();
+		while (sgBusyNum > 0)
+			WaitDone();
+		Unlock();
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+const u32* SoftGfxGetFramebuffer(u32 *pWidth, u32 *pHeight)
+{
+	if (pWidth)
+		*pWidth = sgWidth;
+	if (pHeight)
+		*pHeight = sgHeight;
+
+	return spFramebuffer;
+}
+
+// ---------------------------------------------------------------------------
+
+int SoftGfxDumpPPM(const char *pFileName)
+{
+	FILE *pFile;
+	u8 *pRow;
+	u32 x, y;
+	int result = 1;
+
+	if (0 == spFramebuffer)
+		return 0;
+
+	pRow = (u8 *)malloc(3 * sgWidth);
+	pFile = pRow ? fopen(pFileName, "wb") : 0;
+
+	if (0 == pFile)
+	{
+		free(pRow);
+		return 0;
+	}
+
+	fprintf(pFile, "P6\n%lu %lu\n255\n", (unsigned long)sgWidth, (unsigned long)sgHeight);
+
+	for (y = 0; result && y < sgHeight; ++y)
+	{
+		const u32 *pPixels = spFramebuffer + y * sgWidth;
+
+		for (x = 0; x < sgWidth; ++x)
+		{
+			pRow[3 * x + 0] = (u8)(pPixels[x] >> 16);
+			pRow[3 * x + 1] = (u8)(pPixels[x] >> 8);
+			pRow[3 * x + 2] = (u8)(pPixels[x]);
+		}
+
+		result = (sgWidth == fwrite(pRow, 3, sgWidth, pFile));
+	}
+
+	fclose(pFile);
+	free(pRow);
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+
+void AddVertex(f32 x, f32 y, u32 Color)
+{
+	if (sgBuildNum == sgBuildCapacity)
+	{
+		u32 capacity = sgBuildCapacity ? 2 * sgBuildCapacity : 64;
+		SoftGfxVertex *pVertices = (SoftGfxVertex *)realloc(spBuildVertices, sizeof(SoftGfxVertex) * capacity);
+
+		// Dropped, like the engine drops what doesn't fit
+		if (0 == pVertices)
+			return;
+
+		spBuildVertices = pVertices;
+		sgBuildCapacity = capacity;
+	}
+
+	spBuildVertices[sgBuildNum].mX = x;
+	spBuildVertices[sgBuildNum].mY = y;
+	spBuildVertices[sgBuildNum].mColor = Color;
+	++sgBuildNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void AddPrimitive(const SoftGfxVertex *pVertices, u32 VertexNum, u32 Type)
+{
+	SoftGfxPrimitive *pPrimitive;
+	f32 minX, minY, maxX, maxY;
+	s32 tileX0, tileY0, tileX1, tileY1, tx, ty;
+	u32 i;
+
+	if (sgPrimitiveNum == sgPrimitiveCapacity)
+	{
+		u32 capacity = sgPrimitiveCapacity ? 2 * sgPrimitiveCapacity : 1024;
+		SoftGfxPrimitive *pPrimitives = (SoftGfxPrimitive *)realloc(spPrimitives, sizeof(SoftGfxPrimitive) * capacity);
+
+		if (0 == pPrimitives)
+			return;
+
+		spPrimitives = pPrimitives;
+		sgPrimitiveCapacity = capacity;
+	}
+
+	pPrimitive = spPrimitives + sgPrimitiveNum;
+	pPrimitive->mType = Type;
+
+	for (i = 0; i < VertexNum; ++i)
+	{
+		f32 x = pVertices[i].mX, y = pVertices[i].mY;
+
+		pPrimitive->mX[i] = sgTransform[0][0] * x + sgTransform[0][1] * y + sgTransform[0][2];
+		pPrimitive->mY[i] = sgTransform[1][0] * x + sgTransform[1][1] * y + sgTransform[1][2];
+		pPrimitive->mColor[i] = pVertices[i].mColor;
+	}
+
+	minX = maxX = pPrimitive->mX[0];
+	minY = maxY = pPrimitive->mY[0];
+
+	for (i = 1; i < VertexNum; ++i)
+	{
+		minX = (pPrimitive->mX[i] < minX) ? pPrimitive->mX[i] : minX;
+		maxX = (pPrimitive->mX[i] > maxX) ? pPrimitive->mX[i] : maxX;
+		minY = (pPrimitive->mY[i] < minY) ? pPrimitive->mY[i] : minY;
+		maxY = (pPrimitive->mY[i] > maxY) ? pPrimitive->mY[i] : maxY;
+	}
+
+	// Off screen, or NaNs
+	if (!(maxX >= 0.0f && maxY >= 0.0f && minX < (f32)sgWidth && minY < (f32)sgHeight))
+		return;
+
+	// Conservative: a tile only rasterizes the pixels its primitives really cover
+	tileX0 = (minX > 0.0f) ? (s32)minX / SOFT_GFX_TILE_SIZE : 0;
+	tileY0 = (minY > 0.0f) ? (s32)minY / SOFT_GFX_TILE_SIZE : 0;
+	tileX1 = (maxX < (f32)sgWidth) ? (s32)maxX / SOFT_GFX_TILE_SIZE : (s32)sgTileNumX - 1;
+	tileY1 = (maxY < (f32)sgHeight) ? (s32)maxY / SOFT_GFX_TILE_SIZE : (s32)sgTileNumY - 1;
+
+	for (ty = tileY0; ty <= tileY1; ++ty)
+		for (tx = tileX0; tx <= tileX1; ++tx)
+			BinPush(spBins + ty * sgTileNumX + tx, sgPrimitiveNum);
+
+	++sgPrimitiveNum;
+}
+
+// ---------------------------------------------------------------------------
+
+int BinPush(SoftGfxBin *pBin, u32 Primitive)
+{
+	if (pBin->mNum == pBin->mCapacity)
+	{
+		u32 capacity = pBin->mCapacity ? 2 * pBin->mCapacity : 64;
+		u32 *pPrimitives = (u32 *)realloc(pBin->mpPrimitives, sizeof(u32) * capacity);
+
+		if (0 == pPrimitives)
+			return 0;
+
+		pBin->mpPrimitives = pPrimitives;
+		pBin->mCapacity = capacity;
+	}
+
+	pBin->mpPrimitives[pBin->mNum++] = Primitive;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void RasterTiles(void)
+{
+	u32 tileNum = sgTileNumX * sgTileNumY;
+	u32 tile;
+
+	while ((tile = (u32)SOFT_GFX_ATOMIC_INC(&sgNextTile)) < tileNum)
+		RasterTile(tile);
+}
+
+// ---------------------------------------------------------------------------
+
+void RasterTile(u32 Tile)
+{
+	const SoftGfxBin *pBin = spBins + Tile;
+	SoftGfxRect rect;
+	s32 x, y;
+	u32 i;
+
+	rect.mX0 = (s32)(Tile % sgTileNumX) * SOFT_GFX_TILE_SIZE;
+	rect.mY0 = (s32)(Tile / sgTileNumX) * SOFT_GFX_TILE_SIZE;
+	rect.mX1 = (rect.mX0 + SOFT_GFX_TILE_SIZE < (s32)sgWidth) ? rect.mX0 + SOFT_GFX_TILE_SIZE - 1 : (s32)sgWidth - 1;
+	rect.mY1 = (rect.mY0 + SOFT_GFX_TILE_SIZE < (s32)sgHeight) ? rect.mY0 + SOFT_GFX_TILE_SIZE - 1 : (s32)sgHeight - 1;
+
+	for (y = rect.mY0; y <= rect.mY1; ++y)
+	{
+		u32 *pPixels = spFramebuffer + y * sgWidth;
+
+		for (x = rect.mX0; x <= rect.mX1; ++x)
+			pPixels[x] = sgBackground;
+	}
+
+	for (i = 0; i < pBin->mNum; ++i)
+	{
+		const SoftGfxPrimitive *pPrimitive = spPrimitives + pBin->mpPrimitives[i];
+
+		switch (pPrimitive->mType)
+		{
+		case SOFT_GFX_PRIMITIVE_TRIANGLE:
+			RasterTriangle(pPrimitive, &rect);
+			break;
+
+		case SOFT_GFX_PRIMITIVE_LINE:
+			RasterLine(pPrimitive, &rect);
+			break;
+
+		case SOFT_GFX_PRIMITIVE_POINT:
+			x = (s32)floorf(pPrimitive->mX[0]);
+			y = (s32)floorf(pPrimitive->mY[0]);
+
+			if (x >= rect.mX0 && x <= rect.mX1 && y >= rect.mY0 && y <= rect.mY1)
+				spFramebuffer[y * sgWidth + x] = 0xFF000000 | pPrimitive->mColor[0];
+			break;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RasterTriangle(const SoftGfxPrimitive *pPrimitive, const SoftGfxRect *pTile)
+{
+	s64 x[3], y[3], a[3], b[3], bias[3], rowE[3];
+	s64 area, minX, minY, maxX, maxY, centerX, centerY;
+	f32 invArea;
+	f32 channels[3][4];
+	s32 x0, y0, x1, y1, px, py;
+	u32 i, j, flat;
+
+	// Snapped to the subpixel grid. Edges shared by 2 triangles then have bit-identical ends
+	for (i = 0; i < 3; ++i)
+	{
+		if (!(fabsf(pPrimitive->mX[i]) <= SOFT_GFX_GUARD_BAND && fabsf(pPrimitive->mY[i]) <= SOFT_GFX_GUARD_BAND))
+			return;
+
+		x[i] = (s64)floorf(pPrimitive->mX[i] * SOFT_GFX_SUBPIXEL_ONE + 0.5f);
+		y[i] = (s64)floorf(pPrimitive->mY[i] * SOFT_GFX_SUBPIXEL_ONE + 0.5f);
+	}
+
+	area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+	if (0 == area)
+		return;
+
+	// Edge i is opposite to vertex i: E_i(p) = a_i * (px - x_from) + b_i * (py - y_from), positive inside.
+	// Exact in integers, so the 2 triangles sharing an edge get exactly opposite values on it
+	for (i = 0; i < 3; ++i)
+	{
+		u32 from = (i + 1) % 3, to = (i + 2) % 3;
+
+		a[i] = (area > 0) ? y[from] - y[to] : y[to] - y[from];
+		b[i] = (area > 0) ? x[to] - x[from] : x[from] - x[to];
+
+		// Top-left rule: a pixel center on an edge goes to exactly one of the 2 triangles sharing it
+		bias[i] = (a[i] > 0 || (0 == a[i] && b[i] > 0)) ? 0 : -1;
+	}
+
+	invArea = 1.0f / (f32)((area > 0) ? area : -area);
+
+	// Pixels with their center in the triangle's bounding box, clipped to the tile
+	minX = x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]);
+	maxX = x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]);
+	minY = y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]);
+	maxY = y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]);
+
+	minX -= SOFT_GFX_SUBPIXEL_HALF; maxX -= SOFT_GFX_SUBPIXEL_HALF;
+	minY -= SOFT_GFX_SUBPIXEL_HALF; maxY -= SOFT_GFX_SUBPIXEL_HALF;
+
+	x0 = (minX > (s64)pTile->mX0 << SOFT_GFX_SUBPIXEL_BITS) ? (s32)((minX + SOFT_GFX_SUBPIXEL_ONE - 1) >> SOFT_GFX_SUBPIXEL_BITS) : pTile->mX0;
+	y0 = (minY > (s64)pTile->mY0 << SOFT_GFX_SUBPIXEL_BITS) ? (s32)((minY + SOFT_GFX_SUBPIXEL_ONE - 1) >> SOFT_GFX_SUBPIXEL_BITS) : pTile->mY0;
+	x1 = (maxX < (s64)pTile->mX1 << SOFT_GFX_SUBPIXEL_BITS) ? ((maxX < 0) ? -1 : (s32)(maxX >> SOFT_GFX_SUBPIXEL_BITS)) : pTile->mX1;
+	y1 = (maxY < (s64)pTile->mY1 << SOFT_GFX_SUBPIXEL_BITS) ? ((maxY < 0) ? -1 : (s32)(maxY >> SOFT_GFX_SUBPIXEL_BITS)) : pTile->mY1;
+
+	if (x0 > x1 || y0 > y1)
+		return;
+
+	flat = (pPrimitive->mColor[0] == pPrimitive->mColor[1] && pPrimitive->mColor[0] == pPrimitive->mColor[2]);
+
+	for (i = 0; i < 3; ++i)
+		for (j = 0; j < 4; ++j)
+			channels[i][j] = (f32)((pPrimitive->mColor[i] >> (8 * j)) & 0xFF);
+
+	// The edge values at the center of the first pixel, stepped by whole pixels from there
+	centerX = ((s64)x0 << SOFT_GFX_SUBPIXEL_BITS) + SOFT_GFX_SUBPIXEL_HALF;
+	centerY = ((s64)y0 << SOFT_GFX_SUBPIXEL_BITS) + SOFT_GFX_SUBPIXEL_HALF;
+
+	for (i = 0; i < 3; ++i)
+	{
+		u32 from = (i + 1) % 3;
+
+		rowE[i] = a[i] * (centerX - x[from]) + b[i] * (centerY - y[from]);
+	}
+
+	for (py = y0; py <= y1; ++py)
+	{
+		u32 *pPixels = spFramebuffer + py * sgWidth;
+		s64 e0 = rowE[0], e1 = rowE[1], e2 = rowE[2];
+
+		for (px = x0; px <= x1; ++px)
+		{
+			if (((e0 + bias[0]) | (e1 + bias[1]) | (e2 + bias[2])) >= 0)
+			{
+				if (flat)
+					pPixels[px] = 0xFF000000 | pPrimitive->mColor[0];
+				else
+				{
+					f32 w0 = (f32)e0 * invArea, w1 = (f32)e1 * invArea, w2 = (f32)e2 * invArea;
+					u32 color = 0xFF000000;
+
+					for (j = 0; j < 3; ++j)
+					{
+						f32 channel = w0 * channels[0][j] + w1 * channels[1][j] + w2 * channels[2][j] + 0.5f;
+
+						color |= (u32)(channel < 255.0f ? (channel > 0.0f ? channel : 0.0f) : 255.0f) << (8 * j);
+					}
+
+					pPixels[px] = color;
+				}
+			}
+
+			e0 += a[0] << SOFT_GFX_SUBPIXEL_BITS;
+			e1 += a[1] << SOFT_GFX_SUBPIXEL_BITS;
+			e2 += a[2] << SOFT_GFX_SUBPIXEL_BITS;
+		}
+
+		for (i = 0; i < 3; ++i)
+			rowE[i] += b[i] << SOFT_GFX_SUBPIXEL_BITS;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RasterLine(const SoftGfxPrimitive *pPrimitive, const SoftGfxRect *pTile)
+{
+	f32 x0 = pPrimitive->mX[0], y0 = pPrimitive->mY[0];
+	f32 dx = pPrimitive->mX[1] - x0, dy = pPrimitive->mY[1] - y0;
+	f32 t0 = 0.0f, t1 = 1.0f;
+	f32 p[4], q[4];
+	s32 stepNum, first, last, i;
+	u32 k;
+
+	// One pixel per step along the major axis. The steps are numbered along the whole
+	// line, so the tiles it crosses plot the same pixels as a single pass would
+	stepNum = (s32)ceilf(fabsf(dx) > fabsf(dy) ? fabsf(dx) : fabsf(dy));
+	stepNum = (stepNum > 0) ? stepNum : 1;
+
+	// Liang-Barsky: the part of the line within the tile
+	p[0] = -dx; q[0] = x0 - (f32)pTile->mX0;
+	p[1] = dx;	q[1] = (f32)(pTile->mX1 + 1) - x0;
+	p[2] = -dy; q[2] = y0 - (f32)pTile->mY0;
+	p[3] = dy;	q[3] = (f32)(pTile->mY1 + 1) - y0;
+
+	for (k = 0; k < 4; ++k)
+	{
+		if (0.0f == p[k])
+		{
+			if (q[k] < 0.0f)
+				return;
+		}
+		else
+		{
+			f32 t = q[k] / p[k];
+
+			if (p[k] < 0.0f)
+				t0 = (t > t0) ? t : t0;
+			else
+				t1 = (t < t1) ? t : t1;
+		}
+	}
+
+	if (t0 > t1)
+		return;
+
+	// One step of margin each side, the pixels outside the tile are skipped below
+	first = (s32)floorf(t0 * stepNum) - 1;
+	last = (s32)ceilf(t1 * stepNum) + 1;
+	first = (first > 0) ? first : 0;
+	last = (last < stepNum) ? last : stepNum;
+
+	for (i = first; i <= last; ++i)
+	{
+		f32 t = (f32)i / (f32)stepNum;
+		s32 px = (s32)floorf(x0 + t * dx), py = (s32)floorf(y0 + t * dy);
+
+		if (px < pTile->mX0 || px > pTile->mX1 || py < pTile->mY0 || py > pTile->mY1)
+			continue;
+
+		spFramebuffer[py * sgWidth + px] = 0xFF000000 | LerpColor(pPrimitive->mColor[0], pPrimitive->mColor[1], t);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+u32 LerpColor(u32 c0, u32 c1, f32 t)
+{
+	u32 color = 0, j;
+
+	if (c0 == c1)
+		return c0;
+
+	for (j = 0; j < 32; j += 8)
+	{
+		f32 a = (f32)((c0 >> j) & 0xFF), b = (f32)((c1 >> j) & 0xFF);
+
+		color |= (u32)(a + t * (b - a) + 0.5f) << j;
+	}
+
+	return color;
+}
+
+// ---------------------------------------------------------------------------
+
+int StartThreads(u32 ThreadNum)
+{
+	u32 t;
+
+	ThreadNum = (ThreadNum < SOFT_GFX_THREAD_NUM_MAX) ? ThreadNum : SOFT_GFX_THREAD_NUM_MAX;
+	ThreadNum = (ThreadNum > 0) ? ThreadNum : 1;
+
+	sgQuit = 0;
+	sgGeneration = 0;
+	sgBusyNum = 0;
+	sgThreadNum = 1;
+
+	if (1 == ThreadNum)
+		return 1;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&sgLock);
+	InitializeConditionVariable(&sgWorkCond);
+	InitializeConditionVariable(&sgDoneCond);
+#else
+	pthread_mutex_init(&sgLock, 0);
+	pthread_cond_init(&sgWorkCond, 0);
+	pthread_cond_init(&sgDoneCond, 0);
+#endif
+
+	for (t = 1; t < ThreadNum; ++t)
+	{
+#ifdef _WIN32
+		sgThreads[t] = CreateThread(NULL, 0, RasterThread, NULL, 0, NULL);
+		if (NULL == sgThreads[t])
+			break;
+#else
+		if (0 != pthread_create(sgThreads + t, 0, RasterThread, 0))
+			break;
+#endif
+
+		// Counted once the thread exists, so StopThreads only joins the started ones
+		++sgThreadNum;
+	}
+
+	if (sgThreadNum == ThreadNum)
+		return 1;
+
+	// StopThreads tears the lock down with the started threads. With none, it's left to us
+	if (1 == sgThreadNum)
+		DestroyLock();
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void StopThreads(void)
+{
+	u32 t;
+
+	if (sgThreadNum <= 1)
+	{
+		sgThreadNum = 0;
+		return;
+	}
+
+	Lock();
+	sgQuit = 1;
+	SignalWork();
+	Unlock();
+
+	for (t = 1; t < sgThreadNum; ++t)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(sgThreads[t], INFINITE);
+		CloseHandle(sgThreads[t]);
+#else
+		pthread_join(sgThreads[t], 0);
+#endif
+	}
+
+	DestroyLock();
+
+	sgThreadNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void DestroyLock(void)
+{
+#ifdef _WIN32
+	DeleteCriticalSection(&sgLock);
+#else
+	pthread_cond_destroy(&sgDoneCond);
+	pthread_cond_destroy(&sgWorkCond);
+	pthread_mutex_destroy(&sgLock);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+DWORD WINAPI RasterThread(LPVOID pParam)
+#else
+void* RasterThread(void *pParam)
+#endif
+{
+	// The generation StartThreads set before creating the thread, not the current one:
+	// a FrameEnd running before the thread gets here must still be seen as new work
+	u32 generation = 0;
+
+	(void)pParam;
+
+	Lock();
+
+	for (;;)
+	{
+		while (generation == sgGeneration && 0 == sgQuit)
+			WaitWork();
+
+		if (sgQuit)
+			break;
+
+		generation = sgGeneration;
+		Unlock();
+
+		RasterTiles();
+
+		Lock();
+		if (0 == --sgBusyNum)
+			SignalDone();
+	}
+
+	Unlock();
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+void Lock(void)			{ EnterCriticalSection(&sgLock); }
+void Unlock(void)		{ LeaveCriticalSection(&sgLock); }
+void WaitWork(void)		{ SleepConditionVariableCS(&sgWorkCond, &sgLock, INFINITE); }
+void WaitDone(void)		{ SleepConditionVariableCS(&sgDoneCond, &sgLock, INFINITE); }
+void SignalWork(void)	{ WakeAllConditionVariable(&sgWorkCond); }
+void SignalDone(void)	{ WakeAllConditionVariable(&sgDoneCond); }
+
+#else
+
+void Lock(void)			{ pthread_mutex_lock(&sgLock); }
+void Unlock(void)		{ pthread_mutex_unlock(&sgLock); }
+void WaitWork(void)		{ pthread_cond_wait(&sgWorkCond, &sgLock); }
+void WaitDone(void)		{ pthread_cond_wait(&sgDoneCond, &sgLock); }
+void SignalWork(void)	{ pthread_cond_broadcast(&sgWorkCond); }
+void SignalDone(void)	{ pthread_cond_broadcast(&sgDoneCond); }
+
+#endif
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SoftGfx.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the portable software rasterizer
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef SOFT_GFX_H
+#define SOFT_GFX_H
+
+// ---------------------------------------------------------------------------
+
+// Only the types: this module builds without the engine, on any platform with pthreads or Win32
+#include "AETypes.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define SOFT_GFX_TILE_SIZE				64					// Pixels per tile side (power of 2)
+#define SOFT_GFX_THREAD_NUM_MAX			64
+
+// Same values as AEGfxMeshDrawMode
+enum SOFT_GFX_MDM
+{
+	SOFT_GFX_MDM_POINTS = 0,
+	SOFT_GFX_MDM_LINES,
+	SOFT_GFX_MDM_LINES_STRIP,
+	SOFT_GFX_MDM_TRIANGLES,
+
+	// Keep this one last
+	SOFT_GFX_MDM_NUM
+};
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+typedef struct SoftGfxMesh SoftGfxMesh;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+The subset of AEGfx the project draws with, on the CPU, into a Width x Height
+framebuffer. The world maps to the framebuffer like AEGfx maps it to the window:
+1 unit per pixel, the origin in the middle, y up.
+
+A frame is recorded, then rasterized:
+	- SoftGfxFrameStart empties the frame
+	- SoftGfxMeshDraw transforms the mesh's primitives to the screen, and bins
+	  them into the SOFT_GFX_TILE_SIZE tiles their bounding box covers
+	- SoftGfxFrameEnd clears every tile to the background color and draws its
+	  primitives in order. The tiles are spread over ThreadNum threads,
+	  the calling one included: they share no pixel, so they need no lock
+
+Vertex colors are interpolated, and written opaque: there is no blending and no
+texture (the render mode is ignored). Triangles follow a top-left fill rule,
+lines are 1 pixel wide.
+
+See SoftGfxCompat.h to draw the project's AEGfx calls with it, and
+SoftGfxDemo.c to run it without the engine ("make run" on Linux).
+
+ - Returns 1 on success, 0 if an allocation or a thread failed
+*/
+int SoftGfxInit(u32 Width, u32 Height, u32 ThreadNum);
+void SoftGfxExit(void);
+
+void SoftGfxSetBackgroundColor(float Red, float Green, float Blue);
+void SoftGfxSetRenderMode(unsigned int RenderMode);
+void SoftGfxSetTransform(float pTransform[3][3]);
+
+// Meshes are built like with AEGfx, and stay valid until freed
+void SoftGfxMeshStart(void);
+void SoftGfxTriAdd(f32 x0, f32 y0, u32 c0, f32 tu0, f32 tv0,
+	f32 x1, f32 y1, u32 c1, f32 tu1, f32 tv1,
+	f32 x2, f32 y2, u32 c2, f32 tu2, f32 tv2);
+void SoftGfxVertexAdd(f32 x0, f32 y0, u32 c0, f32 tu0, f32 tv0);
+SoftGfxMesh* SoftGfxMeshEnd(void);
+void SoftGfxMeshFree(SoftGfxMesh *pMesh);
+
+// MeshDrawMode: from the SOFT_GFX_MDM enum
+void SoftGfxMeshDraw(SoftGfxMesh *pMesh, unsigned int MeshDrawMode);
+
+void SoftGfxFrameStart(void);
+void SoftGfxFrameEnd(void);
+
+// 0xAARRGGBB, row 0 at the top. Valid until SoftGfxExit
+const u32* SoftGfxGetFramebuffer(u32 *pWidth, u32 *pHeight);
+
+// Binary PPM of the last rasterized frame. Returns 0 if the file couldn't be written
+int SoftGfxDumpPPM(const char *pFileName);
+
+// ---------------------------------------------------------------------------
+
+#endif // SOFT_GFX_H
@@ -0,0 +1,45 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SoftGfxCompat.h
+// Creation Date	:	2026/10/19
+// Purpose			:	routes the project's AEGfx calls to SoftGfx
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef SOFT_GFX_COMPAT_H
+#define SOFT_GFX_COMPAT_H
+
+// ---------------------------------------------------------------------------
+
+// First, so the engine's own declarations are left alone
+#include "AEEngine.h"
+#include "SoftGfx.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+// 1: the project draws with the software rasterizer. Set it from the build on the hosts without the engine's graphics
+#ifndef AE_GFX_SOFTWARE
+#define AE_GFX_SOFTWARE					0
+#endif
+
+#if(AE_GFX_SOFTWARE)
+
+// Only the calls the project makes. GSM_MainLoop starts, rasterizes and presents the frame
+#define AEGfxVertexList					SoftGfxMesh
+#define AEGfxMeshStart					SoftGfxMeshStart
+#define AEGfxTriAdd						SoftGfxTriAdd
+#define AEGfxVertexAdd					SoftGfxVertexAdd
+#define AEGfxMeshEnd					SoftGfxMeshEnd
+#define AEGfxMeshFree					SoftGfxMeshFree
+#define AEGfxMeshDraw					SoftGfxMeshDraw
+#define AEGfxSetTransform				SoftGfxSetTransform
+#define AEGfxSetRenderMode				SoftGfxSetRenderMode
+#define AEGfxSetBackgroundColor			SoftGfxSetBackgroundColor
+
+#endif
+
+// ---------------------------------------------------------------------------
+
+#endif // SOFT_GFX_COMPAT_H
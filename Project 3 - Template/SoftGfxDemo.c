@@ -0,0 +1,273 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SoftGfxDemo.c
+// Creation Date	:	2026/10/19
+// Purpose			:	standalone driver for the software rasterizer: draws a
+//						generated cage scene, reports the frame times, and saves
+//						the last frame as a PPM. Builds without the engine
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "SoftGfx.h"
+#include "CageScene.h"
+#include "SinCos.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define DEMO_WIDTH						1024
+#define DEMO_HEIGHT						768
+#define DEMO_CIRCLE_SLICES				16
+#define DEMO_DT							(1.0f / 60.0f)
+#define DEMO_PI							3.1415926535897932f
+
+#define DEMO_WALL_COLOR					0xFFFFFF
+#define DEMO_PILLAR_COLOR				0x4080FF
+#define DEMO_BALL_COLOR					0xFFC020
+#define DEMO_BALL_RIM_COLOR				0x804000
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static double GetSeconds(void);
+static SoftGfxMesh* CreateCircleMesh(u32 CenterColor, u32 RimColor);
+static SoftGfxMesh* CreateWallMesh(const CageScene *pScene);
+static void DrawCircle(SoftGfxMesh *pMesh, float Scale, float x, float y, float Radius);
+static void MoveBalls(CageScene *pScene, float Dt);
+static int CompareDoubles(const void *pA, const void *pB);
+
+// ---------------------------------------------------------------------------
+
+/*
+SoftGfxDemo [ThreadNum [FrameNum [Output.ppm]]]
+
+The balls only fly straight and bounce off the cage's sides: the point is a
+frame whose primitives move, not the game's physics, which needs the engine
+*/
+int main(int argc, char *argv[])
+{
+	u32 threadNum = (argc > 1) ? (u32)atoi(argv[1]) : 4;
+	u32 frameNum = (argc > 2) ? (u32)atoi(argv[2]) : 300;
+	const char *pOutput = (argc > 3) ? argv[3] : "SoftGfxDemo.ppm";
+	CageSceneDesc desc;
+	CageScene scene;
+	SoftGfxMesh *pWalls, *pPillar, *pBall;
+	double *pFrameTimes, total = 0.0;
+	float scale;
+	u32 frame, i;
+	int result = 0;
+
+	if (0 == frameNum)
+		frameNum = 1;
+
+	CageSceneDescDefault(&desc);
+	desc.mLayout = CAGE_SCENE_LAYOUT_RINGS;
+	desc.mSegmentNum = 400;
+	desc.mPillarNum = 64;
+	desc.mBallNum = 2000;
+
+	if (0 == CageSceneGenerate(&scene, &desc))
+	{
+		printf("Couldn't generate the scene\n");
+		return 1;
+	}
+
+	if (0 == SoftGfxInit(DEMO_WIDTH, DEMO_HEIGHT, threadNum))
+	{
+		printf("Couldn't start the rasterizer\n");
+		CageSceneFree(&scene);
+		return 1;
+	}
+
+	// The whole cage fits the framebuffer's height
+	scale = 0.5f * DEMO_HEIGHT / (scene.mHalfSize * 1.05f);
+
+	pWalls = CreateWallMesh(&scene);
+	pPillar = CreateCircleMesh(DEMO_PILLAR_COLOR, DEMO_PILLAR_COLOR);
+	pBall = CreateCircleMesh(DEMO_BALL_COLOR, DEMO_BALL_RIM_COLOR);
+	pFrameTimes = (double *)malloc(sizeof(double) * frameNum);
+
+	if (0 == pWalls || 0 == pPillar || 0 == pBall || 0 == pFrameTimes)
+	{
+		printf("Out of memory\n");
+		result = 1;
+	}
+
+	SoftGfxSetBackgroundColor(0.0f, 0.0f, 0.0f);
+
+	for (frame = 0; 0 == result && frame < frameNum; ++frame)
+	{
+		float transform[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+		double start = GetSeconds();
+
+		MoveBalls(&scene, DEMO_DT);
+
+		SoftGfxFrameStart();
+
+		transform[0][0] = transform[1][1] = scale;
+		SoftGfxSetTransform(transform);
+		SoftGfxMeshDraw(pWalls, SOFT_GFX_MDM_LINES);
+
+		for (i = 0; i < scene.mPillarNum; ++i)
+			DrawCircle(pPillar, scale, scene.mpPillarCenters[i].x, scene.mpPillarCenters[i].y, scene.mpPillarRadii[i]);
+
+		for (i = 0; i < scene.mBallNum; ++i)
+			DrawCircle(pBall, scale, scene.mpBallPositions[i].x, scene.mpBallPositions[i].y, scene.mpBallRadii[i]);
+
+		SoftGfxFrameEnd();
+
+		pFrameTimes[frame] = GetSeconds() - start;
+		total += pFrameTimes[frame];
+	}
+
+	if (0 == result)
+	{
+		// Nearest rank, like the bench
+		qsort(pFrameTimes, frameNum, sizeof(double), CompareDoubles);
+
+		printf("%lux%lu, %lu threads, %lu frames, %lu primitives per frame\n",
+			(unsigned long)DEMO_WIDTH, (unsigned long)DEMO_HEIGHT, (unsigned long)threadNum, (unsigned long)frameNum,
+			(unsigned long)(scene.mSegmentNum + DEMO_CIRCLE_SLICES * (scene.mPillarNum + scene.mBallNum)));
+		printf("frame ms: mean %.3f, median %.3f, p99 %.3f, max %.3f\n",
+			1000.0 * total / frameNum,
+			1000.0 * pFrameTimes[(frameNum - 1) / 2],
+			1000.0 * pFrameTimes[(u32)ceil(0.99 * frameNum) - 1],
+			1000.0 * pFrameTimes[frameNum - 1]);
+
+		if (SoftGfxDumpPPM(pOutput))
+			printf("last frame saved to %s\n", pOutput);
+		else
+		{
+			printf("Couldn't save %s\n", pOutput);
+			result = 1;
+		}
+	}
+
+	free(pFrameTimes);
+	SoftGfxMeshFree(pBall);
+	SoftGfxMeshFree(pPillar);
+	SoftGfxMeshFree(pWalls);
+	SoftGfxExit();
+	CageSceneFree(&scene);
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+
+double GetSeconds(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double)now.tv_sec + 1e-9 * (double)now.tv_nsec;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
+// A fan around the origin, radius 1. The slices share their rim vertices exactly
+SoftGfxMesh* CreateCircleMesh(u32 CenterColor, u32 RimColor)
+{
+	float sins[DEMO_CIRCLE_SLICES + 1], coss[DEMO_CIRCLE_SLICES + 1];
+	u32 i;
+
+	for (i = 0; i < DEMO_CIRCLE_SLICES; ++i)
+		SinCos(2.0f * DEMO_PI * i / DEMO_CIRCLE_SLICES, sins + i, coss + i, SINCOS_ACCURACY_FAST);
+
+	sins[DEMO_CIRCLE_SLICES] = sins[0];
+	coss[DEMO_CIRCLE_SLICES] = coss[0];
+
+	SoftGfxMeshStart();
+
+	for (i = 0; i < DEMO_CIRCLE_SLICES; ++i)
+		SoftGfxTriAdd(
+			0.0f, 0.0f, CenterColor, 0.0f, 0.0f,
+			coss[i], sins[i], RimColor, 0.0f, 0.0f,
+			coss[i + 1], sins[i + 1], RimColor, 0.0f, 0.0f);
+
+	return SoftGfxMeshEnd();
+}
+
+// ---------------------------------------------------------------------------
+
+SoftGfxMesh* CreateWallMesh(const CageScene *pScene)
+{
+	u32 i;
+
+	SoftGfxMeshStart();
+
+	for (i = 0; i < pScene->mSegmentNum; ++i)
+	{
+		SoftGfxVertexAdd(pScene->mpSegments[i].mP0.x, pScene->mpSegments[i].mP0.y, DEMO_WALL_COLOR, 0.0f, 0.0f);
+		SoftGfxVertexAdd(pScene->mpSegments[i].mP1.x, pScene->mpSegments[i].mP1.y, DEMO_WALL_COLOR, 0.0f, 0.0f);
+	}
+
+	return SoftGfxMeshEnd();
+}
+
+// ---------------------------------------------------------------------------
+
+void DrawCircle(SoftGfxMesh *pMesh, float Scale, float x, float y, float Radius)
+{
+	float transform[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+	transform[0][0] = transform[1][1] = Scale * Radius;
+	transform[0][2] = Scale * x;
+	transform[1][2] = Scale * y;
+
+	SoftGfxSetTransform(transform);
+	SoftGfxMeshDraw(pMesh, SOFT_GFX_MDM_TRIANGLES);
+}
+
+// ---------------------------------------------------------------------------
+
+void MoveBalls(CageScene *pScene, float Dt)
+{
+	u32 i;
+
+	for (i = 0; i < pScene->mBallNum; ++i)
+	{
+		Vector2D *pPosition = pScene->mpBallPositions + i;
+		Vector2D *pVelocity = pScene->mpBallVelocities + i;
+		float limit = pScene->mHalfSize - pScene->mpBallRadii[i];
+
+		pPosition->x += pVelocity->x * Dt;
+		pPosition->y += pVelocity->y * Dt;
+
+		if ((pPosition->x > limit && pVelocity->x > 0.0f) || (pPosition->x < -limit && pVelocity->x < 0.0f))
+			pVelocity->x = -pVelocity->x;
+
+		if ((pPosition->y > limit && pVelocity->y > 0.0f) || (pPosition->y < -limit && pVelocity->y < 0.0f))
+			pVelocity->y = -pVelocity->y;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+int CompareDoubles(const void *pA, const void *pB)
+{
+	double a = *(const double *)pA, b = *(const double *)pB;
+
+	return (a > b) - (a < b);
+}
@@ -0,0 +1,253 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SpatialHash.c
+// Creation Date	:	2026/10/19
+// Purpose			:	spatial hash over 64-bit packed cell coordinates, open
+//						addressing with linear probing, rebuilt every step with
+//						a counting sort
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SpatialHash.h"
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static u64 CellKey(const SpatialHash *pHash, float x, float y);
+static u64 PackCell(s32 cellX, s32 cellY);
+static u32 HashKey(u64 key);
+static const SpatialHashCell* FindCell(const SpatialHash *pHash, u64 key);
+
+// ---------------------------------------------------------------------------
+
+int SpatialHashInit(SpatialHash *pHash, float CellSize, u32 ItemCapacity)
+{
+	memset(pHash, 0, sizeof(SpatialHash));
+
+	pHash->mCellSize = CellSize;
+	pHash->mInvCellSize = 1.0f / CellSize;
+	pHash->mItemCapacity = ItemCapacity;
+
+	// Keep the load factor at or below 0.5, even with one item per cell
+	pHash->mCapacity = 16;
+	while (pHash->mCapacity < 2 * ItemCapacity)
+		pHash->mCapacity <<= 1;
+
+	pHash->mpItems = (u32 *)malloc(sizeof(u32) * ItemCapacity);
+	pHash->mpItemSlots = (u32 *)malloc(sizeof(u32) * ItemCapacity);
+	pHash->mpUsedSlots = (u32 *)malloc(sizeof(u32) * ItemCapacity);
+	pHash->mpCells = (SpatialHashCell *)calloc(pHash->mCapacity, sizeof(SpatialHashCell));
+
+	if (0 == pHash->mpItems || 0 == pHash->mpItemSlots || 0 == pHash->mpUsedSlots || 0 == pHash->mpCells)
+	{
+		SpatialHashFree(pHash);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialHashFree(SpatialHash *pHash)
+{
+	free(pHash->mpItems);
+	free(pHash->mpItemSlots);
+	free(pHash->mpUsedSlots);
+	free(pHash->mpCells);
+
+	memset(pHash, 0, sizeof(SpatialHash));
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialHashBuild(SpatialHash *pHash, const Vector2D *pPositions, u32 Num)
+{
+	SpatialHashBuildStrided(pHash, pPositions, sizeof(Vector2D), Num);
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialHashBuildStrided(SpatialHash *pHash, const Vector2D *pPositions, u32 Stride, u32 Num)
+{
+	const char *pBytes = (const char *)pPositions;
+	u32 mask = pHash->mCapacity - 1;
+	u32 i, start;
+
+	// Empty the slots used by the previous build, instead of the whole table
+	for (i = 0; i < pHash->mCellNum; ++i)
+		pHash->mpCells[pHash->mpUsedSlots[i]].mCount = 0;
+
+	pHash->mCellNum = 0;
+	pHash->mProbeMax = 0;
+	pHash->mProbeTotal = 0;
+	pHash->mItemNum = (Num < pHash->mItemCapacity) ? Num : pHash->mItemCapacity;
+
+	// Pass 1: find/insert every item's cell and count the items per cell
+	for (i = 0; i < pHash->mItemNum; ++i)
+	{
+		const Vector2D *pPosition = (const Vector2D *)(pBytes + (size_t)i * Stride);
+		u64 key = CellKey(pHash, pPosition->x, pPosition->y);
+		u32 slot = HashKey(key) & mask;
+		u32 probe = 1;
+		SpatialHashCell *pCell = pHash->mpCells + slot;
+
+		while (0 != pCell->mCount && pCell->mKey != key)
+		{
+			slot = (slot + 1) & mask;
+			pCell = pHash->mpCells + slot;
+			++probe;
+		}
+
+		if (0 == pCell->mCount)
+		{
+			pCell->mKey = key;
+			pHash->mpUsedSlots[pHash->mCellNum++] = slot;
+		}
+
+		++pCell->mCount;
+		pHash->mpItemSlots[i] = slot;
+
+		pHash->mProbeTotal += probe;
+		if (probe > pHash->mProbeMax)
+			pHash->mProbeMax = probe;
+	}
+
+	// Pass 2: prefix sum. mStart temporarily points past the cell's last item
+	start = 0;
+	for (i = 0; i < pHash->mCellNum; ++i)
+	{
+		SpatialHashCell *pCell = pHash->mpCells + pHash->mpUsedSlots[i];
+
+		start += pCell->mCount;
+		pCell->mStart = start;
+	}
+
+	// Pass 3: scatter backwards, so items stay in increasing order within a cell and mStart ends on the first one
+	for (i = pHash->mItemNum; i-- > 0;)
+	{
+		SpatialHashCell *pCell = pHash->mpCells + pHash->mpItemSlots[i];
+
+		pHash->mpItems[--pCell->mStart] = i;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+u32 SpatialHashGetCell(const SpatialHash *pHash, const Vector2D *pPosition, const u32 **ppItems)
+{
+	const SpatialHashCell *pCell = FindCell(pHash, CellKey(pHash, pPosition->x, pPosition->y));
+
+	if (0 == pCell)
+	{
+		*ppItems = 0;
+		return 0;
+	}
+
+	*ppItems = pHash->mpItems + pCell->mStart;
+	return pCell->mCount;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 SpatialHashQuery(const SpatialHash *pHash, const Vector2D *pCenter, float Radius, u32 *pResult, u32 ResultMax)
+{
+	s32 minX = (s32)floorf((pCenter->x - Radius) * pHash->mInvCellSize);
+	s32 maxX = (s32)floorf((pCenter->x + Radius) * pHash->mInvCellSize);
+	s32 minY = (s32)floorf((pCenter->y - Radius) * pHash->mInvCellSize);
+	s32 maxY = (s32)floorf((pCenter->y + Radius) * pHash->mInvCellSize);
+	s32 x, y;
+	u32 found = 0, i;
+
+	for (x = minX; x <= maxX; ++x)
+	{
+		for (y = minY; y <= maxY; ++y)
+		{
+			const SpatialHashCell *pCell = FindCell(pHash, PackCell(x, y));
+
+			if (0 == pCell)
+				continue;
+
+			for (i = 0; i < pCell->mCount; ++i, ++found)
+				if (found < ResultMax)
+					pResult[found] = pHash->mpItems[pCell->mStart + i];
+		}
+	}
+
+	return found;
+}
+
+// ---------------------------------------------------------------------------
+
+float SpatialHashGetLoadFactor(const SpatialHash *pHash)
+{
+	return (float)pHash->mCellNum / pHash->mCapacity;
+}
+
+// ---------------------------------------------------------------------------
+
+float SpatialHashGetAverageProbeLength(const SpatialHash *pHash)
+{
+	return pHash->mItemNum ? (float)((double)pHash->mProbeTotal / pHash->mItemNum) : 0.0f;
+}
+
+// ---------------------------------------------------------------------------
+
+u32 SpatialHashGetMaxProbeLength(const SpatialHash *pHash)
+{
+	return pHash->mProbeMax;
+}
+
+// ---------------------------------------------------------------------------
+
+u64 CellKey(const SpatialHash *pHash, float x, float y)
+{
+	return PackCell((s32)floorf(x * pHash->mInvCellSize), (s32)floorf(y * pHash->mInvCellSize));
+}
+
+// ---------------------------------------------------------------------------
+
+u64 PackCell(s32 cellX, s32 cellY)
+{
+	return ((u64)(cellX & 0xFFFFFFFF) << 32) | (u64)(cellY & 0xFFFFFFFF);
+}
+
+// ---------------------------------------------------------------------------
+
+u32 HashKey(u64 key)
+{
+	// 64-bit finalizer: neighbouring cells land far apart in the table
+	key ^= key >> 33;
+	key *= 0xFF51AFD7ED558CCDULL;
+	key ^= key >> 33;
+	key *= 0xC4CEB9FE1A85EC53ULL;
+	key ^= key >> 33;
+
+	return (u32)key;
+}
+
+// ---------------------------------------------------------------------------
+
+const SpatialHashCell* FindCell(const SpatialHash *pHash, u64 key)
+{
+	u32 mask = pHash->mCapacity - 1;
+	u32 slot = HashKey(key) & mask;
+	const SpatialHashCell *pCell = pHash->mpCells + slot;
+
+	while (0 != pCell->mCount)
+	{
+		if (pCell->mKey == key)
+			return pCell;
+
+		slot = (slot + 1) & mask;
+		pCell = pHash->mpCells + slot;
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
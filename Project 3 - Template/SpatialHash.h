@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Cage Game
+// File Name		:	SpatialHash.h
+// Creation Date	:	2026/10/19
+// Purpose			:	header file for the ball spatial hash
+// History			:
+// - 2026/10/19		:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+// ---------------------------------------------------------------------------
+
+#include "AETypes.h"
+#include "Vector2D.h"
+
+// ---------------------------------------------------------------------------
+// Struct definitions
+
+// One occupied grid cell. The table only holds occupied cells, so memory follows the ball count, not the level size
+typedef struct SpatialHashCell
+{
+	u64				mKey;				// Packed cell coordinates: x in the high 32 bits, y in the low 32 bits
+	u32				mStart;				// First item of the cell in mpItems
+	u32				mCount;				// 0 <=> empty slot
+}SpatialHashCell;
+
+// ---------------------------------------------------------------------------
+
+typedef struct SpatialHash
+{
+	float				mCellSize;
+	float				mInvCellSize;
+
+	u32					mItemCapacity;
+	u32					mItemNum;
+	u32					*mpItems;			// Item indices, grouped by cell
+	u32					*mpItemSlots;		// Table slot of every item (build scratch)
+
+	u32					mCapacity;			// Table slots, power of 2, at least twice mItemCapacity
+	SpatialHashCell		*mpCells;			// Open addressing table, linear probing
+	u32					mCellNum;			// Occupied slots
+	u32					*mpUsedSlots;		// The occupied slots, in insertion order
+
+	// Probe statistics of the last build
+	u32					mProbeMax;
+	u64					mProbeTotal;
+}SpatialHash;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+Allocates a hash for up to "ItemCapacity" items, bucketed in square cells of "CellSize".
+For ball-ball tests, a cell size of twice the biggest radius keeps every query to 3x3 cells.
+Returns 1 on success, 0 if the allocation failed
+*/
+int SpatialHashInit(SpatialHash *pHash, float CellSize, u32 ItemCapacity);
+void SpatialHashFree(SpatialHash *pHash);
+
+/*
+Rebuilds the hash from scratch with items 0..Num-1 at pPositions[0..Num-1]:
+one hashing pass counting the items per cell, a prefix sum over the occupied
+cells, and one scatter pass. Items past the capacity are ignored
+*/
+void SpatialHashBuild(SpatialHash *pHash, const Vector2D *pPositions, u32 Num);
+
+// Same, with item i's position Stride bytes after item i - 1's, for positions stored inside bigger structs
+void SpatialHashBuildStrided(SpatialHash *pHash, const Vector2D *pPositions, u32 Stride, u32 Num);
+
+// Items in the cell containing pPosition. Returns the item count, and the items in *ppItems
+u32 SpatialHashGetCell(const SpatialHash *pHash, const Vector2D *pPosition, const u32 **ppItems);
+
+/*
+Writes to pResult (up to ResultMax) the items in every cell overlapping the
+square of half size "Radius" around pCenter.
+Returns the number of items found, which can exceed ResultMax
+*/
+u32 SpatialHashQuery(const SpatialHash *pHash, const Vector2D *pCenter, float Radius, u32 *pResult, u32 ResultMax);
+
+// Occupied slots / table slots
+float SpatialHashGetLoadFactor(const SpatialHash *pHash);
+
+// Average and longest probe sequence of the last build, in slots (1 = found at the home slot)
+float SpatialHashGetAverageProbeLength(const SpatialHash *pHash);
+u32 SpatialHashGetMaxProbeLength(const SpatialHash *pHash);
+
+// ---------------------------------------------------------------------------
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,118 @@
+#ifndef VEC2_H
+#define VEC2_H
+
+#include <math.h>
+
+
+
+/*
+Value version of Vector2D: the vectors are passed and returned by value, and
+every function is defined here, static and inline, so each call compiles down
+to a few instructions on registers instead of a call and loads and stores
+through pointers.
+
+Vec2 and Vector2D are the same type, so both APIs can be mixed freely.
+The pointer API in Vector2D.h is written on top of this one.
+*/
+typedef struct Vector2D
+{
+	float x, y;
+}Vector2D;
+
+typedef Vector2D Vec2;
+
+// MSVC only knows "__inline" when compiling C
+#define VEC2_INLINE		static __inline
+
+
+VEC2_INLINE Vec2 Vec2Make(float x, float y)
+{
+	Vec2 result;
+
+	result.x = x;
+	result.y = y;
+	return result;
+}
+
+VEC2_INLINE Vec2 Vec2Zero(void)
+{
+	return Vec2Make(0.0f, 0.0f);
+}
+
+VEC2_INLINE Vec2 Vec2Neg(Vec2 v)
+{
+	return Vec2Make(-v.x, -v.y);
+}
+
+VEC2_INLINE Vec2 Vec2Add(Vec2 a, Vec2 b)
+{
+	return Vec2Make(a.x + b.x, a.y + b.y);
+}
+
+VEC2_INLINE Vec2 Vec2Sub(Vec2 a, Vec2 b)
+{
+	return Vec2Make(a.x - b.x, a.y - b.y);
+}
+
+VEC2_INLINE Vec2 Vec2Scale(Vec2 v, float c)
+{
+	return Vec2Make(v.x * c, v.y * c);
+}
+
+// c * a + b, like Vector2DScaleAdd
+VEC2_INLINE Vec2 Vec2ScaleAdd(Vec2 a, Vec2 b, float c)
+{
+	return Vec2Make(c * a.x + b.x, c * a.y + b.y);
+}
+
+// c * a - b, like Vector2DScaleSub
+VEC2_INLINE Vec2 Vec2ScaleSub(Vec2 a, Vec2 b, float c)
+{
+	return Vec2Make(c * a.x - b.x, c * a.y - b.y);
+}
+
+VEC2_INLINE float Vec2Dot(Vec2 a, Vec2 b)
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+// z of the 3D cross product: positive when b is counterclockwise from a
+VEC2_INLINE float Vec2Cross(Vec2 a, Vec2 b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+// Rotated 90 degrees counterclockwise
+VEC2_INLINE Vec2 Vec2Perp(Vec2 v)
+{
+	return Vec2Make(-v.y, v.x);
+}
+
+VEC2_INLINE float Vec2SquareLength(Vec2 v)
+{
+	return v.x * v.x + v.y * v.y;
+}
+
+VEC2_INLINE float Vec2Length(Vec2 v)
+{
+	return sqrtf(Vec2SquareLength(v));
+}
+
+// The zero vector has no direction: it gives NaNs, like Vector2DNormalize always did
+VEC2_INLINE Vec2 Vec2Normalize(Vec2 v)
+{
+	float length = Vec2Length(v);
+
+	return Vec2Make(v.x / length, v.y / length);
+}
+
+VEC2_INLINE float Vec2SquareDistance(Vec2 a, Vec2 b)
+{
+	return Vec2SquareLength(Vec2Sub(a, b));
+}
+
+VEC2_INLINE float Vec2Distance(Vec2 a, Vec2 b)
+{
+	return sqrtf(Vec2SquareDistance(a, b));
+}
+#endif
@@ -1,47 +1,93 @@
 #ifndef VECTOR2_H
 #define VECTOR2_H
 
-#include "math.h"
+#include "Vec2.h"
 
 
 
-typedef struct Vector2D
-{
-	float x, y;
-}Vector2D;
+/*
+The pointer API, kept for the existing code. It's a thin layer over Vec2.h,
+inline too: once inlined, the compiler drops the loads and stores through the
+pointers, so it costs the same as the value API
+*/
 
 ////////////////////////
 // From Project 2 & 3 //
 ////////////////////////
 
 
-void Vector2DZero(Vector2D *pResult);
+VEC2_INLINE void Vector2DZero(Vector2D *pResult)
+{
+	*pResult = Vec2Zero();
+}
+
+VEC2_INLINE void Vector2DSet(Vector2D *pResult, float x, float y)
+{
+	*pResult = Vec2Make(x, y);
+}
 
-void Vector2DSet(Vector2D *pResult, float x, float y);
+VEC2_INLINE void Vector2DNeg(Vector2D *pResult, Vector2D *pVec0)
+{
+	*pResult = Vec2Neg(*pVec0);
+}
 
-void Vector2DNeg(Vector2D *pResult, Vector2D *pVec0);
+VEC2_INLINE void Vector2DAdd(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1)
+{
+	*pResult = Vec2Add(*pVec0, *pVec1);
+}
 
-void Vector2DAdd(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1);
+VEC2_INLINE void Vector2DSub(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1)
+{
+	*pResult = Vec2Sub(*pVec0, *pVec1);
+}
 
-void Vector2DSub(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1);
+VEC2_INLINE void Vector2DNormalize(Vector2D *pResult, Vector2D *pVec0)
+{
+	*pResult = Vec2Normalize(*pVec0);
+}
 
-void Vector2DNormalize(Vector2D *pResult, Vector2D *pVec0);
+VEC2_INLINE void Vector2DScale(Vector2D *pResult, Vector2D *pVec0, float c)
+{
+	*pResult = Vec2Scale(*pVec0, c);
+}
 
-void Vector2DScale(Vector2D *pResult, Vector2D *pVec0, float c);
+//Scale THEN add
+VEC2_INLINE void Vector2DScaleAdd(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1, float c)
+{
+	*pResult = Vec2ScaleAdd(*pVec0, *pVec1, c);
+}
 
-void Vector2DScaleAdd(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1, float c);
+VEC2_INLINE void Vector2DScaleSub(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1, float c)
+{
+	*pResult = Vec2ScaleSub(*pVec0, *pVec1, c);
+}
 
-void Vector2DScaleSub(Vector2D *pResult, Vector2D *pVec0, Vector2D *pVec1, float c);
+VEC2_INLINE float Vector2DLength(Vector2D *pVec0)
+{
+	return Vec2Length(*pVec0);
+}
 
-float Vector2DLength(Vector2D *pVec0);
+VEC2_INLINE float Vector2DSquareLength(Vector2D *pVec0)
+{
+	return Vec2SquareLength(*pVec0);
+}
 
-float Vector2DSquareLength(Vector2D *pVec0);
+VEC2_INLINE float Vector2DDistance(Vector2D *pVec0, Vector2D *pVec1)
+{
+	return Vec2Distance(*pVec0, *pVec1);
+}
 
-float Vector2DDistance(Vector2D *pVec0, Vector2D *pVec1);
+VEC2_INLINE float Vector2DSquareDistance(Vector2D *pVec0, Vector2D *pVec1)
+{
+	return Vec2SquareDistance(*pVec0, *pVec1);
+}
 
-float Vector2DSquareDistance(Vector2D *pVec0, Vector2D *pVec1);
+VEC2_INLINE float Vector2DDotProduct(Vector2D *pVec0, Vector2D *pVec1)
+{
+	return Vec2Dot(*pVec0, *pVec1);
+}
 
-float Vector2DDotProduct(Vector2D *pVec0, Vector2D *pVec1);
+// Out of line, in Vector2D.c
 
 void Vector2DFromAngleDeg(Vector2D *pResult, float angle);
 
@@ -0,0 +1,140 @@
+#include "Vector2DFixed.h"
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedZero(Vector2DFixed *pResult)
+{
+	pResult->x = 0;
+	pResult->y = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedSet(Vector2DFixed *pResult, Fixed x, Fixed y)
+{
+	pResult->x = x;
+	pResult->y = y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedNeg(Vector2DFixed *pResult, Vector2DFixed *pVec0)
+{
+	pResult->x = -pVec0->x;
+	pResult->y = -pVec0->y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedAdd(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1)
+{
+	pResult->x = pVec0->x + pVec1->x;
+	pResult->y = pVec0->y + pVec1->y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedSub(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1)
+{
+	pResult->x = pVec0->x - pVec1->x;
+	pResult->y = pVec0->y - pVec1->y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedNormalize(Vector2DFixed *pResult, Vector2DFixed *pVec0)
+{
+	Fixed magnitude = Vector2DFixedLength(pVec0);
+
+	if (0 == magnitude)
+	{
+		*pResult = *pVec0;
+		return;
+	}
+
+	pResult->x = FixedDiv(pVec0->x, magnitude);
+	pResult->y = FixedDiv(pVec0->y, magnitude);
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedScale(Vector2DFixed *pResult, Vector2DFixed *pVec0, Fixed c)
+{
+	pResult->x = FixedMul(pVec0->x, c);
+	pResult->y = FixedMul(pVec0->y, c);
+}
+
+// ---------------------------------------------------------------------------
+
+//Scale THEN add
+void Vector2DFixedScaleAdd(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1, Fixed c)
+{
+	pResult->x = FixedMul(c, pVec0->x) + pVec1->x;
+	pResult->y = FixedMul(c, pVec0->y) + pVec1->y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedScaleSub(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1, Fixed c)
+{
+	pResult->x = FixedMul(c, pVec0->x) - pVec1->x;
+	pResult->y = FixedMul(c, pVec0->y) - pVec1->y;
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed Vector2DFixedLength(Vector2DFixed *pVec0)
+{
+	return FixedSqrt(Vector2DFixedSquareLength(pVec0));
+}
+
+// ---------------------------------------------------------------------------
+
+FixedWide Vector2DFixedSquareLength(Vector2DFixed *pVec0)
+{
+	return Vector2DFixedDotProduct(pVec0, pVec0);
+}
+
+// ---------------------------------------------------------------------------
+
+Fixed Vector2DFixedDistance(Vector2DFixed *pVec0, Vector2DFixed *pVec1)
+{
+	return FixedSqrt(Vector2DFixedSquareDistance(pVec0, pVec1));
+}
+
+// ---------------------------------------------------------------------------
+
+FixedWide Vector2DFixedSquareDistance(Vector2DFixed *pVec0, Vector2DFixed *pVec1)
+{
+	Vector2DFixed d;
+
+	Vector2DFixedSub(&d, pVec0, pVec1);
+
+	return Vector2DFixedDotProduct(&d, &d);
+}
+
+// ---------------------------------------------------------------------------
+
+FixedWide Vector2DFixedDotProduct(Vector2DFixed *pVec0, Vector2DFixed *pVec1)
+{
+	// Rounded once, after the sum
+	return ((s64)pVec0->x * pVec1->x + (s64)pVec0->y * pVec1->y + (FIXED_ONE >> 1)) >> FIXED_SHIFT;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedFromVector2D(Vector2DFixed *pResult, Vector2D *pVec0)
+{
+	pResult->x = FixedFromFloat(pVec0->x);
+	pResult->y = FixedFromFloat(pVec0->y);
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DFixedToVector2D(Vector2D *pResult, Vector2DFixed *pVec0)
+{
+	pResult->x = FixedToFloat(pVec0->x);
+	pResult->y = FixedToFloat(pVec0->y);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,52 @@
+#ifndef VECTOR2DFIXED_H
+#define VECTOR2DFIXED_H
+
+#include "FixedPoint.h"
+#include "Vector2D.h"
+
+
+
+/*
+Fixed-point version of Vector2D, for the deterministic simulation.
+The functions mirror the Vector2D ones
+*/
+typedef struct Vector2DFixed
+{
+	Fixed x, y;
+}Vector2DFixed;
+
+
+void Vector2DFixedZero(Vector2DFixed *pResult);
+
+void Vector2DFixedSet(Vector2DFixed *pResult, Fixed x, Fixed y);
+
+void Vector2DFixedNeg(Vector2DFixed *pResult, Vector2DFixed *pVec0);
+
+void Vector2DFixedAdd(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1);
+
+void Vector2DFixedSub(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1);
+
+// Leaves the zero vector as it is
+void Vector2DFixedNormalize(Vector2DFixed *pResult, Vector2DFixed *pVec0);
+
+void Vector2DFixedScale(Vector2DFixed *pResult, Vector2DFixed *pVec0, Fixed c);
+
+void Vector2DFixedScaleAdd(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1, Fixed c);
+
+void Vector2DFixedScaleSub(Vector2DFixed *pResult, Vector2DFixed *pVec0, Vector2DFixed *pVec1, Fixed c);
+
+Fixed Vector2DFixedLength(Vector2DFixed *pVec0);
+
+FixedWide Vector2DFixedSquareLength(Vector2DFixed *pVec0);
+
+Fixed Vector2DFixedDistance(Vector2DFixed *pVec0, Vector2DFixed *pVec1);
+
+FixedWide Vector2DFixedSquareDistance(Vector2DFixed *pVec0, Vector2DFixed *pVec1);
+
+FixedWide Vector2DFixedDotProduct(Vector2DFixed *pVec0, Vector2DFixed *pVec1);
+
+// Conversions, rounding to the nearest
+void Vector2DFixedFromVector2D(Vector2DFixed *pResult, Vector2D *pVec0);
+
+void Vector2DFixedToVector2D(Vector2D *pResult, Vector2DFixed *pVec0);
+#endif
@@ -12,6 +12,9 @@
 // includes
 #include "AEEngine.h"
 #include "GameStateMgr.h"
+#include "InputRecorder.h"
+#include "Profiler.h"
+#include "CageBench.h"
 
 // Libraries
 #pragma comment (lib, "Alpha_Engine.lib")
@@ -29,6 +32,31 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 {
 	// Initialize the system 
 	AESysInitInfo sysInitInfo;
+	char logFileName[MAX_PATH], imageFileName[MAX_PATH];
+	int replay = 0;
+	CageBenchDesc benchDesc;
+
+	// "-bench <file> [balls] [obstacles] [threads]" runs the scaling benchmark to a JSON file, without a window
+	CageBenchDescDefault(&benchDesc);
+	if (1 <= sscanf(command_line, "-bench %259s %lu %lu %lu", logFileName, &benchDesc.mBallNumMax, &benchDesc.mObstacleNumMax, &benchDesc.mThreadNumMax))
+		return CageBenchRun(&benchDesc, logFileName) ? 0 : 1;
+
+	// "-record <file>" logs the input of the session, "-replay <file> [image]" plays a log back headless.
+	// With AE_GFX_SOFTWARE, the image gets the replay's last frame, drawn by SoftGfx
+	if (1 == sscanf(command_line, "-record %259s", logFileName))
+	{
+		if (0 == InputRecorderStartRecord(logFileName))
+			return 1;
+	}
+	else if (1 <= (replay = sscanf(command_line, "-replay %259s %259s", logFileName, imageFileName)))
+	{
+		if (0 == InputRecorderStartReplay(logFileName))
+			return 1;
+
+		show = SW_HIDE;
+	}
+	else
+		replay = 0;
 
 	sysInitInfo.mAppInstance = instanceH;
 	sysInitInfo.mShow = show;
@@ -49,8 +77,20 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 		return 1;
 
 
+	ProfilerInit();
+
 	GameStateMgrInit(GS_PLAY);
-	GSM_MainLoop();
+
+	if (replay)
+		GSM_ReplayLoop((2 == replay) ? imageFileName : NULL);
+	else
+		GSM_MainLoop();
+
+	InputRecorderStop();
+
+#if(PROFILER_ENABLED)
+	ProfilerDumpCSV("profile.csv");
+#endif
 
 	// free the system
 	AESysExit();
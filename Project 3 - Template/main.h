@@ -18,13 +18,26 @@
 // includes
 
 #include "AEEngine.h"
+#include "SoftGfxCompat.h"
 
 // game state manager
 #include "GameStateMgr.h"
 #include "Math2D.h"
 #include "Vector2D.h"
 #include "Matrix2D.h"
+#include "Affine2D.h"
+#include "SinCos.h"
 #include "LineSegment2D.h"
+#include "Math2DFixed.h"
+#include "Archetype.h"
+#include "InputRecorder.h"
+#include "Profiler.h"
+#include "CollisionStats.h"
+#include "ContactEvents.h"
+#include "DebugDraw.h"
+#include "RayCast.h"
+#include "DistanceQuery.h"
+#include "JobSystem.h"
 // ---------------------------------------------------------------------------
 
 #endif // MAIN_H